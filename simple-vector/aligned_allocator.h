@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+// Аллокаторы с усиленным выравниванием буфера.
+// AlignedAllocator выравнивает буфер по Alignment байт: при 64 первый элемент начинается
+// со строки кэша, и векторные загрузки не пересекают её границу.
+// HugePageAllocator дополнительно размещает буферы от Threshold байт в отдельных отображениях,
+// выровненных по большим страницам (2 МиБ): так большой буфер покрывается малым числом записей TLB
+
+// Аллокатор буфера, выровненного по Alignment байт (степень двойки, не меньше alignof(Type))
+template <typename Type, size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    using value_type = Type;
+
+    static constexpr size_t kAlignment = std::max(Alignment, alignof(Type));
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept {}
+
+    // Выделяет сырую память под size элементов, выровненную по kAlignment
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(::operator new(size * sizeof(Type), std::align_val_t{kAlignment}));
+    }
+
+    // Освобождает память, выделенную allocate
+    void deallocate(Type* raw_ptr, size_t) noexcept {
+        ::operator delete(raw_ptr, std::align_val_t{kAlignment});
+    }
+};
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+bool operator==(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+bool operator!=(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept {
+    return false;
+}
+
+// Способ получить большие страницы для буферов HugePageAllocator
+enum class HugePageMode {
+    // Прозрачные большие страницы: выровненное анонимное отображение с madvise(MADV_HUGEPAGE).
+    // Ядро подставляет большие страницы, если они включены (режим always или madvise)
+    kTransparent,
+    // Сначала mmap(MAP_HUGETLB) из заранее зарезервированного пула hugetlbfs, при неудаче - kTransparent.
+    // Если пул недоступен, аллокатор запоминает это и больше не пытается
+    kHugeTlb,
+};
+
+namespace huge_page_detail {
+
+inline constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+// Округляет bytes вверх до целого числа больших страниц
+inline size_t RoundUp(size_t bytes) noexcept {
+    return (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+}
+
+// Сбрасывается при первой неудаче MAP_HUGETLB, чтобы не платить за заведомо неудачный вызов
+inline std::atomic<bool> huge_tlb_available{true};
+
+// Отображает bytes (кратно kHugePageSize) анонимной памяти
+inline void* Map(size_t bytes, HugePageMode mode) {
+#if defined(MAP_HUGETLB)
+    if (mode == HugePageMode::kHugeTlb && huge_tlb_available.load(std::memory_order_relaxed)) {
+        void* mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapped != MAP_FAILED) {
+            return mapped;
+        }
+        huge_tlb_available.store(false, std::memory_order_relaxed);
+    }
+#else
+    (void)mode;
+#endif
+    // Отображаем с запасом в одну большую страницу и обрезаем края, чтобы начало было выровнено
+    const size_t padded = bytes + kHugePageSize;
+    void* mapped = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+    const uintptr_t aligned = (begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    if (aligned > begin) {
+        ::munmap(mapped, aligned - begin);
+    }
+    if (const size_t tail = begin + padded - (aligned + bytes); tail > 0) {
+        ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+    void* result = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    ::madvise(result, bytes, MADV_HUGEPAGE);
+#endif
+    return result;
+}
+
+} // namespace huge_page_detail
+
+// Аллокатор, размещающий буферы от Threshold байт на больших страницах (см. HugePageMode),
+// а меньшие - через AlignedAllocator<Type, Alignment>.
+// Большой буфер занимает целое число больших страниц; usable_size сообщает этот запас,
+// и политика UsableSizeGrowth забирает его в ёмкость вектора (см. HugePageSimpleVector)
+template <typename Type, size_t Threshold = huge_page_detail::kHugePageSize, size_t Alignment = 64,
+          HugePageMode Mode = HugePageMode::kTransparent>
+class HugePageAllocator {
+public:
+    static_assert(Threshold > 0, "Threshold must be positive");
+    static_assert(std::max(Alignment, alignof(Type)) <= huge_page_detail::kHugePageSize,
+                  "Huge buffers are aligned only to the huge page size");
+
+    using value_type = Type;
+
+    template <typename Other>
+    struct rebind {
+        using other = HugePageAllocator<Other, Threshold, Alignment, Mode>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    template <typename Other>
+    HugePageAllocator(const HugePageAllocator<Other, Threshold, Alignment, Mode>&) noexcept {}
+
+    // Сообщает, будет ли буфер из size элементов размещён на больших страницах
+    static constexpr bool IsHuge(size_t size) noexcept {
+        return size >= (Threshold + sizeof(Type) - 1) / sizeof(Type);
+    }
+
+    // Выделяет сырую память под size элементов
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (!IsHuge(size)) {
+            return Small().allocate(size);
+        }
+        if (size > (std::numeric_limits<size_t>::max() - 2 * huge_page_detail::kHugePageSize) / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(huge_page_detail::Map(huge_page_detail::RoundUp(size * sizeof(Type)), Mode));
+    }
+
+    // Освобождает память, выделенную allocate (или расширенную usable_size) под size элементов
+    void deallocate(Type* raw_ptr, size_t size) noexcept {
+        if (!IsHuge(size)) {
+            Small().deallocate(raw_ptr, size);
+            return;
+        }
+        ::munmap(raw_ptr, huge_page_detail::RoundUp(size * sizeof(Type)));
+    }
+
+    // Возвращает, сколько элементов помещается в блок, выделенный под size элементов:
+    // большой буфер округлён до целых больших страниц
+    size_t usable_size(Type*, size_t size) const noexcept {
+        if (!IsHuge(size)) {
+            return size;
+        }
+        return huge_page_detail::RoundUp(size * sizeof(Type)) / sizeof(Type);
+    }
+
+private:
+    static AlignedAllocator<Type, Alignment> Small() noexcept {
+        return {};
+    }
+};
+
+template <typename Lhs, typename Rhs, size_t Threshold, size_t Alignment, HugePageMode Mode>
+bool operator==(const HugePageAllocator<Lhs, Threshold, Alignment, Mode>&,
+                const HugePageAllocator<Rhs, Threshold, Alignment, Mode>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t Threshold, size_t Alignment, HugePageMode Mode>
+bool operator!=(const HugePageAllocator<Lhs, Threshold, Alignment, Mode>&,
+                const HugePageAllocator<Rhs, Threshold, Alignment, Mode>&) noexcept {
+    return false;
+}
+
+// Вектор с буфером, выровненным по строке кэша (или по Alignment байт)
+template <typename Type, size_t Alignment = 64>
+using AlignedSimpleVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>>;
+
+// Вектор, большие буферы которого лежат на больших страницах.
+// Рост округляется до больших страниц, а их запас сразу идёт в ёмкость
+template <typename Type, HugePageMode Mode = HugePageMode::kTransparent>
+using HugePageSimpleVector = SimpleVector<Type, HugePageAllocator<Type, huge_page_detail::kHugePageSize, 64, Mode>,
+                                          UsableSizeGrowth<HugePageGrowth>>;
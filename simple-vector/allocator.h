@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "constexpr_support.h"
+#include "relocation.h"
+#include "simd_kernels.h"
+
+// Аллокатор SimpleVector по умолчанию.
+// Тривиально перемещаемые типы с обычным выравниванием размещаются через malloc, поэтому буфер
+// можно расширять через realloc (метод reallocate). Остальные типы размещаются через ::operator new.
+// При вычислении во время компиляции (C++20) память выделяет std::allocator
+template <typename Type>
+class DefaultAllocator {
+public:
+    using value_type = Type;
+
+    // Разрешает перевыделение памяти с переносом содержимого побайтово (см. reallocate)
+    static constexpr bool kCanReallocate =
+        kIsTriviallyRelocatable<Type> && alignof(Type) <= alignof(std::max_align_t);
+
+    constexpr DefaultAllocator() noexcept = default;
+
+    template <typename Other>
+    constexpr DefaultAllocator(const DefaultAllocator<Other>&) noexcept {}
+
+    // Выделяет сырую память под size элементов
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR Type* allocate(size_t size) {
+        if (IsConstantEvaluated()) {
+            return std::allocator<Type>().allocate(size);
+        }
+        CheckSize(size);
+        if constexpr (kCanReallocate) {
+            void* raw_ptr = std::malloc(size * sizeof(Type));
+            if (raw_ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+            return static_cast<Type*>(raw_ptr);
+        } else if constexpr (alignof(Type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<Type*>(::operator new(size * sizeof(Type), std::align_val_t{alignof(Type)}));
+        } else {
+            return static_cast<Type*>(::operator new(size * sizeof(Type)));
+        }
+    }
+
+    // Освобождает память, выделенную allocate
+    SIMPLE_VECTOR_CONSTEXPR void deallocate(Type* raw_ptr, size_t size) noexcept {
+        if (IsConstantEvaluated()) {
+            std::allocator<Type>().deallocate(raw_ptr, size);
+            return;
+        }
+        if constexpr (kCanReallocate) {
+            std::free(raw_ptr);
+        } else if constexpr (alignof(Type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(raw_ptr, std::align_val_t{alignof(Type)});
+        } else {
+            ::operator delete(raw_ptr);
+        }
+    }
+
+    // Изменяет размер блока, сохраняя содержимое: на месте, если за блоком свободно,
+    // а для больших блоков glibc переотображает страницы через mremap вместо копирования
+    [[nodiscard]] Type* reallocate(Type* raw_ptr, size_t /*old_size*/, size_t new_size) {
+        static_assert(kCanReallocate, "reallocate requires malloc-backed storage");
+        CheckSize(new_size);
+        void* new_ptr = std::realloc(static_cast<void*>(raw_ptr), new_size * sizeof(Type));
+        if (new_ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<Type*>(new_ptr);
+    }
+
+    // Возвращает, сколько элементов фактически помещается в блок raw_ptr, выделенный под size элементов.
+    // malloc округляет запросы до своих классов размеров, и этот запас можно использовать
+    size_t usable_size(Type* raw_ptr, size_t size) const noexcept {
+#if defined(__GLIBC__)
+        if constexpr (kCanReallocate) {
+            return std::max(size, malloc_usable_size(static_cast<void*>(raw_ptr)) / sizeof(Type));
+        }
+#endif
+        (void)raw_ptr;
+        return size;
+    }
+
+private:
+    // Проверяет, что size элементов помещаются в адресное пространство
+    static void CheckSize(size_t size) {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+    }
+};
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator==(const DefaultAllocator<Lhs>&, const DefaultAllocator<Rhs>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs>
+constexpr bool operator!=(const DefaultAllocator<Lhs>&, const DefaultAllocator<Rhs>&) noexcept {
+    return false;
+}
+
+// Признак аллокатора, умеющего reallocate(ptr, old_size, new_size) с побайтовым переносом содержимого.
+// Аллокатор сообщает об этом статической константой kCanReallocate
+template <typename Alloc, typename = void>
+struct AllocatorCanReallocate : std::false_type {};
+
+template <typename Alloc>
+struct AllocatorCanReallocate<Alloc, std::enable_if_t<Alloc::kCanReallocate>> : std::true_type {};
+
+// Признак аллокатора, сообщающего фактический размер блока через usable_size(ptr, size)
+template <typename Alloc, typename = void>
+struct AllocatorHasUsableSize : std::false_type {};
+
+template <typename Alloc>
+struct AllocatorHasUsableSize<Alloc, std::void_t<decltype(std::declval<const Alloc&>().usable_size(
+        std::declval<typename Alloc::value_type*>(), size_t{}))>> : std::true_type {};
+
+// Признаки аллокаторов, которые сами создают и разрушают элементы (например, std::pmr::polymorphic_allocator
+// передаёт свой ресурс вложенным контейнерам). Для остальных хватает placement new и деструктора,
+// что позволяет использовать быстрые стандартные алгоритмы
+template <typename Alloc, typename Type, typename = void>
+struct HasAllocatorConstruct : std::false_type {};
+
+template <typename Alloc, typename Type>
+struct HasAllocatorConstruct<Alloc, Type,
+        std::void_t<decltype(std::declval<Alloc&>().construct(std::declval<Type*>(), std::declval<Type>()))>>
+    : std::true_type {};
+
+template <typename Alloc, typename Type, typename = void>
+struct HasAllocatorDestroyImpl : std::false_type {};
+
+template <typename Alloc, typename Type>
+struct HasAllocatorDestroyImpl<Alloc, Type,
+        std::void_t<decltype(std::declval<Alloc&>().destroy(std::declval<Type*>()))>>
+    : std::true_type {};
+
+template <typename Alloc>
+struct IsPolymorphicAllocator : std::false_type {};
+
+template <typename Type>
+struct IsPolymorphicAllocator<std::pmr::polymorphic_allocator<Type>> : std::true_type {};
+
+// polymorphic_allocator::destroy лишь вызывает деструктор (и в C++20 объявлен устаревшим),
+// поэтому для него признак не проверяется
+template <typename Alloc, typename Type>
+struct HasAllocatorDestroy : std::conditional_t<IsPolymorphicAllocator<Alloc>::value, std::false_type,
+                                                HasAllocatorDestroyImpl<Alloc, Type>> {};
+
+// Создаёт элемент в сырой памяти ptr через аллокатор
+template <typename Alloc, typename Type, typename... Args>
+SIMPLE_VECTOR_CONSTEXPR void ConstructAt(Alloc& alloc, Type* ptr, Args&&... args) {
+    if constexpr (HasAllocatorConstruct<Alloc, Type>::value) {
+        std::allocator_traits<Alloc>::construct(alloc, ptr, std::forward<Args>(args)...);
+    } else {
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+        std::construct_at(ptr, std::forward<Args>(args)...);
+#else
+        ::new (static_cast<void*>(ptr)) Type(std::forward<Args>(args)...);
+#endif
+    }
+}
+
+// Разрушает элемент ptr через аллокатор
+template <typename Alloc, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void DestroyAt(Alloc& alloc, Type* ptr) noexcept {
+    if constexpr (HasAllocatorDestroy<Alloc, Type>::value) {
+        std::allocator_traits<Alloc>::destroy(alloc, ptr);
+    } else {
+        std::destroy_at(ptr);
+    }
+}
+
+// Разрушает элементы [first, last) через аллокатор
+template <typename Alloc, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void DestroyRange(Alloc& alloc, Type* first, Type* last) noexcept {
+    if constexpr (HasAllocatorDestroy<Alloc, Type>::value) {
+        for (; first != last; ++first) {
+            std::allocator_traits<Alloc>::destroy(alloc, first);
+        }
+    } else {
+        std::destroy(first, last);
+    }
+}
+
+// Создаёт count элементов, начиная с dest, вызывая construct(ptr) для каждого.
+// Если создание бросает исключение, уже созданные элементы разрушаются
+template <typename Alloc, typename Type, typename Construct>
+SIMPLE_VECTOR_CONSTEXPR void ConstructEach(Alloc& alloc, Type* dest, size_t count, Construct construct) {
+    size_t index = 0;
+    try {
+        for (; index < count; ++index) {
+            construct(dest + index);
+        }
+    }
+    catch (...) {
+        DestroyRange(alloc, dest, dest + index);
+        throw;
+    }
+}
+
+// Создаёт count копий value в сырой памяти dest.
+// Стандартные алгоритмы и векторные ядра не вычисляются при компиляции, поэтому там
+// (как и для аллокаторов со своим construct) элементы создаются по одному
+template <typename Alloc, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedFillN(Alloc& alloc, Type* dest, size_t count, const Type& value) {
+    if constexpr (!HasAllocatorConstruct<Alloc, Type>::value) {
+        if (!IsConstantEvaluated()) {
+            if constexpr (kHasSimdKernels<Type>) {
+                SimdFill(dest, count, value);
+            } else {
+                std::uninitialized_fill_n(dest, count, value);
+            }
+            return;
+        }
+    }
+    ConstructEach(alloc, dest, count, [&](Type* ptr) { ConstructAt(alloc, ptr, value); });
+}
+
+// Создаёт count элементов со значением по умолчанию (value-initialization)
+template <typename Alloc, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedValueConstructN(Alloc& alloc, Type* dest, size_t count) {
+    if constexpr (!HasAllocatorConstruct<Alloc, Type>::value) {
+        if (!IsConstantEvaluated()) {
+            std::uninitialized_value_construct_n(dest, count);
+            return;
+        }
+    }
+    ConstructEach(alloc, dest, count, [&](Type* ptr) { ConstructAt(alloc, ptr); });
+}
+
+// Создаёт count элементов инициализацией по умолчанию: тривиальные типы остаются неинициализированными.
+// Аллокатор со своим construct не умеет такую инициализацию, поэтому для него (и при компиляции,
+// где неинициализированные значения недопустимы) элементы обнуляются
+template <typename Alloc, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedDefaultConstructN(Alloc& alloc, Type* dest, size_t count) {
+    if constexpr (!HasAllocatorConstruct<Alloc, Type>::value) {
+        if (!IsConstantEvaluated()) {
+            std::uninitialized_default_construct_n(dest, count);
+            return;
+        }
+    }
+    UninitializedValueConstructN(alloc, dest, count);
+}
+
+// Копирует [first, last) в сырую память dest
+template <typename Alloc, typename InputIt, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedCopy(Alloc& alloc, InputIt first, InputIt last, Type* dest) {
+    if constexpr (!HasAllocatorConstruct<Alloc, Type>::value) {
+        if (!IsConstantEvaluated()) {
+            std::uninitialized_copy(first, last, dest);
+            return;
+        }
+    }
+    Type* current = dest;
+    try {
+        for (; first != last; ++first, ++current) {
+            ConstructAt(alloc, current, *first);
+        }
+    }
+    catch (...) {
+        DestroyRange(alloc, dest, current);
+        throw;
+    }
+}
+
+// Переносит элементы [first, last) в сырую память dest, не разрушая исходные.
+// Перемещает, если перемещение не бросает исключений или копирование невозможно, иначе копирует
+template <typename Alloc, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedTransfer(Alloc& alloc, Type* first, Type* last, Type* dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+        UninitializedCopy(alloc, std::make_move_iterator(first), std::make_move_iterator(last), dest);
+    } else {
+        UninitializedCopy(alloc, first, last, dest);
+    }
+}
+
+// Переносит элементы [first, last) в сырую (непересекающуюся) память dest.
+// После вызова исходный диапазон считается сырой памятью
+template <typename Alloc, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedRelocate(Alloc& alloc, Type* first, Type* last, Type* dest) {
+    if constexpr (kIsTriviallyRelocatable<Type>) {
+        RelocateBytes(first, last, dest);
+    } else {
+        UninitializedTransfer(alloc, first, last, dest);
+        DestroyRange(alloc, first, last);
+    }
+}
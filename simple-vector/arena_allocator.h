@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+// Монотонная арена: выдаёт память последовательно из крупных блоков и освобождает её
+// вся разом через Reset(). Освобождение отдельного блока возвращает память,
+// только если это было последнее выделение; последнее выделение можно и расширить на месте.
+// Подходит для векторов, живущих в пределах одного запроса: после обработки запроса
+// достаточно вызвать Reset(), и вся память будет переиспользована следующим запросом.
+// Арена также является std::pmr::memory_resource и годится для PmrSimpleVector
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    // block_size - размер блоков, запрашиваемых у upstream
+    explicit MonotonicArena(size_t block_size = 64 * 1024,
+                            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : block_size_(block_size)
+        , upstream_(upstream)
+    {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override {
+        Release();
+    }
+
+    // Выделяет bytes байт с выравниванием alignment
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        std::byte* ptr = current_ != nullptr ? AlignUp(cursor_, alignment) : nullptr;
+        if (ptr == nullptr || ptr > BlockEnd(current_) || bytes > static_cast<size_t>(BlockEnd(current_) - ptr)) {
+            ptr = NextBlock(bytes, alignment);
+        }
+        cursor_ = ptr + bytes;
+        last_ = ptr;
+        bytes_allocated_ += bytes;
+        return ptr;
+    }
+
+    // Освобождает память, только если ptr - последнее выделение
+    void Deallocate(void* ptr, size_t bytes) noexcept {
+        if (ptr != nullptr && ptr == last_) {
+            cursor_ = static_cast<std::byte*>(ptr);
+            last_ = nullptr;
+            bytes_allocated_ -= bytes;
+        }
+    }
+
+    // Расширяет выделение ptr с old_bytes до new_bytes без переноса.
+    // Возможно, только если ptr - последнее выделение и в блоке достаточно места
+    bool Extend(void* ptr, size_t old_bytes, size_t new_bytes) noexcept {
+        std::byte* byte_ptr = static_cast<std::byte*>(ptr);
+        if (ptr == nullptr || byte_ptr != last_ || new_bytes > static_cast<size_t>(BlockEnd(current_) - byte_ptr)) {
+            return false;
+        }
+        cursor_ = byte_ptr + new_bytes;
+        bytes_allocated_ = bytes_allocated_ - old_bytes + new_bytes;
+        return true;
+    }
+
+    // Делает всю выданную память свободной, сохраняя блоки для повторного использования.
+    // Все объекты, размещённые в арене, к этому моменту должны быть разрушены
+    void Reset() noexcept {
+        current_ = head_;
+        cursor_ = head_ != nullptr ? BlockBegin(head_) : nullptr;
+        last_ = nullptr;
+        bytes_allocated_ = 0;
+    }
+
+    // Возвращает все блоки upstream
+    void Release() noexcept {
+        while (head_ != nullptr) {
+            Block* next = head_->next;
+            upstream_->deallocate(head_, head_->size, alignof(Block));
+            head_ = next;
+        }
+        current_ = nullptr;
+        cursor_ = nullptr;
+        last_ = nullptr;
+        bytes_allocated_ = 0;
+    }
+
+    // Возвращает количество байт, выданных с момента последнего Reset
+    size_t GetBytesAllocated() const noexcept {
+        return bytes_allocated_;
+    }
+
+    // Возвращает количество блоков, полученных от upstream
+    size_t GetBlockCount() const noexcept {
+        size_t count = 0;
+        for (Block* block = head_; block != nullptr; block = block->next) {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    // Заголовок блока; полезная память начинается сразу за ним
+    struct alignas(std::max_align_t) Block {
+        Block* next;
+        size_t size;
+    };
+
+    static std::byte* BlockBegin(Block* block) noexcept {
+        return reinterpret_cast<std::byte*>(block + 1);
+    }
+
+    static std::byte* BlockEnd(Block* block) noexcept {
+        return reinterpret_cast<std::byte*>(block) + block->size;
+    }
+
+    static std::byte* AlignUp(std::byte* ptr, size_t alignment) noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        const auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        return ptr + (aligned - address);
+    }
+
+    // Переходит к следующему сохранённому блоку, в который помещается запрос, или запрашивает новый
+    std::byte* NextBlock(size_t bytes, size_t alignment) {
+        if (bytes > std::numeric_limits<size_t>::max() - sizeof(Block) - alignment) {
+            throw std::bad_alloc();
+        }
+        const size_t needed = sizeof(Block) + bytes + alignment;
+        Block* previous = current_;
+        Block* candidate = current_ != nullptr ? current_->next : head_;
+        while (candidate != nullptr && candidate->size < needed) {
+            previous = candidate;
+            candidate = candidate->next;
+        }
+        if (candidate == nullptr) {
+            const size_t size = needed > block_size_ ? needed : block_size_;
+            candidate = static_cast<Block*>(upstream_->allocate(size, alignof(Block)));
+            candidate->size = size;
+            candidate->next = nullptr;
+            if (previous == nullptr) {
+                head_ = candidate;
+            } else {
+                candidate->next = previous->next;
+                previous->next = candidate;
+            }
+        }
+        current_ = candidate;
+        return AlignUp(BlockBegin(candidate), alignment);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        return Allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t) override {
+        Deallocate(ptr, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    size_t block_size_;
+    std::pmr::memory_resource* upstream_;
+    Block* head_ = nullptr;
+    Block* current_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* last_ = nullptr;
+    size_t bytes_allocated_ = 0;
+};
+
+// Типизированный аллокатор поверх MonotonicArena для SimpleVector<Type, ArenaAllocator<Type>>.
+// В отличие от std::pmr::polymorphic_allocator обращается к арене без виртуальных вызовов
+// и умеет расширять последний буфер на месте (reallocate)
+template <typename Type>
+class ArenaAllocator {
+public:
+    using value_type = Type;
+
+    static constexpr bool kCanReallocate = true;
+
+    ArenaAllocator(MonotonicArena& arena) noexcept
+        : arena_(&arena)
+    {}
+
+    template <typename Other>
+    ArenaAllocator(const ArenaAllocator<Other>& other) noexcept
+        : arena_(other.GetArena())
+    {}
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(arena_->Allocate(size * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type* raw_ptr, size_t size) noexcept {
+        arena_->Deallocate(raw_ptr, size * sizeof(Type));
+    }
+
+    // Расширяет последний буфер на месте, иначе переносит содержимое побайтово в новый
+    [[nodiscard]] Type* reallocate(Type* raw_ptr, size_t old_size, size_t new_size) {
+        if (new_size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        if (arena_->Extend(raw_ptr, old_size * sizeof(Type), new_size * sizeof(Type))) {
+            return raw_ptr;
+        }
+        Type* new_ptr = allocate(new_size);
+        std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(raw_ptr),
+                    (old_size < new_size ? old_size : new_size) * sizeof(Type));
+        deallocate(raw_ptr, old_size);
+        return new_ptr;
+    }
+
+    MonotonicArena* GetArena() const noexcept {
+        return arena_;
+    }
+
+private:
+    MonotonicArena* arena_;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
@@ -3,30 +3,55 @@
 #include <cassert>
 #include <iostream>
 #include <cstdlib>
+#include <cstddef>
 #include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "constexpr_support.h"
+#include "relocation.h"
+
+// Владеет сырой (неинициализированной) памятью под size элементов типа Type, полученной от аллокатора Alloc.
+// ArrayPtr только выделяет и освобождает память: конструированием и разрушением
+// элементов занимается владелец (SimpleVector), который знает, сколько из них живы.
+// Аллокатор хранится базой класса, поэтому пустые аллокаторы не увеличивают размер ArrayPtr
+template <typename Type, typename Alloc = DefaultAllocator<Type>>
+class ArrayPtr : private Alloc {
+    using AllocTraits = std::allocator_traits<Alloc>;
 
-template <typename Type>
-class ArrayPtr {
 public:
+    // Буфер можно расширять через Reallocate: аллокатор умеет reallocate, а элементы
+    // допускают побайтовый перенос
+    static constexpr bool kCanReallocate =
+        kIsTriviallyRelocatable<Type> && AllocatorCanReallocate<Alloc>::value;
+
     // Инициализирует ArrayPtr нулевым указателем
-    ArrayPtr() = default;
+    constexpr ArrayPtr() = default;
+
+    // Инициализирует ArrayPtr нулевым указателем, запоминая аллокатор
+    constexpr explicit ArrayPtr(const Alloc& alloc) noexcept
+        : Alloc(alloc)
+    {}
 
-    // Создаёт в куче массив из size элементов типа Type.
+    // Выделяет в куче сырую память под size элементов типа Type, не создавая их.
     // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size) {
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t size, const Alloc& alloc = Alloc())
+        : Alloc(alloc)
+    {
         if (size > 0) {
-            raw_ptr_ = std::move(new Type[size]);
+            raw_ptr_ = AllocTraits::allocate(GetAllocator(), size);
             size_ = size;
-        } else {
-            raw_ptr_ = nullptr;
         }
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept {
-
-        raw_ptr_ = std::move(raw_ptr);
-    }
+    // Конструктор из сырого указателя, хранящего адрес памяти, выделенной alloc, либо nullptr
+    constexpr ArrayPtr(Type* raw_ptr, size_t size, const Alloc& alloc = Alloc()) noexcept
+        : Alloc(alloc)
+        , raw_ptr_(raw_ptr)
+        , size_(raw_ptr != nullptr ? size : 0)
+    {}
 
     // Запрещаем копирование
     ArrayPtr(const ArrayPtr& other) = delete;
@@ -34,77 +59,128 @@ public:
     // Запрещаем присваивание копированием
     ArrayPtr& operator=(const ArrayPtr& rhs) = delete;
 
-    // Разрешаем перемещение
-    //ArrayPtr(ArrayPtr&&) = default;
-
-    // Разрешаем перемещение
-    ArrayPtr(ArrayPtr&& other) { *this = std::move(other); }
-
-    // Разрешаем присваивание перемещением
-    //ArrayPtr& operator=(ArrayPtr&&) = default;
+    // Разрешаем перемещение: забираем указатель, не трогая элементы
+    constexpr ArrayPtr(ArrayPtr&& other) noexcept
+        : Alloc(std::move(other.GetAllocator()))
+        , raw_ptr_(std::exchange(other.raw_ptr_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+    {}
 
     // Оператор присваивания перемещением
-    ArrayPtr& operator=(ArrayPtr&& rhs) {
-        assert(this != &rhs);
-        if (raw_ptr_ != nullptr) {
-            delete[] raw_ptr_;
+    // Передаёт владение памятью: элементы в ней живут под управлением владельца.
+    // Если аллокатор не распространяется при перемещении, аллокаторы должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& rhs) noexcept {
+        if (this != &rhs) {
+            Delete();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                GetAllocator() = std::move(rhs.GetAllocator());
+            } else {
+                assert(GetAllocator() == rhs.GetAllocator());
+            }
+            raw_ptr_ = std::exchange(rhs.raw_ptr_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
         }
-        size_ = rhs.GetSize();
-        raw_ptr_ = new Type[size_]{};
-        std::move(std::make_move_iterator(&rhs.raw_ptr_[0]),
-                  std::make_move_iterator(&rhs.raw_ptr_[size_]), raw_ptr_);
-
         return *this;
     }
 
-    ~ArrayPtr() {
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr() {
         Delete();
     }
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
     // После вызова метода указатель на массив должен обнулиться
-    [[nodiscard]] Type* Release() noexcept {
+    [[nodiscard]] constexpr Type* Release() noexcept {
         Type* t = raw_ptr_;
         raw_ptr_ = nullptr;
+        size_ = 0;
         return t;
     }
 
     // Возвращает ссылку на элемент массива с индексом index
-    Type& operator[](size_t index) noexcept {
+    constexpr Type& operator[](size_t index) noexcept {
         return raw_ptr_[index];
     }
 
     // Возвращает константную ссылку на элемент массива с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    constexpr const Type& operator[](size_t index) const noexcept {
         return raw_ptr_[index];
     }
 
     // Возвращает true, если указатель ненулевой, и false в противном случае
-    explicit operator bool() const {
-        return raw_ptr_ == nullptr ? true : false;
+    constexpr explicit operator bool() const {
+        return raw_ptr_ != nullptr;
     }
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
-    Type* Get() const noexcept {
-        return &raw_ptr_[0];
+    constexpr Type* Get() const noexcept {
+        return raw_ptr_;
+    }
+
+    // Возвращает количество элементов, под которые выделена память
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает аллокатор, которым выделена память
+    constexpr Alloc& GetAllocator() noexcept {
+        return *this;
+    }
+
+    // Возвращает аллокатор, которым выделена память
+    constexpr const Alloc& GetAllocator() const noexcept {
+        return *this;
     }
 
     // Обменивается значением указателя на массив с объектом other
-    void swap(ArrayPtr& other) noexcept {
-        assert(this->raw_ptr_ != other.raw_ptr_);
+    // Если аллокатор не распространяется при обмене, аллокаторы должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(GetAllocator(), other.GetAllocator());
+        } else {
+            assert(GetAllocator() == other.GetAllocator());
+        }
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(size_, other.size_);
     }
 
     // Обменивается значением указателя на массив с объектом other
-    void swap(ArrayPtr&& other) noexcept {
-        assert(*this != other.raw_ptr_);
-        std::exchange(raw_ptr_, other.raw_ptr_);
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr&& other) noexcept {
+        swap(other);
+    }
+
+    // Изменяет размер выделенной памяти до new_size элементов, сохраняя её содержимое.
+    // Доступно только при kCanReallocate: элементы переносятся побайтово
+    void Reallocate(size_t new_size) {
+        static_assert(kCanReallocate, "Reallocate requires a reallocating allocator and a trivially relocatable type");
+        if (new_size == 0) {
+            Delete();
+            return;
+        }
+        if (raw_ptr_ == nullptr) {
+            raw_ptr_ = AllocTraits::allocate(GetAllocator(), new_size);
+        } else {
+            raw_ptr_ = GetAllocator().reallocate(raw_ptr_, size_, new_size);
+        }
+        size_ = new_size;
     }
 
-    // Удаление массива указателей
-    void Delete() {
-        delete[] raw_ptr_;
+    // Расширяет size до числа элементов, фактически помещающихся в выделенный блок,
+    // если аллокатор умеет его сообщить (usable_size)
+    SIMPLE_VECTOR_CONSTEXPR void ClaimUsableSize() noexcept {
+        if constexpr (AllocatorHasUsableSize<Alloc>::value) {
+            if (raw_ptr_ != nullptr && !IsConstantEvaluated()) {
+                size_ = GetAllocator().usable_size(raw_ptr_, size_);
+            }
+        }
+    }
+
+    // Освобождение памяти. Живые элементы к этому моменту должны быть разрушены владельцем
+    SIMPLE_VECTOR_CONSTEXPR void Delete() noexcept {
+        if (raw_ptr_ != nullptr) {
+            AllocTraits::deallocate(GetAllocator(), raw_ptr_, size_);
+        }
         raw_ptr_ = nullptr;
+        size_ = 0;
     }
 
 private:
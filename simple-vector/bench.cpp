@@ -0,0 +1,1144 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "aligned_allocator.h"
+#include "bench_utils.h"
+#include "bit_vector.h"
+#include "compressed_int_vector.h"
+#include "concurrent_simple_vector.h"
+#include "fixed_vector.h"
+#include "flat_containers.h"
+#include "growth_policy.h"
+#include "mapped_simple_vector.h"
+#include "parallel_algorithms.h"
+#include "segmented_simple_vector.h"
+#include "serialization.h"
+#include "shared_simple_vector.h"
+#include "simple_vector.h"
+#include "simd_kernels.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "test_types.h"
+#include "vector_algorithms.h"
+
+using namespace std;
+
+// Создаёт значение элемента для бенчмарка по номеру
+template <typename Type>
+Type MakeValue(int i) {
+    if constexpr (is_same_v<Type, string>) {
+        return to_string(i);
+    } else if constexpr (is_same_v<Type, X>) {
+        return X(static_cast<size_t>(i));
+    } else {
+        return static_cast<Type>(i);
+    }
+}
+
+// Единый интерфейс SimpleVector и std::vector для сравнительного бенчмарка
+
+template <typename Type>
+void VectorPushBack(SimpleVector<Type>& v, Type&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename Type>
+void VectorPushBack(vector<Type>& v, Type&& value) {
+    v.push_back(std::move(value));
+}
+
+template <typename Type>
+void VectorInsert(SimpleVector<Type>& v, size_t index, Type&& value) {
+    v.Insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void VectorInsert(vector<Type>& v, size_t index, Type&& value) {
+    v.insert(v.begin() + static_cast<ptrdiff_t>(index), std::move(value));
+}
+
+template <typename Type>
+void VectorErase(SimpleVector<Type>& v, size_t index) {
+    v.Erase(v.begin() + index);
+}
+
+template <typename Type>
+void VectorErase(vector<Type>& v, size_t index) {
+    v.erase(v.begin() + static_cast<ptrdiff_t>(index));
+}
+
+template <typename Type>
+void VectorReserve(SimpleVector<Type>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename Type>
+void VectorReserve(vector<Type>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename Type>
+void VectorResize(SimpleVector<Type>& v, size_t size) {
+    v.Resize(size);
+}
+
+template <typename Type>
+void VectorResize(vector<Type>& v, size_t size) {
+    v.resize(size);
+}
+
+template <typename Type>
+size_t VectorSize(const SimpleVector<Type>& v) {
+    return v.GetSize();
+}
+
+template <typename Type>
+size_t VectorSize(const vector<Type>& v) {
+    return v.size();
+}
+
+enum class VectorOp {
+    kPushBack,
+    kPushBackReserved,
+    kInsertFront,
+    kInsertMiddle,
+    kInsertBack,
+    kErase,
+    kCopy,
+    kMove,
+    kResize,
+    kEqual,
+    kLess,
+};
+
+// Число элементов, обрабатываемых одним замером: мелкие векторы замеряются пачками
+constexpr size_t kElementsPerMeasurement = 1000000;
+// Число вставок и удалений в каждый вектор
+constexpr size_t kEditsPerVector = 100;
+
+template <typename Vector>
+Vector MakeVector(size_t size) {
+    using Type = typename Vector::value_type;
+    Vector v;
+    VectorReserve(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        VectorPushBack(v, MakeValue<Type>(static_cast<int>(i)));
+    }
+    return v;
+}
+
+struct OpMeasurement {
+    double ms = 0;
+    size_t operations = 0;
+};
+
+// Замеряет операцию op над пачкой векторов из size элементов.
+// Подготовка входных векторов и разрушение результатов в замер не входят
+template <typename Vector>
+OpMeasurement MeasureVectorOp(VectorOp op, size_t size) {
+    using Type = typename Vector::value_type;
+    const size_t batches = max<size_t>(1, kElementsPerMeasurement / size);
+    const size_t edits = min(size, kEditsPerVector);
+    SimpleVector<Vector> inputs;
+    if (op != VectorOp::kPushBack && op != VectorOp::kPushBackReserved && op != VectorOp::kResize) {
+        inputs.Reserve(batches);
+        for (size_t b = 0; b < batches; ++b) {
+            inputs.PushBack(MakeVector<Vector>(size));
+        }
+    }
+    SimpleVector<optional<Vector>> outputs;
+    outputs.Resize(batches);
+    const Vector other = op == VectorOp::kEqual || op == VectorOp::kLess ? MakeVector<Vector>(size) : Vector();
+    size_t checksum = 0;
+
+    Timer timer;
+    for (size_t b = 0; b < batches; ++b) {
+        switch (op) {
+            case VectorOp::kPushBack:
+            case VectorOp::kPushBackReserved: {
+                Vector& v = outputs[b].emplace();
+                if (op == VectorOp::kPushBackReserved) {
+                    VectorReserve(v, size);
+                }
+                for (size_t i = 0; i < size; ++i) {
+                    VectorPushBack(v, MakeValue<Type>(static_cast<int>(i)));
+                }
+                break;
+            }
+            case VectorOp::kInsertFront:
+            case VectorOp::kInsertMiddle:
+            case VectorOp::kInsertBack:
+                for (size_t e = 0; e < edits; ++e) {
+                    const size_t current = VectorSize(inputs[b]);
+                    const size_t index = op == VectorOp::kInsertFront ? 0
+                                         : op == VectorOp::kInsertMiddle ? current / 2 : current;
+                    VectorInsert(inputs[b], index, MakeValue<Type>(static_cast<int>(e)));
+                }
+                break;
+            case VectorOp::kErase:
+                for (size_t e = 0; e < edits; ++e) {
+                    VectorErase(inputs[b], VectorSize(inputs[b]) / 2);
+                }
+                break;
+            case VectorOp::kCopy:
+                if constexpr (is_copy_constructible_v<Type>) {
+                    outputs[b].emplace(inputs[b]);
+                }
+                break;
+            case VectorOp::kMove:
+                outputs[b].emplace(std::move(inputs[b]));
+                break;
+            case VectorOp::kResize:
+                VectorResize(outputs[b].emplace(), size);
+                break;
+            case VectorOp::kEqual:
+                if constexpr (is_copy_constructible_v<Type>) {
+                    checksum += inputs[b] == other;
+                }
+                break;
+            case VectorOp::kLess:
+                if constexpr (is_copy_constructible_v<Type>) {
+                    checksum += inputs[b] < other;
+                }
+                break;
+        }
+    }
+    const double ms = timer.ElapsedMs();
+    DoNotOptimize(checksum);
+    DoNotOptimize(outputs);
+
+    const bool per_edit = op == VectorOp::kInsertFront || op == VectorOp::kInsertMiddle
+                          || op == VectorOp::kInsertBack || op == VectorOp::kErase;
+    return {ms, batches * (op == VectorOp::kMove ? 1 : per_edit ? edits : size)};
+}
+
+// Замеряет операцию для std::vector и SimpleVector и печатает обе строки
+template <typename Type>
+void CompareVectorOp(const string& op_name, VectorOp op, const string& type_name, size_t size) {
+    const string prefix = op_name + " <" + type_name + "> n=" + to_string(size);
+    const OpMeasurement reference = MeasureVectorOp<vector<Type>>(op, size);
+    const OpMeasurement measured = MeasureVectorOp<SimpleVector<Type>>(op, size);
+    const double reference_ns = reference.ms * 1e6 / static_cast<double>(reference.operations);
+    const double measured_ns = measured.ms * 1e6 / static_cast<double>(measured.operations);
+    PrintBenchResult(prefix + " std::vector", reference.ms, "ns_per_op=" + to_string(reference_ns));
+    PrintBenchResult(prefix + " SimpleVector", measured.ms,
+                     "ns_per_op=" + to_string(measured_ns) + " ratio_to_std=" + to_string(measured_ns / reference_ns));
+}
+
+template <typename Type>
+void BenchVectorOps(const string& type_name) {
+    for (size_t size : {size_t{16}, size_t{1000}, size_t{100000}}) {
+        CompareVectorOp<Type>("PushBack", VectorOp::kPushBack, type_name, size);
+        CompareVectorOp<Type>("PushBack after Reserve", VectorOp::kPushBackReserved, type_name, size);
+        CompareVectorOp<Type>("Insert front", VectorOp::kInsertFront, type_name, size);
+        CompareVectorOp<Type>("Insert middle", VectorOp::kInsertMiddle, type_name, size);
+        CompareVectorOp<Type>("Insert back", VectorOp::kInsertBack, type_name, size);
+        CompareVectorOp<Type>("Erase middle", VectorOp::kErase, type_name, size);
+        if constexpr (is_copy_constructible_v<Type>) {
+            CompareVectorOp<Type>("Copy construction", VectorOp::kCopy, type_name, size);
+        }
+        CompareVectorOp<Type>("Move construction", VectorOp::kMove, type_name, size);
+        CompareVectorOp<Type>("Resize", VectorOp::kResize, type_name, size);
+        if constexpr (is_copy_constructible_v<Type>) {
+            CompareVectorOp<Type>("operator==", VectorOp::kEqual, type_name, size);
+            CompareVectorOp<Type>("operator<", VectorOp::kLess, type_name, size);
+        }
+    }
+}
+
+void BenchVectorOperations() {
+    BenchGroup("SimpleVector vs std::vector (ns_per_op: per element, per insert/erase or per move)");
+    BenchVectorOps<int>("int");
+    BenchVectorOps<string>("string");
+    BenchVectorOps<X>("X");
+}
+
+// Множество коротких векторов (1..8 элементов): SimpleVector против SmallSimpleVector и FixedVector
+template <typename Vector>
+void BenchShortVectors(const string& name) {
+    const size_t iterations = 1000000;
+    AllocationStats::Reset();
+    Timer timer;
+    size_t checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        Vector v;
+        const int size = static_cast<int>(i % 8) + 1;
+        for (int j = 0; j < size; ++j) {
+            v.PushBack(MakeValue<typename Vector::value_type>(j));
+        }
+        checksum += v.GetSize();
+        DoNotOptimize(v);
+    }
+    DoNotOptimize(checksum);
+    PrintBenchResult(name, timer.ElapsedMs(),
+                     "allocations=" + to_string(AllocationStats::allocations)
+                     + " reallocations=" + to_string(AllocationStats::reallocations));
+}
+
+void BenchSmallVector() {
+    BenchGroup("Short vectors (1..8 elements, 1M vectors)");
+    BenchShortVectors<SimpleVector<int, CountingAllocator<int>>>("SimpleVector<int>");
+    BenchShortVectors<SmallSimpleVector<int, 8, CountingAllocator<int>>>("SmallSimpleVector<int, 8>");
+    BenchShortVectors<FixedVector<int, 8>>("FixedVector<int, 8>");
+    BenchShortVectors<SimpleVector<string, CountingAllocator<string>>>("SimpleVector<string>");
+    BenchShortVectors<SmallSimpleVector<string, 8, CountingAllocator<string>>>("SmallSimpleVector<string, 8>");
+    BenchShortVectors<FixedVector<string, 8>>("FixedVector<string, 8>");
+}
+
+// Раздача снимка конфигурации рабочим: каждый получает копию, читает её
+// и изменяет каждую writes_every-ю копию (0 - только чтение)
+template <typename Vector>
+void BenchSnapshotCopies(const string& name, const Vector& snapshot, size_t writes_every) {
+    const size_t copies = 2000;
+    Timer timer;
+    size_t checksum = 0;
+    for (size_t i = 0; i < copies; ++i) {
+        Vector local = snapshot;
+        checksum += std::as_const(local)[i % local.GetSize()].size();
+        if (writes_every != 0 && i % writes_every == 0) {
+            local[0] = "changed";
+        }
+        DoNotOptimize(local);
+    }
+    DoNotOptimize(checksum);
+    const double ms = timer.ElapsedMs();
+    PrintBenchResult(name, ms, "ns_per_copy=" + to_string(ms * 1e6 / copies));
+}
+
+void BenchCopyOnWrite() {
+    BenchGroup("Copies of a 10K-string snapshot (2000 copies)");
+    SimpleVector<string> config;
+    for (int i = 0; i < 10000; ++i) {
+        config.PushBack("config.key." + to_string(i) + " = some configuration value");
+    }
+    const SharedSimpleVector<string> shared(SimpleVector<string>{config});
+    for (size_t writes_every : {size_t{0}, size_t{100}, size_t{10}, size_t{1}}) {
+        const string suffix = writes_every == 0 ? " read-only" : " write every " + to_string(writes_every);
+        BenchSnapshotCopies("SimpleVector" + suffix, config, writes_every);
+        BenchSnapshotCopies("SharedSimpleVector" + suffix, shared, writes_every);
+    }
+}
+
+// Задержка отдельных PushBack при заполнении вектора: медиана, хвостовые перцентили и максимум.
+// У SimpleVector максимум - это перенос всего буфера при росте
+template <typename Vector>
+void BenchPushBackLatency(const string& name, size_t count) {
+    using Clock = chrono::steady_clock;
+    SimpleVector<uint64_t> latencies_ns(count);
+    Timer timer;
+    {
+        Vector v;
+        for (size_t i = 0; i < count; ++i) {
+            auto value = MakeValue<typename Vector::value_type>(static_cast<int>(i));
+            const Clock::time_point start = Clock::now();
+            v.PushBack(std::move(value));
+            latencies_ns[i] = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count());
+        }
+        DoNotOptimize(v);
+    }
+    const double ms = timer.ElapsedMs();
+    sort(latencies_ns.begin(), latencies_ns.end());
+    const auto percentile = [&](double p) {
+        return to_string(latencies_ns[min(count - 1, static_cast<size_t>(p * static_cast<double>(count)))]);
+    };
+    PrintBenchResult(name, ms, "p50_ns=" + percentile(0.5) + " p99_ns=" + percentile(0.99)
+                     + " p99_99_ns=" + percentile(0.9999) + " max_ns=" + to_string(latencies_ns[count - 1]));
+}
+
+void BenchSegmentedVector() {
+    const size_t count = 4000000;
+    BenchGroup("PushBack latency (4M uint64_t)");
+    BenchPushBackLatency<SimpleVector<uint64_t>>("SimpleVector<uint64_t>", count);
+    BenchPushBackLatency<SegmentedSimpleVector<uint64_t>>("SegmentedSimpleVector<uint64_t>", count);
+
+    BenchGroup("PushBack latency (4M string)");
+    BenchPushBackLatency<SimpleVector<string>>("SimpleVector<string>", count);
+    BenchPushBackLatency<SegmentedSimpleVector<string>>("SegmentedSimpleVector<string>", count);
+}
+
+// Заполнение одного большого вектора через PushBack: время, число перевыделений,
+// пиковый объём буферов и пиковый RSS процесса
+template <typename Vector>
+void BenchGrowth(const string& name, size_t count) {
+    const long peak_rss_kib = RunMeasuringPeakRss([&] {
+        AllocationStats::Reset();
+        Timer timer;
+        {
+            Vector v;
+            for (size_t i = 0; i < count; ++i) {
+                v.PushBack(MakeValue<typename Vector::value_type>(static_cast<int>(i)));
+            }
+            DoNotOptimize(v);
+        }
+        PrintBenchResult(name, timer.ElapsedMs(),
+                         "allocations=" + to_string(AllocationStats::allocations)
+                         + " reallocations=" + to_string(AllocationStats::reallocations)
+                         + " peak_buffer_mib=" + to_string(AllocationStats::peak_bytes_in_use >> 20));
+    });
+    AppendBenchDetails("peak_rss_mib=" + to_string(peak_rss_kib >> 10));
+}
+
+template <typename Type, typename Growth>
+using GrowthVector = SimpleVector<Type, CountingAllocator<Type>, Growth>;
+
+void BenchGrowthPolicies() {
+    const size_t count = 20000000;
+    BenchGroup("Growth policies (PushBack of 20M uint64_t, realloc path)");
+    BenchGrowth<GrowthVector<uint64_t, DoublingGrowth>>("DoublingGrowth", count);
+    BenchGrowth<GrowthVector<uint64_t, OneAndHalfGrowth>>("OneAndHalfGrowth", count);
+    BenchGrowth<GrowthVector<uint64_t, PageGrowth>>("PageGrowth", count);
+    BenchGrowth<GrowthVector<uint64_t, HugePageGrowth>>("HugePageGrowth", count);
+    BenchGrowth<GrowthVector<uint64_t, UsableSizeGrowth<>>>("UsableSizeGrowth", count);
+
+    const size_t string_count = 2000000;
+    BenchGroup("Growth policies (PushBack of 2M string, allocate + move path)");
+    BenchGrowth<GrowthVector<string, DoublingGrowth>>("DoublingGrowth", string_count);
+    BenchGrowth<GrowthVector<string, OneAndHalfGrowth>>("OneAndHalfGrowth", string_count);
+    BenchGrowth<GrowthVector<string, PageGrowth>>("PageGrowth", string_count);
+    BenchGrowth<GrowthVector<string, UsableSizeGrowth<>>>("UsableSizeGrowth", string_count);
+}
+
+// Вливание пачек в середину вектора: поэлементный Insert против вставки диапазона
+template <typename Type>
+void BenchBatchInsert(const string& name, bool by_range) {
+    const size_t base_size = 100000;
+    const size_t batch_size = 256;
+    const size_t batches = 50;
+    SimpleVector<Type, CountingAllocator<Type>> batch;
+    for (size_t i = 0; i < batch_size; ++i) {
+        batch.PushBack(MakeValue<Type>(static_cast<int>(i)));
+    }
+    SimpleVector<Type, CountingAllocator<Type>> v;
+    for (size_t i = 0; i < base_size; ++i) {
+        v.PushBack(MakeValue<Type>(static_cast<int>(i)));
+    }
+    AllocationStats::Reset();
+    Timer timer;
+    for (size_t b = 0; b < batches; ++b) {
+        auto pos = v.begin() + v.GetSize() / 2;
+        if (by_range) {
+            v.Insert(pos, batch.begin(), batch.end());
+        } else {
+            for (const Type& item : batch) {
+                pos = v.Insert(pos, item) + 1;
+            }
+        }
+    }
+    DoNotOptimize(v);
+    PrintBenchResult(name, timer.ElapsedMs(),
+                     "allocations=" + to_string(AllocationStats::allocations)
+                     + " reallocations=" + to_string(AllocationStats::reallocations));
+}
+
+void BenchRangeInsert() {
+    BenchGroup("Batch insert (50 batches of 256 into the middle of 100K elements)");
+    BenchBatchInsert<int>("Insert one by one <int>", false);
+    BenchBatchInsert<int>("Insert range <int>", true);
+    BenchBatchInsert<string>("Insert one by one <string>", false);
+    BenchBatchInsert<string>("Insert range <string>", true);
+}
+
+// Удаление каждого десятого элемента из 100K: Erase в цикле, EraseIf и SwapErase
+template <typename Type>
+void BenchFilter(const string& name, int mode) {
+    const size_t size = 100000;
+    SimpleVector<Type> v;
+    for (size_t i = 0; i < size; ++i) {
+        v.PushBack(MakeValue<Type>(static_cast<int>(i)));
+    }
+    size_t index = 0;
+    const auto expired = [&index](const Type&) { return index++ % 10 == 0; };
+    Timer timer;
+    if (mode == 0) {
+        for (auto it = v.begin(); it != v.end();) {
+            it = expired(*it) ? v.Erase(it) : it + 1;
+        }
+    } else if (mode == 1) {
+        v.EraseIf(expired);
+    } else {
+        for (auto it = v.begin(); it != v.end();) {
+            it = expired(*it) ? v.SwapErase(it) : it + 1;
+        }
+    }
+    DoNotOptimize(v);
+    PrintBenchResult(name, timer.ElapsedMs(), "size=" + to_string(v.GetSize()));
+}
+
+void BenchBulkErase() {
+    BenchGroup("Filter (remove every 10th of 100K elements)");
+    BenchFilter<int>("Erase in loop <int>", 0);
+    BenchFilter<int>("EraseIf <int>", 1);
+    BenchFilter<int>("SwapErase in loop <int>", 2);
+    BenchFilter<string>("Erase in loop <string>", 0);
+    BenchFilter<string>("EraseIf <string>", 1);
+    BenchFilter<string>("SwapErase in loop <string>", 2);
+}
+
+// Возвращает название набора инструкций
+string SimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::kAvx512:
+            return "avx512";
+        case SimdLevel::kAvx2:
+            return "avx2";
+        case SimdLevel::kSse42:
+            return "sse4.2";
+        case SimdLevel::kScalar:
+            break;
+    }
+    return "scalar";
+}
+
+// Замеряет op, повторённую repeats раз, и печатает время одного прохода и пропускную способность
+template <typename Op>
+void BenchKernel(const string& name, size_t bytes, size_t repeats, Op op) {
+    Timer timer;
+    for (size_t i = 0; i < repeats; ++i) {
+        DoNotOptimize(op());
+    }
+    const double ms = timer.ElapsedMs() / static_cast<double>(repeats);
+    const double gib_per_s = static_cast<double>(bytes) / (ms / 1000.0) / (1 << 30);
+    PrintBenchResult(name, ms, "GiB/s=" + to_string(gib_per_s));
+}
+
+// Векторные ядра против скалярной реализации на массивах из size элементов
+template <typename Type>
+void BenchSimdType(const string& type_name, size_t size) {
+    const size_t repeats = max<size_t>(1, 100000000 / size / 4);
+    SimpleVector<Type> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<Type>(i % 100);
+    }
+    SimpleVector<Type> other = data;
+    const Type absent = static_cast<Type>(101);
+    const size_t bytes = size * sizeof(Type);
+    for (SimdLevel level : {SimdLevel::kScalar, DetectSimdLevel()}) {
+        SetSimdLevel(level);
+        const string prefix = type_name + " " + to_string(size) + " " + SimdLevelName(level) + " ";
+        BenchKernel(prefix + "fill", bytes, repeats, [&] { Fill(other, absent); return other[0]; });
+        other = data;
+        BenchKernel(prefix + "find", bytes, repeats, [&] { return Find(data, absent); });
+        BenchKernel(prefix + "count", bytes, repeats, [&] { return Count(data, absent); });
+        BenchKernel(prefix + "min", bytes, repeats, [&] { return MinValue(data); });
+        BenchKernel(prefix + "sum", bytes, repeats, [&] { return Sum(data); });
+        BenchKernel(prefix + "equal", 2 * bytes, repeats, [&] { return data == other; });
+        BenchKernel(prefix + "less", 2 * bytes, repeats, [&] { return data < other; });
+    }
+    SetSimdLevel(DetectSimdLevel());
+}
+
+void BenchSimdKernels() {
+    BenchGroup("SIMD kernels (ms per pass), detected: " + SimdLevelName(DetectSimdLevel()));
+    for (size_t size : {size_t{1000}, size_t{1000000}, size_t{100000000}}) {
+        BenchSimdType<int32_t>("int32", size);
+        BenchSimdType<uint8_t>("uint8", size);
+        BenchSimdType<float>("float", size);
+        BenchSimdType<double>("double", size);
+    }
+}
+
+// Битовый вектор против SimpleVector<bool> на 64M элементов: объём памяти, побитовое И, подсчёт.
+// GiB/s считаются по байтам, которые хранит каждый контейнер
+void BenchBitVector() {
+    const size_t size = size_t{1} << 26;
+    BenchGroup("BitVector vs SimpleVector<bool>, 64M elements");
+    SimpleVector<bool> lhs_bools(size);
+    SimpleVector<bool> rhs_bools(size);
+    BitVector lhs_bits(size);
+    BitVector rhs_bits(size);
+    for (size_t i = 0; i < size; ++i) {
+        lhs_bools[i] = i % 3 == 0;
+        rhs_bools[i] = i % 5 == 0;
+        lhs_bits[i] = lhs_bools[i];
+        rhs_bits[i] = rhs_bools[i];
+    }
+    const size_t bool_bytes = size * sizeof(bool);
+    const size_t bit_bytes = lhs_bits.GetWordCount() * sizeof(BitVector::Word);
+    PrintBenchResult("memory SimpleVector<bool>", 0, "bytes=" + to_string(bool_bytes));
+    PrintBenchResult("memory BitVector", 0, "bytes=" + to_string(bit_bytes));
+
+    BenchKernel("SimpleVector<bool> and", 2 * bool_bytes, 5, [&] {
+        for (size_t i = 0; i < size; ++i) {
+            lhs_bools[i] = lhs_bools[i] && rhs_bools[i];
+        }
+        return lhs_bools[0];
+    });
+    for (SimdLevel level : {SimdLevel::kScalar, DetectSimdLevel()}) {
+        SetSimdLevel(level);
+        BenchKernel("BitVector and " + SimdLevelName(level), 2 * bit_bytes, 5, [&] {
+            lhs_bits &= rhs_bits;
+            return lhs_bits.Data()[0];
+        });
+        BenchKernel("BitVector count " + SimdLevelName(level), bit_bytes, 5, [&] { return lhs_bits.Count(); });
+    }
+    SetSimdLevel(DetectSimdLevel());
+    BenchKernel("SimpleVector<bool> count", bool_bytes, 5, [&] {
+        return std::count(lhs_bools.begin(), lhs_bools.end(), true);
+    });
+
+    // Поиск установленных битов: по словам против поэлементного прохода
+    BenchKernel("SimpleVector<bool> scan set", bool_bytes, 5, [&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += lhs_bools[i] ? i : 0;
+        }
+        return sum;
+    });
+    BenchKernel("BitVector ForEachSetBit", bit_bytes, 5, [&] {
+        size_t sum = 0;
+        lhs_bits.ForEachSetBit([&](size_t index) { sum += index; });
+        return sum;
+    });
+
+    // Select по случайным номерам: просмотр слов от начала против индекса суперблоков
+    const size_t set_bits = lhs_bits.Count();
+    const size_t queries = 256;
+    const auto select_queries = [&] {
+        size_t sum = 0;
+        for (size_t q = 0; q < queries; ++q) {
+            sum += lhs_bits.Select((q * 2654435761u) % set_bits);
+        }
+        return sum;
+    };
+    for (bool indexed : {false, true}) {
+        if (indexed) {
+            lhs_bits.BuildRankIndex();
+        }
+        Timer timer;
+        DoNotOptimize(select_queries());
+        const double ms = timer.ElapsedMs();
+        PrintBenchResult(string("BitVector select ") + (indexed ? "indexed" : "linear"), ms,
+                         "ns/query=" + to_string(ms * 1e6 / static_cast<double>(queries)));
+    }
+}
+
+// Сжатие одного набора значений: степень сжатия, распаковка скалярно и векторно, доступ по индексу
+void BenchCompressedSet(const string& name, const SimpleVector<uint64_t>& values) {
+    const size_t raw_bytes = values.GetSize() * sizeof(uint64_t);
+    const size_t repeats = max<size_t>(5, 100000000 / values.GetSize());
+    Timer timer;
+    const CompressedIntVector compressed(values.begin(), values.end());
+    const double encode_ms = timer.ElapsedMs();
+    const double ratio = static_cast<double>(raw_bytes) / static_cast<double>(compressed.GetCompressedBytes());
+    PrintBenchResult(name + " encode", encode_ms,
+                     "bytes=" + to_string(compressed.GetCompressedBytes()) + " ratio=" + to_string(ratio));
+
+    SimpleVector<uint64_t> decoded;
+    for (SimdLevel level : {SimdLevel::kScalar, DetectSimdLevel()}) {
+        SetSimdLevel(level);
+        BenchKernel(name + " decode " + SimdLevelName(level), raw_bytes, repeats, [&] {
+            compressed.DecodeTo(decoded);
+            return decoded[decoded.GetSize() - 1];
+        });
+    }
+    SetSimdLevel(DetectSimdLevel());
+    if (decoded != values) {
+        cerr << "Error: " << name << " decoded values differ" << endl;
+    }
+
+    const size_t lookups = 1000000;
+    mt19937_64 generator(5);
+    SimpleVector<size_t> indices(lookups);
+    for (size_t& index : indices) {
+        index = generator() % values.GetSize();
+    }
+    Timer lookup_timer;
+    uint64_t sum = 0;
+    for (size_t index : indices) {
+        sum += compressed[index];
+    }
+    DoNotOptimize(sum);
+    const double ms = lookup_timer.ElapsedMs();
+    PrintBenchResult(name + " random access", ms, "ns_per_op=" + to_string(ms * 1e6 / static_cast<double>(lookups)));
+}
+
+// Отсортированные идентификаторы (delta), малые счётчики (frame of reference) и случайные 64-битные числа
+void BenchCompressedIntVector() {
+    const size_t size = 16000000;
+    BenchGroup("CompressedIntVector, 16M uint64 values (GiB/s of decoded output)");
+    mt19937_64 generator(11);
+    SimpleVector<uint64_t> sorted(size);
+    SimpleVector<uint64_t> counters(size);
+    SimpleVector<uint64_t> random(size);
+    uint64_t id = 1ull << 40;
+    for (size_t i = 0; i < size; ++i) {
+        id += 1 + generator() % 64;
+        sorted[i] = id;
+        counters[i] = generator() % 1000;
+        random[i] = generator();
+    }
+    BenchCompressedSet("sorted ids", sorted);
+    BenchCompressedSet("counters", counters);
+    BenchCompressedSet("random", random);
+    // Распаковка из кеша: скорость ядра без ограничения пропускной способностью памяти
+    SimpleVector<uint64_t> cached(65536);
+    std::copy(sorted.begin(), sorted.begin() + cached.GetSize(), cached.begin());
+    BenchCompressedSet("sorted ids 64K", cached);
+}
+
+// Запись в 64 байта, из которой аналитические проходы читают одно-два поля
+struct Trade {
+    uint64_t id;
+    double price;
+    double quantity;
+    uint32_t venue;
+    uint32_t flags;
+    char symbol[32];
+};
+
+// Проход по одному и двум полям: массив записей (AoS) против столбцов SoAVector.
+// GiB/s считаются по объёму прочитанных полей
+void BenchSoAVector() {
+    const size_t size = 4000000;
+    BenchGroup("Field scans over 4M 64-byte records (AoS vs SoA)");
+    SimpleVector<Trade> aos(Reserve(size));
+    SoAVector<uint64_t, double, double, uint32_t, uint32_t, array<char, 32>> soa;
+    soa.Reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        const double price = static_cast<double>(i % 1000) * 0.25;
+        const double quantity = static_cast<double>(i % 7 + 1);
+        aos.PushBack(Trade{i, price, quantity, static_cast<uint32_t>(i % 16), 0, {}});
+        soa.PushBack(uint64_t{i}, price, quantity, static_cast<uint32_t>(i % 16), uint32_t{0}, array<char, 32>{});
+    }
+    static_assert(sizeof(Trade) == 64);
+
+    BenchKernel("AoS sum(price)", size * sizeof(double), 5, [&] {
+        double sum = 0;
+        for (const Trade& trade : aos) {
+            sum += trade.price;
+        }
+        return sum;
+    });
+    BenchKernel("SoA sum(price) loop", size * sizeof(double), 5, [&] {
+        double sum = 0;
+        for (double price : soa.Column<1>()) {
+            sum += price;
+        }
+        return sum;
+    });
+    BenchKernel("SoA sum(price) SIMD Sum", size * sizeof(double), 5, [&] {
+        return Sum(soa.Column<1>());
+    });
+    BenchKernel("AoS sum(price * quantity)", size * 2 * sizeof(double), 5, [&] {
+        double sum = 0;
+        for (const Trade& trade : aos) {
+            sum += trade.price * trade.quantity;
+        }
+        return sum;
+    });
+    BenchKernel("SoA sum(price * quantity)", size * 2 * sizeof(double), 5, [&] {
+        const ColumnRange<double> prices = soa.Column<1>();
+        const ColumnRange<double> quantities = soa.Column<2>();
+        double sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += prices[i] * quantities[i];
+        }
+        return sum;
+    });
+    BenchKernel("AoS count(venue == 3)", size * sizeof(uint32_t), 5, [&] {
+        size_t count = 0;
+        for (const Trade& trade : aos) {
+            count += trade.venue == 3;
+        }
+        return count;
+    });
+    BenchKernel("SoA count(venue == 3)", size * sizeof(uint32_t), 5, [&] {
+        size_t count = 0;
+        for (uint32_t venue : soa.Column<3>()) {
+            count += venue == 3;
+        }
+        return count;
+    });
+}
+
+// Поиск lookups случайных ключей (половина присутствует) в контейнере через find(key)
+template <typename Find>
+void BenchLookups(const string& name, const SimpleVector<uint64_t>& queries, Find find) {
+    Timer timer;
+    size_t found = 0;
+    for (uint64_t key : queries) {
+        found += find(key) ? 1 : 0;
+    }
+    DoNotOptimize(found);
+    const double ms = timer.ElapsedMs();
+    PrintBenchResult(name, ms, "ns_per_lookup=" + to_string(ms * 1e6 / static_cast<double>(queries.GetSize())));
+}
+
+// Сортированные контейнеры: построение вставками и поиск
+void BenchFlatContainers() {
+    mt19937_64 generator(7);
+    for (size_t size : {size_t{100000}, size_t{4000000}}) {
+        SimpleVector<uint64_t> keys(Reserve(size));
+        for (size_t i = 0; i < size; ++i) {
+            keys.PushBack(generator() | 1);
+        }
+        SimpleVector<uint64_t> queries(Reserve(2000000));
+        for (size_t i = 0; i < 2000000; ++i) {
+            queries.PushBack(i % 2 == 0 ? keys[generator() % size] : generator() & ~uint64_t{1});
+        }
+
+        BenchGroup("Sorted containers: build from " + to_string(size) + " random uint64_t");
+        set<uint64_t> std_set;
+        {
+            Timer timer;
+            for (uint64_t key : keys) {
+                std_set.insert(key);
+            }
+            PrintBenchResult("std::set insert", timer.ElapsedMs());
+        }
+        SimpleVector<uint64_t> sorted;
+        if (size <= 100000) {
+            Timer timer;
+            for (uint64_t key : keys) {
+                sorted.Insert(lower_bound(sorted.begin(), sorted.end(), key), key);
+            }
+            PrintBenchResult("sorted SimpleVector Insert per key", timer.ElapsedMs());
+        } else {
+            sorted = keys;
+            sort(sorted.begin(), sorted.end());
+        }
+        FlatSet<uint64_t> flat;
+        {
+            Timer timer;
+            // Пакеты по 10% размера: дописать, отсортировать серию, слить
+            const size_t batch = size / 10;
+            for (size_t first = 0; first < size; first += batch) {
+                flat.Insert(keys.begin() + first, keys.begin() + min(size, first + batch));
+            }
+            PrintBenchResult("FlatSet batch Insert (10 batches)", timer.ElapsedMs());
+        }
+
+        BenchGroup("Sorted containers: 2M lookups in " + to_string(size) + " uint64_t (50% hits)");
+        BenchLookups("std::set find", queries, [&](uint64_t key) { return std_set.find(key) != std_set.end(); });
+        BenchLookups("SimpleVector + std::lower_bound", queries, [&](uint64_t key) {
+            const auto it = lower_bound(sorted.begin(), sorted.end(), key);
+            return it != sorted.end() && *it == key;
+        });
+        BenchLookups("FlatSet branchless", queries, [&](uint64_t key) { return flat.Contains(key); });
+        flat.BuildSearchIndex();
+        BenchLookups("FlatSet Eytzinger", queries, [&](uint64_t key) { return flat.Contains(key); });
+
+        map<uint64_t, uint64_t> std_map;
+        FlatMap<uint64_t, uint64_t> flat_map;
+        SimpleVector<pair<uint64_t, uint64_t>> pairs(Reserve(size));
+        for (uint64_t key : keys) {
+            std_map.emplace(key, key * 3);
+            pairs.PushBack({key, key * 3});
+        }
+        flat_map.Insert(pairs.begin(), pairs.end());
+        BenchLookups("std::map find", queries, [&](uint64_t key) { return std_map.find(key) != std_map.end(); });
+        BenchLookups("FlatMap branchless", queries, [&](uint64_t key) { return flat_map.Contains(key); });
+        flat_map.BuildSearchIndex();
+        BenchLookups("FlatMap Eytzinger", queries, [&](uint64_t key) { return flat_map.Contains(key); });
+    }
+}
+
+// Масштабирование параллельных алгоритмов на 20M элементов при 1..N потоках
+void BenchParallelAlgorithms() {
+    const size_t size = 20000000;
+    const size_t max_concurrency = WorkStealingPool::DefaultConcurrency();
+    BenchGroup("Parallel algorithms (20M elements, hardware threads: " + to_string(max_concurrency) + ")");
+    SimpleVector<uint64_t> source(size);
+    for (size_t i = 0; i < size; ++i) {
+        source[i] = (i * 2654435761u) % 1000003;
+    }
+    SimpleVector<double> transformed(size);
+    SimpleVector<size_t> levels;
+    for (size_t concurrency = 1; concurrency < max_concurrency; concurrency *= 2) {
+        levels.PushBack(concurrency);
+    }
+    levels.PushBack(max_concurrency);
+    for (size_t concurrency : levels) {
+        WorkStealingPool pool(concurrency);
+        const ParallelOptions options{0, &pool};
+        const string suffix = " threads=" + to_string(concurrency);
+        SimpleVector<uint64_t> data = source;
+        BenchKernel("ParallelForEach" + suffix, size * sizeof(uint64_t), 3, [&] {
+            ParallelForEach(data, [](uint64_t& item) { item = item * 3 + 1; }, options);
+            return data[0];
+        });
+        BenchKernel("ParallelTransform" + suffix, size * sizeof(uint64_t), 3, [&] {
+            ParallelTransform(data, transformed.begin(),
+                              [](uint64_t item) { return std::sqrt(static_cast<double>(item)); }, options);
+            return transformed[0];
+        });
+        BenchKernel("ParallelReduce" + suffix, size * sizeof(uint64_t), 3, [&] {
+            return ParallelReduce(data, uint64_t{0}, std::plus<>(), options);
+        });
+        BenchKernel("ParallelInclusiveScan" + suffix, size * sizeof(uint64_t), 3, [&] {
+            ParallelInclusiveScan(data.begin(), data.end(), data.begin(), std::plus<>(), options);
+            return data[size - 1];
+        });
+        data = source;
+        BenchKernel("ParallelSort" + suffix, size * sizeof(uint64_t), 1, [&] {
+            ParallelSort(data, std::less<>(), options);
+            return data[0];
+        });
+    }
+}
+
+// Сборщик, в который threads потоков одновременно добавляют по per_thread элементов.
+// push(thread, value) добавляет один элемент
+template <typename Push>
+double RunCollectors(size_t threads, size_t per_thread, Push push) {
+    Timer timer;
+    SimpleVector<thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.PushBack(thread([&push, t, per_thread] {
+            for (size_t i = 0; i < per_thread; ++i) {
+                push(t * per_thread + i);
+            }
+        }));
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    return timer.ElapsedMs();
+}
+
+// Многопоточное добавление: SimpleVector под мьютексом против ConcurrentSimpleVector
+void BenchConcurrentAppend() {
+    const size_t total = 8000000;
+    const size_t max_concurrency = WorkStealingPool::DefaultConcurrency();
+    BenchGroup("Concurrent append (8M uint64_t, hardware threads: " + to_string(max_concurrency) + ")");
+    // Не меньше 4 писателей, чтобы конкуренция за мьютекс была видна и на малом числе ядер
+    const size_t max_threads = std::max<size_t>(max_concurrency, 4);
+    SimpleVector<size_t> levels;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        levels.PushBack(threads);
+    }
+    levels.PushBack(max_threads);
+    for (size_t threads : levels) {
+        const size_t per_thread = total / threads;
+        const string suffix = " threads=" + to_string(threads);
+        {
+            SimpleVector<uint64_t> v;
+            mutex guard;
+            const double ms = RunCollectors(threads, per_thread, [&](uint64_t value) {
+                lock_guard<mutex> lock(guard);
+                v.PushBack(value);
+            });
+            DoNotOptimize(v);
+            PrintBenchResult("mutex + SimpleVector" + suffix, ms,
+                             "ns_per_push=" + to_string(ms * 1e6 / static_cast<double>(threads * per_thread)));
+        }
+        {
+            ConcurrentSimpleVector<uint64_t> v;
+            const double ms = RunCollectors(threads, per_thread, [&](uint64_t value) {
+                v.PushBack(value);
+            });
+            DoNotOptimize(v);
+            PrintBenchResult("ConcurrentSimpleVector" + suffix, ms,
+                             "ns_per_push=" + to_string(ms * 1e6 / static_cast<double>(threads * per_thread)));
+        }
+    }
+}
+
+// Загрузка таблицы из 10M чисел: разбор текстового файла с PushBack против открытия MappedSimpleVector
+void BenchMappedOpen() {
+    const size_t size = 10000000;
+    const string text_path = "/tmp/bench_mapped_table.txt";
+    const string binary_path = "/tmp/bench_mapped_table.bin";
+    {
+        ofstream text(text_path);
+        MappedSimpleVector<uint64_t> binary(binary_path, MapMode::kCreate);
+        binary.Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            const uint64_t value = (i * 2654435761u) % 1000003;
+            text << value << '\n';
+            binary.PushBack(value);
+        }
+    }
+    BenchGroup("Loading a table of 10M uint64");
+    BenchKernel("parse + PushBack", size * sizeof(uint64_t), 1, [&] {
+        ifstream text(text_path);
+        SimpleVector<uint64_t> table;
+        uint64_t value = 0;
+        while (text >> value) {
+            table.PushBack(value);
+        }
+        return table[size - 1];
+    });
+    BenchKernel("mmap open", size * sizeof(uint64_t), 10, [&] {
+        MappedSimpleVector<uint64_t> table(binary_path, MapMode::kReadOnly);
+        return table[size - 1];
+    });
+    BenchKernel("mmap open + full scan", size * sizeof(uint64_t), 3, [&] {
+        MappedSimpleVector<uint64_t> table(binary_path, MapMode::kReadOnly);
+        table.Advise(MapAdvice::kSequential);
+        return Sum(table);
+    });
+    remove(text_path.c_str());
+    remove(binary_path.c_str());
+}
+
+// Сохранение и загрузка 10M uint64: поток, writev/readv и потоковое чтение частями по 64K элементов
+void BenchSerialization() {
+    const size_t size = 10000000;
+    const string path = "/tmp/bench_serialized_vector.bin";
+    SimpleVector<uint64_t> source(size);
+    for (size_t i = 0; i < size; ++i) {
+        source[i] = (i * 2654435761u) % 1000003;
+    }
+    BenchGroup("Serialization of 10M uint64");
+    BenchKernel("Serialize (ofstream)", size * sizeof(uint64_t), 3, [&] {
+        ofstream out(path, ios::binary);
+        Serialize(out, source);
+        return source[0];
+    });
+    BenchKernel("WriteToFd (writev)", size * sizeof(uint64_t), 3, [&] {
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        WriteToFd(fd, source);
+        ::close(fd);
+        return source[0];
+    });
+    BenchKernel("Deserialize (ifstream)", size * sizeof(uint64_t), 3, [&] {
+        ifstream in(path, ios::binary);
+        SimpleVector<uint64_t> table;
+        Deserialize(in, table);
+        return table[size - 1];
+    });
+    BenchKernel("ReadFromFd (readv)", size * sizeof(uint64_t), 3, [&] {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        SimpleVector<uint64_t> table;
+        ReadFromFd(fd, table);
+        ::close(fd);
+        return table[size - 1];
+    });
+    BenchKernel("ChunkedVectorReader + Sum", size * sizeof(uint64_t), 3, [&] {
+        ifstream in(path, ios::binary);
+        ChunkedVectorReader<uint64_t> reader(in);
+        SimpleVector<uint64_t> chunk;
+        uint64_t sum = 0;
+        while (reader.ReadChunk(chunk, 65536)) {
+            sum += Sum(chunk);
+        }
+        return sum;
+    });
+    remove(path.c_str());
+}
+
+// Возвращает объём анонимной памяти процесса на прозрачных больших страницах (КиБ)
+long ReadAnonHugePagesKb() {
+    ifstream smaps("/proc/self/smaps_rollup");
+    string key;
+    long kb = 0;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:") {
+            smaps >> kb;
+            return kb;
+        }
+        smaps.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    return 0;
+}
+
+// Последовательная сумма и случайная выборка по indices из size элементов вектора Vector
+template <typename Vector>
+void BenchScanBacking(const string& name, size_t size, const SimpleVector<uint32_t>& indices) {
+    const long huge_kb_before = ReadAnonHugePagesKb();
+    Vector data;
+    data.ResizeForOverwrite(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = i;
+    }
+    const long huge_kb = ReadAnonHugePagesKb() - huge_kb_before;
+    BenchKernel(name + " sequential sum", size * sizeof(uint64_t), 5, [&] {
+        return Sum(data);
+    });
+    AppendBenchDetails("huge_page_kb=" + to_string(huge_kb));
+    BenchKernel(name + " random gather", indices.GetSize() * sizeof(uint64_t), 3, [&] {
+        uint64_t sum = 0;
+        for (uint32_t index : indices) {
+            sum += data[index];
+        }
+        return sum;
+    });
+}
+
+// Проход по 512 МиБ uint64 в куче, в буфере, выровненном по строке кэша, и на больших страницах.
+// Случайная выборка упирается в промахи TLB, которые большие страницы сокращают
+void BenchPageBacking() {
+    const size_t size = 64 * 1024 * 1024;
+    SimpleVector<uint32_t> indices(16 * 1024 * 1024);
+    mt19937 generator(42);
+    for (uint32_t& index : indices) {
+        index = static_cast<uint32_t>(generator() % size);
+    }
+    BenchGroup("Scan of 64M uint64 by buffer backing");
+    BenchScanBacking<SimpleVector<uint64_t>>("malloc", size, indices);
+    BenchScanBacking<AlignedSimpleVector<uint64_t>>("aligned 64", size, indices);
+    BenchScanBacking<HugePageSimpleVector<uint64_t>>("huge pages", size, indices);
+}
+
+int main(int argc, char* argv[]) {
+    string json_path;
+    string filter;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [--json FILE] [--filter SUITE]" << endl;
+            return 1;
+        }
+    }
+
+    const pair<string, void (*)()> suites[] = {
+        {"vector_ops", BenchVectorOperations},
+        {"small_vector", BenchSmallVector},
+        {"cow", BenchCopyOnWrite},
+        {"growth", BenchGrowthPolicies},
+        {"segmented", BenchSegmentedVector},
+        {"range_insert", BenchRangeInsert},
+        {"bulk_erase", BenchBulkErase},
+        {"simd", BenchSimdKernels},
+        {"bit_vector", BenchBitVector},
+        {"compressed", BenchCompressedIntVector},
+        {"soa", BenchSoAVector},
+        {"flat", BenchFlatContainers},
+        {"huge_pages", BenchPageBacking},
+        {"parallel", BenchParallelAlgorithms},
+        {"concurrent_append", BenchConcurrentAppend},
+        {"mapped", BenchMappedOpen},
+        {"serialization", BenchSerialization},
+    };
+    for (const auto& [name, run] : suites) {
+        if (filter.empty() || name.find(filter) != string::npos) {
+            run();
+        }
+    }
+
+    if (!json_path.empty()) {
+        ofstream out(json_path);
+        BenchReport::WriteJson(out);
+        if (!out) {
+            cerr << "Error: Failed to write " << json_path << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
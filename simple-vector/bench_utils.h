@@ -0,0 +1,293 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "allocator.h"
+
+// Счётчики обращений к памяти, которые ведёт CountingAllocator
+struct AllocationStats {
+    static inline size_t allocations = 0;
+    static inline size_t reallocations = 0;
+    static inline size_t deallocations = 0;
+    static inline size_t bytes_allocated = 0;
+    static inline size_t bytes_in_use = 0;
+    static inline size_t peak_bytes_in_use = 0;
+
+    static void Reset() {
+        allocations = 0;
+        reallocations = 0;
+        deallocations = 0;
+        bytes_allocated = 0;
+        bytes_in_use = 0;
+        peak_bytes_in_use = 0;
+    }
+
+    static void Grow(size_t bytes) {
+        bytes_in_use += bytes;
+        peak_bytes_in_use = bytes_in_use > peak_bytes_in_use ? bytes_in_use : peak_bytes_in_use;
+    }
+};
+
+// DefaultAllocator, считающий выделения памяти в AllocationStats
+template <typename Type>
+class CountingAllocator : public DefaultAllocator<Type> {
+public:
+    using value_type = Type;
+
+    CountingAllocator() noexcept = default;
+
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other>&) noexcept {}
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        ++AllocationStats::allocations;
+        AllocationStats::bytes_allocated += size * sizeof(Type);
+        Type* raw_ptr = DefaultAllocator<Type>::allocate(size);
+        AllocationStats::Grow(size * sizeof(Type));
+        return raw_ptr;
+    }
+
+    void deallocate(Type* raw_ptr, size_t size) noexcept {
+        ++AllocationStats::deallocations;
+        AllocationStats::bytes_in_use -= size * sizeof(Type);
+        DefaultAllocator<Type>::deallocate(raw_ptr, size);
+    }
+
+    [[nodiscard]] Type* reallocate(Type* raw_ptr, size_t old_size, size_t new_size) {
+        ++AllocationStats::reallocations;
+        AllocationStats::bytes_allocated += new_size * sizeof(Type);
+        Type* new_ptr = DefaultAllocator<Type>::reallocate(raw_ptr, old_size, new_size);
+        AllocationStats::bytes_in_use -= old_size * sizeof(Type);
+        AllocationStats::Grow(new_size * sizeof(Type));
+        return new_ptr;
+    }
+
+    // Запас блока, забранный вектором, тоже считается занятым
+    size_t usable_size(Type* raw_ptr, size_t size) const noexcept {
+        const size_t usable = DefaultAllocator<Type>::usable_size(raw_ptr, size);
+        AllocationStats::Grow((usable - size) * sizeof(Type));
+        return usable;
+    }
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const CountingAllocator<Lhs>&, const CountingAllocator<Rhs>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const CountingAllocator<Lhs>&, const CountingAllocator<Rhs>&) noexcept {
+    return false;
+}
+
+// Засекает время с момента создания
+class Timer {
+public:
+    Timer()
+        : start_(std::chrono::steady_clock::now())
+    {}
+
+    // Возвращает прошедшее время в миллисекундах
+    double ElapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Не даёт компилятору выбросить вычисление value
+template <typename Type>
+inline void DoNotOptimize(const Type& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Результат одного замера
+struct BenchRecord {
+    std::string group;
+    std::string name;
+    double ms = 0;
+    // Пары key=value через пробел; числовые значения попадают в JSON как метрики
+    std::string details;
+};
+
+// Все замеры процесса: печатаются по ходу выполнения и могут быть сохранены в JSON,
+// чтобы сравнивать результаты между версиями
+struct BenchReport {
+    static inline std::string group;
+    static inline std::vector<BenchRecord> records;
+
+    // Записывает замеры в JSON-документ
+    static void WriteJson(std::ostream& out) {
+#if defined(__clang__)
+        const std::string compiler = std::string("clang ") + __VERSION__;
+#elif defined(__GNUC__)
+        const std::string compiler = std::string("gcc ") + __VERSION__;
+#else
+        const std::string compiler = "unknown";
+#endif
+        out << "{\n  \"context\": {\"compiler\": " << Quote(compiler)
+            << ", \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+            << ", \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << "},\n"
+            << "  \"benchmarks\": [";
+        for (size_t i = 0; i < records.size(); ++i) {
+            const BenchRecord& record = records[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\"group\": " << Quote(record.group) << ", \"name\": " << Quote(record.name)
+                << ", \"ms\": " << std::setprecision(6) << std::defaultfloat << record.ms
+                << ", \"metrics\": {";
+            std::istringstream details(record.details);
+            std::string pair;
+            bool first = true;
+            while (details >> pair) {
+                const size_t equal = pair.find('=');
+                if (equal == std::string::npos) {
+                    continue;
+                }
+                char* end = nullptr;
+                const double value = std::strtod(pair.c_str() + equal + 1, &end);
+                if (end == pair.c_str() + equal + 1 || *end != '\0') {
+                    continue;
+                }
+                out << (first ? "" : ", ") << Quote(pair.substr(0, equal)) << ": " << value;
+                first = false;
+            }
+            out << "}, \"details\": " << Quote(record.details) << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    // Кодирует замеры, начиная с first, построчно для передачи из дочернего процесса
+    static std::string Encode(size_t first) {
+        std::ostringstream out;
+        out << std::setprecision(17);
+        for (size_t i = first; i < records.size(); ++i) {
+            out << records[i].group << '\t' << records[i].name << '\t' << records[i].ms << '\t'
+                << records[i].details << '\n';
+        }
+        return out.str();
+    }
+
+    // Добавляет замеры, закодированные Encode
+    static void Decode(const std::string& text) {
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            BenchRecord record;
+            std::string ms;
+            std::getline(fields, record.group, '\t');
+            std::getline(fields, record.name, '\t');
+            std::getline(fields, ms, '\t');
+            std::getline(fields, record.details);
+            record.ms = std::strtod(ms.c_str(), nullptr);
+            records.push_back(std::move(record));
+        }
+    }
+
+private:
+    static std::string Quote(const std::string& text) {
+        std::string quoted = "\"";
+        for (const char c : text) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+                quoted += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                quoted += escaped;
+            } else {
+                quoted += c;
+            }
+        }
+        return quoted + '"';
+    }
+};
+
+// Начинает группу замеров: печатает заголовок и помечает им следующие результаты
+inline void BenchGroup(const std::string& title) {
+    BenchReport::group = title;
+    std::cout << "--- " << title << std::endl;
+}
+
+// Печатает строку результата бенчмарка и добавляет его в BenchReport
+inline void PrintBenchResult(const std::string& name, double ms, const std::string& details = {}) {
+    BenchReport::records.push_back({BenchReport::group, name, ms, details});
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(3) << ms << " ms"
+              << (details.empty() ? "" : "  ") << details << std::endl;
+}
+
+// Печатает дополнительные сведения о последнем результате отдельной строкой и добавляет их к нему
+inline void AppendBenchDetails(const std::string& details) {
+    if (!BenchReport::records.empty()) {
+        std::string& last = BenchReport::records.back().details;
+        last += last.empty() ? details : " " + details;
+    }
+    std::cout << std::left << std::setw(48) << "" << details << std::endl;
+}
+
+// Выполняет run в дочернем процессе и возвращает его пиковое потребление памяти (RSS) в КиБ,
+// чтобы память, занятая предыдущими замерами, не искажала результат. Замеры, сделанные в run,
+// передаются через канал в BenchReport родителя. Вне POSIX выполняет run
+// в текущем процессе и возвращает 0
+template <typename Run>
+long RunMeasuringPeakRss(Run run) {
+#if defined(__unix__)
+    std::cout.flush();
+    int channel[2];
+    if (pipe(channel) != 0) {
+        run();
+        return 0;
+    }
+    const size_t first_record = BenchReport::records.size();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(channel[0]);
+        run();
+        std::cout.flush();
+        const std::string encoded = BenchReport::Encode(first_record);
+        for (size_t done = 0; done < encoded.size();) {
+            const ssize_t written = write(channel[1], encoded.data() + done, encoded.size() - done);
+            if (written <= 0) {
+                break;
+            }
+            done += static_cast<size_t>(written);
+        }
+        _exit(0);
+    }
+    close(channel[1]);
+    std::string encoded;
+    char buffer[4096];
+    for (ssize_t received; pid > 0 && (received = read(channel[0], buffer, sizeof(buffer))) > 0;) {
+        encoded.append(buffer, static_cast<size_t>(received));
+    }
+    close(channel[0]);
+    BenchReport::Decode(encoded);
+    int status = 0;
+    rusage usage{};
+    if (pid < 0 || wait4(pid, &status, 0, &usage) < 0) {
+        return 0;
+    }
+    return usage.ru_maxrss;
+#else
+    run();
+    return 0;
+#endif
+}
@@ -0,0 +1,630 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "simd_kernels.h"
+#include "simple_vector.h"
+
+// Битовый вектор: по одному биту на элемент в 64-битных словах SimpleVector<uint64_t>,
+// то есть в восемь раз компактнее SimpleVector<bool>. Диапазонные операции, подсчёт
+// и поиск установленных битов работают сразу со словами, а побитовые &=, |=, ^= между
+// векторами и Count используют векторные ядра из simd_kernels.h.
+// Rank и Select без индекса просматривают слова от начала, то есть стоят O(n).
+// BuildRankIndex строит накопленные счётчики битов по суперблокам из 512 битов, после чего
+// Rank работает за O(1), а Select - за O(log n). Любое изменение битов сбрасывает индекс.
+// Отдельный класс вместо специализации SimpleVector<bool>: обычный SimpleVector<bool>
+// по-прежнему хранит настоящие bool и отдаёт на них ссылки.
+// Биты последнего слова за пределами размера всегда равны нулю
+class BitVector {
+public:
+    using Word = uint64_t;
+    using value_type = bool;
+
+    static constexpr size_t kWordBits = 64;
+
+    // Ссылка на бит: operator[] не может вернуть bool&, поэтому возвращает этот заместитель
+    class Reference {
+    public:
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+
+        Reference& operator=(bool value) noexcept {
+            owner_->DropRankIndex();
+            if (value) {
+                *word_ |= mask_;
+            } else {
+                *word_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        // Присваивает значение бита, а не перенаправляет ссылку
+        Reference& operator=(const Reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        bool operator~() const noexcept {
+            return !static_cast<bool>(*this);
+        }
+
+        Reference& Flip() noexcept {
+            owner_->DropRankIndex();
+            *word_ ^= mask_;
+            return *this;
+        }
+
+    private:
+        friend class BitVector;
+
+        Reference(BitVector* owner, Word* word, Word mask) noexcept
+            : owner_(owner)
+            , word_(word)
+            , mask_(mask)
+        {}
+
+        BitVector* owner_;
+        Word* word_;
+        Word mask_;
+    };
+
+    // Итератор произвольного доступа по значениям битов
+    class ConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = bool;
+
+        ConstIterator() = default;
+
+        bool operator*() const noexcept {
+            return owner_->Test(index_);
+        }
+
+        bool operator[](difference_type offset) const noexcept {
+            return owner_->Test(index_ + offset);
+        }
+
+        ConstIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept {
+            ConstIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        ConstIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        ConstIterator operator--(int) noexcept {
+            ConstIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        ConstIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend ConstIterator operator+(ConstIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend ConstIterator operator+(difference_type offset, ConstIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend ConstIterator operator-(ConstIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        friend class BitVector;
+
+        ConstIterator(const BitVector* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {}
+
+        const BitVector* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using Iterator = ConstIterator;
+
+    BitVector() noexcept = default;
+
+    // Создаёт вектор из size битов, равных value
+    explicit BitVector(size_t size, bool value = false)
+        : words_(WordsFor(size))
+        , size_(size)
+    {
+        if (value) {
+            SetAll();
+        }
+    }
+
+    BitVector(std::initializer_list<bool> init)
+        : words_(WordsFor(init.size()))
+        , size_(init.size())
+    {
+        size_t index = 0;
+        for (bool value : init) {
+            if (value) {
+                Set(index);
+            }
+            ++index;
+        }
+    }
+
+    // Резервирует место под capacity битов
+    BitVector(ReserveProxyObj capacity)
+        : words_(::Reserve(WordsFor(capacity.GetValue())))
+    {}
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает количество битов, которые поместятся без перераспределения памяти
+    size_t GetCapacity() const noexcept {
+        return words_.GetCapacity() * kWordBits;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Слова с битами: бит i лежит в слове i / 64 на позиции i % 64
+    const Word* Data() const noexcept {
+        return words_.begin();
+    }
+
+    size_t GetWordCount() const noexcept {
+        return words_.GetSize();
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return Reference(this, &words_[index / kWordBits], BitMask(index));
+    }
+
+    bool operator[](size_t index) const noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return Test(index);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return (*this)[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    bool At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return Test(index);
+    }
+
+    bool Test(size_t index) const noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return (words_[index / kWordBits] & BitMask(index)) != 0;
+    }
+
+    void Set(size_t index, bool value = true) noexcept {
+        (*this)[index] = value;
+    }
+
+    void Reset(size_t index) noexcept {
+        Set(index, false);
+    }
+
+    void Flip(size_t index) noexcept {
+        (*this)[index].Flip();
+    }
+
+    // Устанавливает биты [first, last) в value по словам, а не по одному биту
+    void SetRange(size_t first, size_t last, bool value = true) noexcept {
+        if (value) {
+            ForEachWordMask(first, last, [](Word& word, Word mask) { word |= mask; });
+        } else {
+            ForEachWordMask(first, last, [](Word& word, Word mask) { word &= ~mask; });
+        }
+    }
+
+    void ResetRange(size_t first, size_t last) noexcept {
+        SetRange(first, last, false);
+    }
+
+    void FlipRange(size_t first, size_t last) noexcept {
+        ForEachWordMask(first, last, [](Word& word, Word mask) { word ^= mask; });
+    }
+
+    void SetAll() noexcept {
+        DropRankIndex();
+        std::fill(words_.begin(), words_.end(), ~Word{0});
+        ClearTail();
+    }
+
+    void ResetAll() noexcept {
+        DropRankIndex();
+        std::fill(words_.begin(), words_.end(), Word{0});
+    }
+
+    void FlipAll() noexcept {
+        DropRankIndex();
+        for (Word& word : words_) {
+            word = ~word;
+        }
+        ClearTail();
+    }
+
+    // Количество установленных битов
+    size_t Count() const noexcept {
+        return SimdPopCountWords(words_.begin(), words_.GetSize());
+    }
+
+    // Количество установленных битов среди [0, index); index <= size.
+    // С индексом досчитывает не больше одного суперблока, без него - все слова до index
+    size_t Rank(size_t index) const noexcept {
+        assert((index <= size_) && "Error: Out of range!");
+        const size_t full_words = index / kWordBits;
+        size_t first_word = 0;
+        size_t result = 0;
+        if (HasRankIndex()) {
+            first_word = full_words - full_words % kSuperblockWords;
+            result = rank_index_[full_words / kSuperblockWords];
+        }
+        result += SimdPopCountWords(words_.begin() + first_word, full_words - first_word);
+        if (index % kWordBits != 0) {
+            result += static_cast<size_t>(__builtin_popcountll(words_[full_words] & LowMask(index)));
+        }
+        return result;
+    }
+
+    // Позиция установленного бита с номером rank (считая с нуля) или size, если таких меньше.
+    // С индексом двоичным поиском находит суперблок и просматривает только его слова,
+    // без индекса просматривает слова от начала
+    size_t Select(size_t rank) const noexcept {
+        size_t first_word = 0;
+        if (HasRankIndex()) {
+            if (rank >= rank_index_[rank_index_.GetSize() - 1]) {
+                return size_;
+            }
+            // Последний суперблок, перед которым установлено не больше rank битов
+            const size_t superblock =
+                static_cast<size_t>(std::upper_bound(rank_index_.begin(), rank_index_.end(), rank)
+                                    - rank_index_.begin()) - 1;
+            first_word = superblock * kSuperblockWords;
+            rank -= rank_index_[superblock];
+        }
+        for (size_t i = first_word; i < words_.GetSize(); ++i) {
+            Word word = words_[i];
+            const size_t count = static_cast<size_t>(__builtin_popcountll(word));
+            if (rank < count) {
+                for (; rank > 0; --rank) {
+                    word &= word - 1;
+                }
+                return i * kWordBits + static_cast<size_t>(__builtin_ctzll(word));
+            }
+            rank -= count;
+        }
+        return size_;
+    }
+
+    bool All() const noexcept {
+        const size_t full_words = size_ / kWordBits;
+        for (size_t i = 0; i < full_words; ++i) {
+            if (words_[i] != ~Word{0}) {
+                return false;
+            }
+        }
+        return size_ % kWordBits == 0 || words_[full_words] == LowMask(size_);
+    }
+
+    bool Any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(), [](Word word) { return word != 0; });
+    }
+
+    bool None() const noexcept {
+        return !Any();
+    }
+
+    // Позиция первого установленного бита или size, если их нет
+    size_t FindFirst() const noexcept {
+        return FindNext(0);
+    }
+
+    // Позиция первого установленного бита, не меньшего from, или size
+    size_t FindNext(size_t from) const noexcept {
+        if (from >= size_) {
+            return size_;
+        }
+        size_t i = from / kWordBits;
+        Word word = words_[i] & ~LowMask(from);
+        while (word == 0) {
+            if (++i == words_.GetSize()) {
+                return size_;
+            }
+            word = words_[i];
+        }
+        return i * kWordBits + static_cast<size_t>(__builtin_ctzll(word));
+    }
+
+    // Вызывает func(index) для каждого установленного бита по возрастанию индекса
+    template <typename Func>
+    void ForEachSetBit(Func func) const {
+        for (size_t i = 0; i < words_.GetSize(); ++i) {
+            for (Word word = words_[i]; word != 0; word &= word - 1) {
+                func(i * kWordBits + static_cast<size_t>(__builtin_ctzll(word)));
+            }
+        }
+    }
+
+    // Строит индекс для Rank и Select: число установленных битов перед каждым суперблоком.
+    // Индекс занимает одно слово на 512 битов и сбрасывается при любом изменении битов
+    void BuildRankIndex() {
+        const size_t superblocks = (words_.GetSize() + kSuperblockWords - 1) / kSuperblockWords;
+        SimpleVector<size_t> index(::Reserve(superblocks + 1));
+        size_t total = 0;
+        index.PushBack(total);
+        for (size_t first = 0; first < words_.GetSize(); first += kSuperblockWords) {
+            total += SimdPopCountWords(words_.begin() + first, std::min(kSuperblockWords, words_.GetSize() - first));
+            index.PushBack(total);
+        }
+        rank_index_.swap(index);
+    }
+
+    // Сообщает, построен ли индекс для Rank и Select
+    bool HasRankIndex() const noexcept {
+        return !rank_index_.IsEmpty();
+    }
+
+    void PushBack(bool value) {
+        DropRankIndex();
+        if (size_ % kWordBits == 0) {
+            words_.PushBack(0);
+        }
+        ++size_;
+        if (value) {
+            Set(size_ - 1);
+        }
+    }
+
+    // Добавляет в конец count младших битов слова bits (бит 0 идёт первым), count <= 64.
+    // Биты вписываются в последнее слово и следующее за ним сдвигами, а не по одному
+    void AppendWord(Word bits, size_t count = kWordBits) {
+        assert((count <= kWordBits) && "Error: Too many bits!");
+        if (count == 0) {
+            return;
+        }
+        if (count < kWordBits) {
+            bits &= LowMask(count);
+        }
+        DropRankIndex();
+        const size_t offset = size_ % kWordBits;
+        if (offset == 0) {
+            words_.PushBack(bits);
+        } else {
+            // Новое слово добавляется до записи в последнее: при исключении вектор не меняется
+            if (offset + count > kWordBits) {
+                words_.PushBack(bits >> (kWordBits - offset));
+            }
+            words_[(size_ - 1) / kWordBits] |= bits << offset;
+        }
+        size_ += count;
+    }
+
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        DropRankIndex();
+        Reset(size_ - 1);
+        --size_;
+        if (size_ % kWordBits == 0) {
+            words_.PopBack();
+        }
+    }
+
+    // Изменяет размер; новые биты получают значение value
+    void Resize(size_t new_size, bool value = false) {
+        const size_t old_size = size_;
+        words_.Resize(WordsFor(new_size));
+        DropRankIndex();
+        size_ = new_size;
+        if (new_size < old_size) {
+            ClearTail();
+        } else if (value) {
+            SetRange(old_size, new_size);
+        }
+    }
+
+    // Резервирует место под capacity битов
+    void Reserve(size_t capacity) {
+        words_.Reserve(WordsFor(capacity));
+    }
+
+    void Clear() noexcept {
+        DropRankIndex();
+        words_.Clear();
+        size_ = 0;
+    }
+
+    void swap(BitVector& other) noexcept {
+        words_.swap(other.words_);
+        rank_index_.swap(other.rank_index_);
+        std::swap(size_, other.size_);
+    }
+
+    // Побитовые операции с вектором того же размера
+    BitVector& operator&=(const BitVector& other) noexcept {
+        return Combine<BitOp::kAnd>(other);
+    }
+
+    BitVector& operator|=(const BitVector& other) noexcept {
+        return Combine<BitOp::kOr>(other);
+    }
+
+    BitVector& operator^=(const BitVector& other) noexcept {
+        return Combine<BitOp::kXor>(other);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Благодаря нулевым битам за пределами размера векторы сравниваются по словам
+    friend bool operator==(const BitVector& lhs, const BitVector& rhs) noexcept {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.words_.begin(), lhs.words_.end(), rhs.words_.begin());
+    }
+
+    friend bool operator!=(const BitVector& lhs, const BitVector& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Слов в суперблоке индекса Rank и Select
+    static constexpr size_t kSuperblockWords = 8;
+
+    static size_t WordsFor(size_t bits) noexcept {
+        return (bits + kWordBits - 1) / kWordBits;
+    }
+
+    static Word BitMask(size_t index) noexcept {
+        return Word{1} << (index % kWordBits);
+    }
+
+    // Маска битов слова, лежащих левее index (младших), для index % 64 != 0 - непустая
+    static Word LowMask(size_t index) noexcept {
+        return BitMask(index) - 1;
+    }
+
+    void DropRankIndex() noexcept {
+        rank_index_.Clear();
+    }
+
+    // Обнуляет биты последнего слова за пределами размера
+    void ClearTail() noexcept {
+        if (size_ % kWordBits != 0) {
+            words_[words_.GetSize() - 1] &= LowMask(size_);
+        }
+    }
+
+    // Вызывает op(word, mask) для каждого слова, задетого диапазоном [first, last)
+    template <typename Op>
+    void ForEachWordMask(size_t first, size_t last, Op op) noexcept {
+        assert(first <= last && last <= size_);
+        if (first == last) {
+            return;
+        }
+        DropRankIndex();
+        const size_t first_word = first / kWordBits;
+        const size_t last_word = (last - 1) / kWordBits;
+        const Word first_mask = ~LowMask(first);
+        const Word last_mask = last % kWordBits == 0 ? ~Word{0} : LowMask(last);
+        if (first_word == last_word) {
+            op(words_[first_word], first_mask & last_mask);
+            return;
+        }
+        op(words_[first_word], first_mask);
+        for (size_t i = first_word + 1; i < last_word; ++i) {
+            op(words_[i], ~Word{0});
+        }
+        op(words_[last_word], last_mask);
+    }
+
+    template <BitOp kOp>
+    BitVector& Combine(const BitVector& other) noexcept {
+        assert((size_ == other.size_) && "Error: Sizes differ!");
+        DropRankIndex();
+        SimdBitwiseWords<kOp>(words_.begin(), other.words_.begin(), words_.GetSize());
+        return *this;
+    }
+
+    SimpleVector<Word> words_;
+    // Число установленных битов перед каждым суперблоком и общее число в конце; пуст, если индекс не построен
+    SimpleVector<size_t> rank_index_;
+    size_t size_ = 0;
+};
+
+inline BitVector operator&(BitVector lhs, const BitVector& rhs) noexcept {
+    lhs &= rhs;
+    return lhs;
+}
+
+inline BitVector operator|(BitVector lhs, const BitVector& rhs) noexcept {
+    lhs |= rhs;
+    return lhs;
+}
+
+inline BitVector operator^(BitVector lhs, const BitVector& rhs) noexcept {
+    lhs ^= rhs;
+    return lhs;
+}
+
+inline void swap(BitVector& lhs, BitVector& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "simd_kernels.h"
+#include "simple_vector.h"
+
+// Сжатый вектор 64-битных целых без знака. Значения хранятся блоками по kBlockSize:
+// каждый блок упакован по kBitStreams чередующимся потокам битов (см. simd_kernels.h)
+// одним из двух способов, который даёт меньшую ширину:
+//     kFrameOfReference - значение = base + упакованный остаток (base - минимум блока);
+//     kDelta            - значение = предыдущее + step + упакованный остаток (step - наименьшая разность),
+//                         подходит для отсортированных идентификаторов.
+// Заголовок блока хранит способ, ширину и смещение упакованных слов, поэтому доступ по индексу
+// не зависит от размера вектора: для kFrameOfReference это одно-два слова, для kDelta - распаковка
+// и сумма не более kBlockSize разностей. Добавленные в конец значения копятся несжатыми, пока не наберётся блок
+class CompressedIntVector {
+public:
+    using value_type = uint64_t;
+
+    static constexpr size_t kBlockSize = 128;
+
+    enum class Encoding : uint8_t {
+        kFrameOfReference,
+        kDelta,
+    };
+
+    CompressedIntVector() noexcept = default;
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIterator<InputIt>::value>>
+    CompressedIntVector(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            PushBack(*first);
+        }
+    }
+
+    CompressedIntVector(std::initializer_list<uint64_t> init)
+        : CompressedIntVector(init.begin(), init.end())
+    {}
+
+    size_t GetSize() const noexcept {
+        return headers_.GetSize() * kBlockSize + tail_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Количество сжатых блоков (без несжатого хвоста)
+    size_t GetBlockCount() const noexcept {
+        return headers_.GetSize();
+    }
+
+    // Способ сжатия блока block
+    Encoding GetBlockEncoding(size_t block) const noexcept {
+        return headers_[block].encoding;
+    }
+
+    // Ширина упакованного остатка в блоке block, от 0 до 64 битов
+    unsigned GetBlockBits(size_t block) const noexcept {
+        return headers_[block].bits;
+    }
+
+    // Занимаемые данными байты: заголовки, упакованные слова и несжатый хвост
+    size_t GetCompressedBytes() const noexcept {
+        return headers_.GetSize() * sizeof(BlockHeader) + packed_.GetSize() * sizeof(uint64_t)
+            + tail_.GetSize() * sizeof(uint64_t);
+    }
+
+    uint64_t operator[](size_t index) const noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        const size_t block = index / kBlockSize;
+        if (block == headers_.GetSize()) {
+            return tail_[index % kBlockSize];
+        }
+        const BlockHeader& header = headers_[block];
+        const uint64_t* packed = packed_.begin() + header.offset;
+        const size_t position = index % kBlockSize;
+        if (header.encoding == Encoding::kFrameOfReference) {
+            return header.base + Extract(packed, position, header.bits);
+        }
+        // Разности до position распаковываются векторно целыми группами и складываются
+        const size_t count = (position / kBitStreams + 1) * kBitStreams;
+        uint64_t deltas[kBlockSize];
+        SimdUnpackBits(packed, count, header.bits, header.step, deltas);
+        uint64_t value = header.base;
+        for (size_t i = 1; i <= position; ++i) {
+            value += deltas[i];
+        }
+        return value;
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    uint64_t At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return (*this)[index];
+    }
+
+    // Добавляет значение в несжатый хвост; заполненный хвост сжимается в новый блок
+    void PushBack(uint64_t value) {
+        if (tail_.IsEmpty()) {
+            tail_.Reserve(kBlockSize);
+        }
+        tail_.PushBack(value);
+        if (tail_.GetSize() == kBlockSize) {
+            SealTail();
+        }
+    }
+
+    // Распаковывает все значения в out векторными ядрами
+    void DecodeTo(SimpleVector<uint64_t>& out) const {
+        out.ResizeForOverwrite(GetSize());
+        uint64_t* dest = out.begin();
+        for (const BlockHeader& header : headers_) {
+            const uint64_t* packed = packed_.begin() + header.offset;
+            if (header.encoding == Encoding::kFrameOfReference) {
+                SimdUnpackBits(packed, kBlockSize, header.bits, header.base, dest);
+            } else {
+                // Распаковываются разности step + остаток, затем значения восстанавливаются префиксной суммой
+                SimdUnpackBits(packed, kBlockSize, header.bits, header.step, dest);
+                uint64_t value = header.base;
+                dest[0] = value;
+                for (size_t i = 1; i < kBlockSize; ++i) {
+                    value += dest[i];
+                    dest[i] = value;
+                }
+            }
+            dest += kBlockSize;
+        }
+        std::copy(tail_.begin(), tail_.end(), dest);
+    }
+
+    SimpleVector<uint64_t> Decode() const {
+        SimpleVector<uint64_t> result;
+        DecodeTo(result);
+        return result;
+    }
+
+    void Clear() noexcept {
+        headers_.Clear();
+        packed_.Clear();
+        tail_.Clear();
+    }
+
+    void swap(CompressedIntVector& other) noexcept {
+        headers_.swap(other.headers_);
+        packed_.swap(other.packed_);
+        tail_.swap(other.tail_);
+    }
+
+private:
+    struct BlockHeader {
+        uint64_t base = 0;
+        uint64_t step = 0;
+        size_t offset = 0;
+        uint8_t bits = 0;
+        Encoding encoding = Encoding::kFrameOfReference;
+    };
+
+    // Количество битов, нужное для записи value
+    static unsigned BitWidth(uint64_t value) noexcept {
+        return value == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(value));
+    }
+
+    // Количество упакованных слов блока шириной bits
+    static size_t PackedWords(unsigned bits) noexcept {
+        constexpr size_t kPerStream = kBlockSize / kBitStreams;
+        return (kPerStream * bits + 63) / 64 * kBitStreams;
+    }
+
+    // Остаток с номером position из раскладки в kBitStreams потоков
+    static uint64_t Extract(const uint64_t* packed, size_t position, unsigned bits) noexcept {
+        if (bits == 0) {
+            return 0;
+        }
+        const size_t bit = position / kBitStreams * bits;
+        const unsigned shift = static_cast<unsigned>(bit % 64);
+        const uint64_t* word = packed + bit / 64 * kBitStreams + position % kBitStreams;
+        uint64_t value = word[0] >> shift;
+        if (shift + bits > 64) {
+            value |= word[kBitStreams] << (64 - shift);
+        }
+        return value & simd_detail::LowBitsMask(bits);
+    }
+
+    // Сжимает полный хвост в блок. Разности и остатки считаются по модулю 2^64,
+    // поэтому kDelta восстанавливает и неотсортированные значения, просто с большей шириной
+    void SealTail() {
+        const uint64_t* values = tail_.begin();
+        const auto [min, max] = std::minmax_element(values, values + kBlockSize);
+        uint64_t step = ~uint64_t{0};
+        for (size_t i = 1; i < kBlockSize; ++i) {
+            step = std::min(step, values[i] - values[i - 1]);
+        }
+        uint64_t max_residual = 0;
+        for (size_t i = 1; i < kBlockSize; ++i) {
+            max_residual = std::max(max_residual, values[i] - values[i - 1] - step);
+        }
+
+        BlockHeader header;
+        header.offset = packed_.GetSize();
+        const unsigned reference_bits = BitWidth(*max - *min);
+        const unsigned delta_bits = BitWidth(max_residual);
+        if (delta_bits < reference_bits) {
+            header.encoding = Encoding::kDelta;
+            header.base = values[0];
+            header.step = step;
+            header.bits = static_cast<uint8_t>(delta_bits);
+        } else {
+            header.base = *min;
+            header.bits = static_cast<uint8_t>(reference_bits);
+        }
+
+        packed_.Resize(header.offset + PackedWords(header.bits));
+        uint64_t* packed = packed_.begin() + header.offset;
+        for (size_t i = 0; i < kBlockSize; ++i) {
+            const uint64_t residual = header.encoding == Encoding::kFrameOfReference
+                ? values[i] - header.base
+                : (i == 0 ? 0 : values[i] - values[i - 1] - step);
+            Pack(packed, i, header.bits, residual);
+        }
+        headers_.PushBack(header);
+        tail_.Clear();
+    }
+
+    static void Pack(uint64_t* packed, size_t position, unsigned bits, uint64_t residual) noexcept {
+        if (bits == 0) {
+            return;
+        }
+        const size_t bit = position / kBitStreams * bits;
+        const unsigned shift = static_cast<unsigned>(bit % 64);
+        uint64_t* word = packed + bit / 64 * kBitStreams + position % kBitStreams;
+        word[0] |= residual << shift;
+        if (shift + bits > 64) {
+            word[kBitStreams] |= residual >> (64 - shift);
+        }
+    }
+
+    SimpleVector<BlockHeader> headers_;
+    SimpleVector<uint64_t> packed_;
+    SimpleVector<uint64_t> tail_;
+};
+
+inline void swap(CompressedIntVector& lhs, CompressedIntVector& rhs) noexcept {
+    lhs.swap(rhs);
+}
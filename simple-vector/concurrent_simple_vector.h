@@ -0,0 +1,353 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "segment_layout.h"
+#include "simple_vector.h"
+
+// Вектор только для добавления, в который несколько потоков пишут без блокировок.
+// Элементы хранятся в сегментах: первый вмещает 32 элемента, каждый следующий - вдвое больше
+// предыдущего. Сегменты не перевыделяются, поэтому элементы никогда не переносятся,
+// а ссылки на них действительны до Clear или разрушения вектора.
+// PushBack выделяет сегмент под очередной слот, резервирует слот атомарным CAS,
+// конструирует в нём элемент и публикует его.
+// GetSize возвращает длину опубликованного префикса: элементы [0, GetSize()) полностью построены,
+// и их можно читать (operator[], итераторы) одновременно с добавлением новых.
+// Аллокатор Alloc вызывается из разных потоков и должен это допускать.
+// Clear и разрушение вектора нельзя выполнять одновременно с другими вызовами
+template <typename Type, typename Alloc = DefaultAllocator<Type>>
+class ConcurrentSimpleVector {
+    static_assert(std::is_nothrow_move_constructible_v<Type>,
+                  "ConcurrentSimpleVector builds elements before reserving a slot and moves them in");
+
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    using Layout = SegmentLayout<5>;
+    static constexpr size_t kSegmentCount = Layout::kCount;
+
+    // Сегмент: элементы и флаги их готовности
+    struct Segment {
+        Type* items = nullptr;
+        std::unique_ptr<std::atomic<bool>[]> ready;
+    };
+
+    template <typename ValueType>
+    class BasicIterator;
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+    using value_type = Type;
+    using allocator_type = Alloc;
+
+    // Создаёт пустой вектор, не выделяя память
+    ConcurrentSimpleVector() noexcept(std::is_nothrow_default_constructible_v<Alloc>) = default;
+
+    explicit ConcurrentSimpleVector(const Alloc& alloc) noexcept
+        : alloc_(alloc)
+    {}
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        DestroyItems();
+        for (size_t segment = 0; segment < kSegmentCount; ++segment) {
+            FreeSegment(segment);
+        }
+    }
+
+    // Возвращает количество опубликованных элементов
+    size_t GetSize() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    // Сообщает, нет ли опубликованных элементов
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Добавляет элемент в конец вектора. Возвращает индекс добавленного элемента
+    size_t PushBack(const Type& item) {
+        return EmplaceBack(item);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Добавляет элемент в конец вектора. Возвращает индекс добавленного элемента
+    size_t PushBack(Type&& item) {
+        return EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args. Возвращает индекс созданного элемента.
+    // Если конструктор может бросить исключение, элемент строится до резервирования слота,
+    // поэтому исключение не оставляет в векторе пропусков.
+    // Сегмент под слот выделяется до того, как слот занят: если выделение бросит std::bad_alloc,
+    // ни один индекс не зарезервирован, и опубликованный префикс продолжает расти
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<Type, Args...>) {
+            size_t index = reserved_.load(std::memory_order_relaxed);
+            do {
+                EnsureSegment(Layout::SegmentOf(index));
+                // При неудаче index получает текущее значение, и сегмент проверяется для него
+            } while (!reserved_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+            Type* slot = &ItemAt(index);
+            AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+            Publish(index);
+            return index;
+        } else {
+            Type item(std::forward<Args>(args)...);
+            return EmplaceBack(std::move(item));
+        }
+    }
+
+    // Заранее выделяет сегменты под capacity элементов, чтобы добавление не выделяло память.
+    // Можно вызывать одновременно с добавлением
+    void Reserve(size_t capacity) {
+        for (size_t segment = 0; segment < Layout::SegmentsFor(capacity); ++segment) {
+            EnsureSegment(segment);
+        }
+    }
+
+    // Возвращает ссылку на опубликованный элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return ItemAt(index);
+    }
+
+    // Возвращает константную ссылку на опубликованный элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return ItemAt(index);
+    }
+
+    // Возвращает ссылку на опубликованный элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если элемент ещё не опубликован
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return ItemAt(index);
+    }
+
+    // Возвращает константную ссылку на опубликованный элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если элемент ещё не опубликован
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return ItemAt(index);
+    }
+
+    // Итераторы проходят элементы, опубликованные к моменту вызова end()
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Копирует опубликованные элементы в обычный вектор
+    SimpleVector<Type> ToSimpleVector() const {
+        const size_t size = GetSize();
+        SimpleVector<Type> result(::Reserve(size));
+        for (ConstIterator it = begin(), last(this, size); it != last; ++it) {
+            result.PushBack(*it);
+        }
+        return result;
+    }
+
+    // Разрушает все элементы, сохраняя выделенные сегменты.
+    // Нельзя вызывать одновременно с другими методами
+    void Clear() noexcept {
+        DestroyItems();
+        reserved_.store(0, std::memory_order_relaxed);
+        published_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Итератор по элементам: внутри сегмента продвигается указателем,
+    // к следующему сегменту переходит по таблице сегментов
+    template <typename ValueType>
+    class BasicIterator {
+        using Owner = std::conditional_t<std::is_const_v<ValueType>,
+                                         const ConcurrentSimpleVector, ConcurrentSimpleVector>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {}
+
+        // Неконстантный итератор приводится к константному
+        template <typename Other, typename = std::enable_if_t<std::is_const_v<ValueType> && !std::is_const_v<Other>>>
+        BasicIterator(const BasicIterator<Other>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return *Current();
+        }
+
+        pointer operator->() const noexcept {
+            return Current();
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            if (item_ != nullptr && index_ < segment_end_) {
+                ++item_;
+            } else {
+                item_ = nullptr;
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template <typename>
+        friend class BasicIterator;
+
+        pointer Current() const noexcept {
+            if (item_ == nullptr) {
+                const size_t segment = Layout::SegmentOf(index_);
+                item_ = &owner_->ItemAt(index_);
+                segment_end_ = Layout::SegmentBegin(segment + 1);
+            }
+            return item_;
+        }
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+        mutable pointer item_ = nullptr;
+        mutable size_t segment_end_ = 0;
+    };
+
+    // Возвращает опубликованный сегмент, выделяя его, если его ещё нет.
+    // Потоки, одновременно выделившие один сегмент, решают гонку через CAS, проигравший освобождает свой
+    Segment* EnsureSegment(size_t segment) {
+        Segment* current = segments_[segment].load(std::memory_order_acquire);
+        if (current != nullptr) {
+            return current;
+        }
+        const size_t size = Layout::SegmentSize(segment);
+        auto fresh = std::make_unique<Segment>();
+        fresh->ready = std::make_unique<std::atomic<bool>[]>(size);
+        fresh->items = AllocTraits::allocate(alloc_, size);
+        if (segments_[segment].compare_exchange_strong(current, fresh.get(), std::memory_order_acq_rel,
+                                                      std::memory_order_acquire)) {
+            return fresh.release();
+        }
+        AllocTraits::deallocate(alloc_, fresh->items, size);
+        return current;
+    }
+
+    Type& ItemAt(size_t index) const noexcept {
+        const size_t segment = Layout::SegmentOf(index);
+        return segments_[segment].load(std::memory_order_acquire)->items[index - Layout::SegmentBegin(segment)];
+    }
+
+    std::atomic<bool>& ReadyFlag(size_t index) const noexcept {
+        const size_t segment = Layout::SegmentOf(index);
+        return segments_[segment].load(std::memory_order_acquire)->ready[index - Layout::SegmentBegin(segment)];
+    }
+
+    // Отмечает элемент index готовым и продвигает опубликованный префикс
+    // через все подряд готовые элементы. Продвигать префикс помогает любой писатель,
+    // поэтому ни один поток не ждёт другой.
+    // Флаг и счётчик используют последовательную согласованность: писатель, застрявший перед
+    // ещё не готовым соседом, и сосед, опубликовавший свой элемент, не могут оба увидеть старые значения
+    void Publish(size_t index) noexcept {
+        ReadyFlag(index).store(true);
+        size_t published = published_.load();
+        while (segments_[Layout::SegmentOf(published)].load(std::memory_order_acquire) != nullptr
+               && ReadyFlag(published).load()) {
+            // При неудаче published получает текущее значение, и обход продолжается с него
+            if (published_.compare_exchange_weak(published, published + 1)) {
+                ++published;
+            }
+        }
+    }
+
+    // Разрушает построенные элементы и сбрасывает флаги готовности
+    void DestroyItems() noexcept {
+        const size_t reserved = reserved_.load(std::memory_order_acquire);
+        for (size_t index = 0; index < reserved; ++index) {
+            Segment* segment = segments_[Layout::SegmentOf(index)].load(std::memory_order_acquire);
+            if (segment == nullptr) {
+                index = Layout::SegmentBegin(Layout::SegmentOf(index) + 1) - 1;
+                continue;
+            }
+            std::atomic<bool>& ready = ReadyFlag(index);
+            if (ready.load(std::memory_order_acquire)) {
+                AllocTraits::destroy(alloc_, &ItemAt(index));
+                ready.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void FreeSegment(size_t segment) noexcept {
+        Segment* current = segments_[segment].exchange(nullptr, std::memory_order_acq_rel);
+        if (current != nullptr) {
+            AllocTraits::deallocate(alloc_, current->items, Layout::SegmentSize(segment));
+            delete current;
+        }
+    }
+
+    Alloc alloc_;
+    std::atomic<Segment*> segments_[kSegmentCount] = {};
+    std::atomic<size_t> reserved_{0};
+    std::atomic<size_t> published_{0};
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+// Вычисление контейнеров при компиляции.
+// SimpleVector выделяет память, поэтому пригоден в constexpr только начиная с C++20 (выделение
+// памяти при компиляции и std::construct_at): там его методы объявлены через SIMPLE_VECTOR_CONSTEXPR,
+// а векторные ядра, memcpy и realloc при компиляции заменяются поэлементными операциями.
+// В C++17 SIMPLE_VECTOR_CONSTEXPR пуст, и код вектора не меняется
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 1
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#else
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 0
+#define SIMPLE_VECTOR_CONSTEXPR
+#endif
+
+// Сообщает, вычисляется ли вызов при компиляции. Быстрые пути (векторные ядра, memcpy)
+// проверяют его и при компиляции уступают место простым циклам
+constexpr bool IsConstantEvaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#elif defined(__GNUC__)
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,646 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_support.h"
+#include "simd_kernels.h"
+#include "simple_vector.h"
+
+namespace fixed_vector_detail {
+
+// Хранилище FixedVector. Для тривиальных типов это обычный массив Type[N]: его элементы
+// всегда живы, создание сводится к присваиванию, а разрушение - к уменьшению размера,
+// поэтому такой вектор вычисляется при компиляции уже в C++17 и копируется побайтово.
+// Константные выражения не допускают неинициализированных значений, поэтому при компиляции массив
+// обнуляется. C++17 требует этого и во время выполнения; начиная с C++20 конструктор обнуляет
+// массив только при вычислении при компиляции, а во время выполнения оставляет его неинициализированным
+template <typename Type, size_t N, bool = std::is_trivial_v<Type>>
+class Storage {
+public:
+#if __cpp_constexpr >= 201907L
+    constexpr Storage() noexcept {
+        if (IsConstantEvaluated()) {
+            for (Type& item : items_) {
+                item = Type();
+            }
+        }
+    }
+#endif
+
+    constexpr Type* Data() noexcept {
+        return items_;
+    }
+
+    constexpr const Type* Data() const noexcept {
+        return items_;
+    }
+
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    constexpr void SetSize(size_t size) noexcept {
+        size_ = size;
+    }
+
+    // Создаёт элемент в свободной ячейке slot
+    template <typename... Args>
+    constexpr void Construct(Type* slot, Args&&... args) {
+        if constexpr (std::is_constructible_v<Type, Args...>) {
+            *slot = Type(std::forward<Args>(args)...);
+        } else {
+            *slot = Type{std::forward<Args>(args)...};
+        }
+    }
+
+    constexpr void Destroy(Type*, Type*) noexcept {}
+
+    // Создаёт count элементов в конце вызовами make(slot). Размер меняется только после
+    // успешного создания всех элементов: ячейки за концом вектора ни на что не влияют
+    template <typename Make>
+    constexpr void AppendN(size_t count, Make make) {
+        for (size_t i = 0; i < count; ++i) {
+            make(items_ + size_ + i);
+        }
+        size_ += count;
+    }
+
+private:
+#if __cpp_constexpr >= 201907L
+    Type items_[N];
+#else
+    Type items_[N] = {};
+#endif
+    size_t size_ = 0;
+};
+
+// Хранилище для нетривиальных типов: сырая память, в которой элементы создаются placement new,
+// как во внутреннем буфере SmallSimpleVector. Такой вектор используется только во время выполнения
+template <typename Type, size_t N>
+class Storage<Type, N, false> {
+public:
+    Storage() noexcept = default;
+
+    Storage(const Storage& other) {
+        AppendN(other.size_, [&, source = other.Data()](Type* slot) mutable { Construct(slot, *source++); });
+    }
+
+    Storage(Storage&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        AppendN(other.size_, [&, source = other.Data()](Type* slot) mutable { Construct(slot, std::move(*source++)); });
+    }
+
+    Storage& operator=(const Storage& rhs) {
+        if (this != &rhs) {
+            Assign(rhs.Data(), rhs.size_);
+        }
+        return *this;
+    }
+
+    Storage& operator=(Storage&& rhs) noexcept(std::is_nothrow_move_assignable_v<Type>
+                                               && std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Assign(std::make_move_iterator(rhs.Data()), rhs.size_);
+        }
+        return *this;
+    }
+
+    ~Storage() {
+        Destroy(Data(), Data() + size_);
+    }
+
+    Type* Data() noexcept {
+        return reinterpret_cast<Type*>(raw_);
+    }
+
+    const Type* Data() const noexcept {
+        return reinterpret_cast<const Type*>(raw_);
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    void SetSize(size_t size) noexcept {
+        size_ = size;
+    }
+
+    template <typename... Args>
+    void Construct(Type* slot, Args&&... args) {
+        ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+    }
+
+    void Destroy(Type* first, Type* last) noexcept {
+        std::destroy(first, last);
+    }
+
+    // Создаёт count элементов в конце вызовами make(slot).
+    // Если создание бросает исключение, уже созданные элементы разрушаются, а размер не меняется
+    template <typename Make>
+    void AppendN(size_t count, Make make) {
+        Type* first = Data() + size_;
+        size_t index = 0;
+        try {
+            for (; index < count; ++index) {
+                make(first + index);
+            }
+        }
+        catch (...) {
+            Destroy(first, first + index);
+            throw;
+        }
+        size_ += count;
+    }
+
+private:
+    // Присваивает count элементов, начиная с source: общая часть присваивается,
+    // недостающие элементы создаются, лишние разрушаются
+    template <typename InputIt>
+    void Assign(InputIt source, size_t count) {
+        const size_t common = std::min(size_, count);
+        for (size_t i = 0; i < common; ++i, ++source) {
+            Data()[i] = *source;
+        }
+        if (count < size_) {
+            Destroy(Data() + count, Data() + size_);
+            size_ = count;
+        } else {
+            AppendN(count - common, [&](Type* slot) { Construct(slot, *source++); });
+        }
+    }
+
+    alignas(Type) unsigned char raw_[N * sizeof(Type)];
+    size_t size_ = 0;
+};
+
+}  // namespace fixed_vector_detail
+
+// Вектор фиксированной ёмкости N без обращений к куче: элементы хранятся прямо в объекте.
+// Интерфейс совпадает с SimpleVector, но при попытке превысить ёмкость бросается std::length_error.
+// Раз буфер не переезжает, итераторы остаются действительными при любых вставках.
+// Для тривиальных типов (int, double, POD-структуры) все методы constexpr уже в C++17,
+// поэтому вектор подходит и для таблиц, построенных при компиляции, и для горячих путей без выделений памяти.
+// Перемещённый вектор сохраняет размер, а его элементы - перемещённые значения
+template <typename Type, size_t N>
+class FixedVector {
+    static_assert(N > 0, "Capacity must be positive");
+
+    using Storage = fixed_vector_detail::Storage<Type, N>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using value_type = Type;
+
+    // Ёмкость вектора
+    static constexpr size_t kCapacity = N;
+
+    // Создаёт пустой вектор
+    constexpr FixedVector() noexcept = default;
+
+    // Создаёт пустой вектор. Ёмкость фиксирована, поэтому лишь проверяется, что она достаточна
+    constexpr FixedVector(ReserveProxyObj obj) {
+        Reserve(obj.GetValue());
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value (или по умолчанию)
+    constexpr FixedVector(size_t size, const Type& value = Type()) {
+        Insert(cend(), size, value);
+    }
+
+    // Создаёт вектор из std::initializer_list
+    constexpr FixedVector(std::initializer_list<Type> init) {
+        Insert(cend(), init.begin(), init.end());
+    }
+
+    // Создаёт вектор из элементов диапазона [first, last)
+    template <typename InputIt, std::enable_if_t<IsInputIterator<InputIt>::value, int> = 0>
+    constexpr FixedVector(InputIt first, InputIt last) {
+        Insert(cend(), first, last);
+    }
+
+    // Возвращает количество элементов в массиве
+    constexpr std::size_t GetSize() const noexcept {
+        return storage_.GetSize();
+    }
+
+    // Возвращает вместимость массива (всегда N)
+    constexpr std::size_t GetCapacity() const noexcept {
+        return N;
+    }
+
+    // Сообщает, пустой ли массив
+    constexpr bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Сообщает, заполнена ли вся ёмкость
+    constexpr bool IsFull() const noexcept {
+        return GetSize() == N;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    constexpr Type& operator[](std::size_t index) noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return storage_.Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    constexpr const Type& operator[](std::size_t index) const noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return storage_.Data()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr Type& At(std::size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return storage_.Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr const Type& At(std::size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return storage_.Data()[index];
+    }
+
+    // Разрушает все элементы и обнуляет размер массива
+    constexpr void Clear() noexcept {
+        Truncate(0);
+    }
+
+    // Возвращает итератор на начало массива
+    constexpr Iterator begin() noexcept {
+        return storage_.Data();
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    constexpr Iterator end() noexcept {
+        return storage_.Data() + GetSize();
+    }
+
+    // Возвращает константный итератор на начало массива
+    constexpr ConstIterator begin() const noexcept {
+        return storage_.Data();
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    constexpr ConstIterator end() const noexcept {
+        return storage_.Data() + GetSize();
+    }
+
+    // Возвращает константный итератор на начало массива
+    constexpr ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    constexpr ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    constexpr void Resize(size_t new_size) {
+        if (new_size <= GetSize()) {
+            Truncate(new_size);
+            return;
+        }
+        CheckRoom(new_size - GetSize());
+        storage_.AppendN(new_size - GetSize(), [&](Type* slot) { storage_.Construct(slot); });
+    }
+
+    // Изменяет размер массива, не инициализируя новые элементы значением.
+    // Новые элементы тривиальных типов сохраняют прежнее содержимое ячеек и должны быть сразу перезаписаны
+    constexpr void ResizeForOverwrite(size_t new_size) {
+        if constexpr (std::is_trivial_v<Type>) {
+            if (new_size > GetSize()) {
+                CheckRoom(new_size - GetSize());
+                storage_.SetSize(new_size);
+                return;
+            }
+        }
+        Resize(new_size);
+    }
+
+    // Добавляет элемент в конец вектора
+    // Выбрасывает исключение std::length_error, если вектор заполнен
+    constexpr void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Добавляет элемент в конец вектора
+    constexpr void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    constexpr Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    constexpr Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Вставляет count копий value в позицию pos.
+    // Возвращает итератор на первое вставленное значение (или pos, если count == 0).
+    // value может быть элементом самого вектора: буфер не переезжает, а копии создаются до сдвига
+    constexpr Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        CheckRoom(count);
+        storage_.AppendN(count, [&](Type* slot) { storage_.Construct(slot, value); });
+        return MoveTailTo(index, count);
+    }
+
+    // Вставляет элементы диапазона [first, last) в позицию pos.
+    // Возвращает итератор на первое вставленное значение (или pos, если диапазон пуст).
+    // Элементы создаются в конце и поворотом встают на место, поэтому диапазон может быть частью самого вектора
+    template <typename InputIt, std::enable_if_t<IsInputIterator<InputIt>::value, int> = 0>
+    constexpr Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            // Длина диапазона заранее неизвестна: собираем его во временный вектор,
+            // чтобы при переполнении этот вектор остался нетронутым
+            FixedVector tmp;
+            for (; first != last; ++first) {
+                tmp.EmplaceBack(*first);
+            }
+            return Insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+        } else {
+            const size_t index = static_cast<size_t>(pos - cbegin());
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            CheckRoom(count);
+            storage_.AppendN(count, [&](Type* slot) {
+                storage_.Construct(slot, *first);
+                ++first;
+            });
+            return MoveTailTo(index, count);
+        }
+    }
+
+    // Вставляет элементы списка init в позицию pos
+    constexpr Iterator Insert(ConstIterator pos, std::initializer_list<Type> init) {
+        return Insert(pos, init.begin(), init.end());
+    }
+
+    // Добавляет элементы диапазона [first, last) в конец вектора
+    template <typename InputIt, std::enable_if_t<IsInputIterator<InputIt>::value, int> = 0>
+    constexpr void Append(InputIt first, InputIt last) {
+        Insert(cend(), first, last);
+    }
+
+    // Добавляет элементы контейнера range в конец вектора.
+    // Элементы временного контейнера перемещаются, а не копируются
+    template <typename Range>
+    constexpr void Append(Range&& range) {
+        if constexpr (std::is_lvalue_reference_v<Range>) {
+            Insert(cend(), std::begin(range), std::end(range));
+        } else {
+            Insert(cend(), std::make_move_iterator(std::begin(range)), std::make_move_iterator(std::end(range)));
+        }
+    }
+
+    // Добавляет элементы списка init в конец вектора
+    constexpr void Append(std::initializer_list<Type> init) {
+        Insert(cend(), init.begin(), init.end());
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    constexpr Type& EmplaceBack(Args&&... args) {
+        CheckRoom(1);
+        storage_.AppendN(1, [&](Type* slot) { storage_.Construct(slot, std::forward<Args>(args)...); });
+        return *(end() - 1);
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    constexpr Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        EmplaceBack(std::forward<Args>(args)...);
+        return MoveTailTo(index, 1);
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    constexpr void PopBack() noexcept {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        Truncate(GetSize() - 1);
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    // Возвращает итератор на, следующий после удалённого, элемент
+    constexpr Iterator Erase(ConstIterator pos) {
+        assert( (pos >= begin() && pos < end()) && "Error: Out of range!" );
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост вектора один раз
+    // Возвращает итератор на элемент, следующий за удалёнными
+    constexpr Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert( (first >= begin() && first <= last && last <= end()) && "Error: Out of range!" );
+        Iterator it_first = begin() + (first - cbegin());
+        Iterator it_last = begin() + (last - cbegin());
+        if (it_first == it_last) {
+            return it_first;
+        }
+        Iterator dest = it_first;
+        for (Iterator source = it_last; source != end(); ++source, ++dest) {
+            *dest = std::move(*source);
+        }
+        Truncate(static_cast<size_t>(dest - begin()));
+        return it_first;
+    }
+
+    // Удаляет все элементы, для которых pred возвращает true, за один проход.
+    // Порядок оставшихся элементов сохраняется. Возвращает количество удалённых элементов
+    template <typename Predicate>
+    constexpr size_t EraseIf(Predicate pred) {
+        Iterator dest = begin();
+        for (Iterator source = begin(); source != end(); ++source) {
+            if (!pred(*source)) {
+                if (dest != source) {
+                    *dest = std::move(*source);
+                }
+                ++dest;
+            }
+        }
+        const size_t count = static_cast<size_t>(end() - dest);
+        Truncate(static_cast<size_t>(dest - begin()));
+        return count;
+    }
+
+    // Удаляет элемент в позиции pos за O(1), перенося на его место последний элемент.
+    // Порядок элементов не сохраняется. Возвращает итератор на элемент, занявший место удалённого
+    // (или end(), если удалён последний элемент)
+    constexpr Iterator SwapErase(ConstIterator pos) {
+        assert( (pos >= begin() && pos < end()) && "Error: Out of range!" );
+        Iterator it_pos = begin() + (pos - cbegin());
+        if (it_pos != end() - 1) {
+            *it_pos = std::move(*(end() - 1));
+        }
+        PopBack();
+        return it_pos;
+    }
+
+    // Обменивает значение с другим вектором. Элементы обмениваются поштучно: буферы не переносимы
+    constexpr void swap(FixedVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>
+                                                     && std::is_nothrow_move_assignable_v<Type>) {
+        if (this == &other) {
+            return;
+        }
+        FixedVector& longer = GetSize() >= other.GetSize() ? *this : other;
+        FixedVector& shorter = GetSize() >= other.GetSize() ? other : *this;
+        const size_t common = shorter.GetSize();
+        for (size_t i = 0; i < common; ++i) {
+            SwapItems(longer[i], shorter[i]);
+        }
+        shorter.Insert(shorter.cend(), std::make_move_iterator(longer.begin() + common),
+                       std::make_move_iterator(longer.end()));
+        longer.Truncate(common);
+    }
+
+    // Проверяет, что new_capacity элементов помещаются в вектор.
+    // Выбрасывает исключение std::length_error, если new_capacity > N
+    constexpr void Reserve(size_t new_capacity) const {
+        if (new_capacity > N) {
+            throw std::length_error("Error: Vector is too long!");
+        }
+    }
+
+    // Ёмкость фиксирована, поэтому ничего не делает
+    constexpr void ShrinkToFit() noexcept {}
+
+private:
+    // Проверяет, что в вектор помещаются ещё count элементов
+    constexpr void CheckRoom(size_t count) const {
+        if (count > N - GetSize()) {
+            throw std::length_error("Error: Vector is too long!");
+        }
+    }
+
+    // Разрушает элементы, начиная с индекса new_size
+    constexpr void Truncate(size_t new_size) noexcept {
+        storage_.Destroy(begin() + new_size, end());
+        storage_.SetSize(new_size);
+    }
+
+    // Переставляет count элементов, только что созданных в конце, в позицию index.
+    // Возвращает итератор на первый из них
+    constexpr Iterator MoveTailTo(size_t index, size_t count) {
+        Iterator it_pos = begin() + index;
+        Iterator middle = end() - count;
+        if (it_pos == middle) {
+            return it_pos;
+        }
+        if (!IsConstantEvaluated()) {
+            std::rotate(it_pos, middle, end());
+            return it_pos;
+        }
+        // std::rotate вычисляется при компиляции только с C++20, поэтому здесь поворот тремя разворотами
+        Reverse(it_pos, middle);
+        Reverse(middle, end());
+        Reverse(it_pos, end());
+        return it_pos;
+    }
+
+    static constexpr void Reverse(Iterator first, Iterator last) {
+        while (first != last && first != --last) {
+            SwapItems(*first++, *last);
+        }
+    }
+
+    static constexpr void SwapItems(Type& lhs, Type& rhs) {
+        Type tmp(std::move(lhs));
+        lhs = std::move(rhs);
+        rhs = std::move(tmp);
+    }
+
+    Storage storage_;
+};
+
+template <typename Type, size_t N>
+constexpr void swap(FixedVector<Type, N>& lhs, FixedVector<Type, N>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <typename Type, size_t N>
+constexpr bool operator==(const FixedVector<Type, N>& lhs, const FixedVector<Type, N>& rhs) {
+    if constexpr (kHasSimdKernels<Type>) {
+        if (!IsConstantEvaluated()) {
+            return SimdEqual(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+        }
+    }
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.GetSize(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Type, size_t N>
+constexpr bool operator!=(const FixedVector<Type, N>& lhs, const FixedVector<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+constexpr bool operator<(const FixedVector<Type, N>& lhs, const FixedVector<Type, N>& rhs) {
+    if constexpr (kHasSimdKernels<Type>) {
+        if (!IsConstantEvaluated()) {
+            return SimdLexicographicalLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+        }
+    }
+    const size_t common = std::min(lhs.GetSize(), rhs.GetSize());
+    for (size_t i = 0; i < common; ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return lhs.GetSize() < rhs.GetSize();
+}
+
+template <typename Type, size_t N>
+constexpr bool operator<=(const FixedVector<Type, N>& lhs, const FixedVector<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+constexpr bool operator>(const FixedVector<Type, N>& lhs, const FixedVector<Type, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+constexpr bool operator>=(const FixedVector<Type, N>& lhs, const FixedVector<Type, N>& rhs) {
+    return !(lhs < rhs);
+}
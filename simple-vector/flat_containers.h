@@ -0,0 +1,747 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Возвращает индекс первого элемента отсортированного массива [first, first + size), не меньшего key.
+// Двоичный поиск без ветвлений: на каждом шаге граница сдвигается условной пересылкой (cmov),
+// поэтому нет ошибок предсказания переходов, а число шагов зависит только от size
+template <typename Key, typename Compare>
+size_t BranchlessLowerBound(const Key* first, size_t size, const Key& key, const Compare& comp) {
+    if (size == 0) {
+        return 0;
+    }
+    const Key* base = first;
+    while (size > 1) {
+        const size_t half = size / 2;
+        // Обе возможные точки следующего шага загружаются заранее, не дожидаясь сравнения
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+        base = comp(base[half], key) ? base + half : base;
+        size -= half;
+    }
+    return static_cast<size_t>(base - first) + (comp(*base, key) ? 1 : 0);
+}
+
+// Копия отсортированных ключей в порядке Эйтцингера (обход двоичного дерева поиска в ширину).
+// Первые уровни дерева, через которые проходит каждый поиск, лежат в начале массива и не покидают кеш,
+// а потомки узла k лежат рядом (2k и 2k + 1), поэтому их можно загрузить заранее.
+// Занимает память под копию ключей и индексы; имеет смысл для больших таблиц, которые редко меняются
+template <typename Key, typename Compare>
+class EytzingerIndex {
+public:
+    // Строит индекс по отсортированному массиву [sorted, sorted + size)
+    void Build(const Key* sorted, size_t size) {
+        SimpleVector<size_t> ranks(size + 1);
+        // Симметричный обход дерева 1..size выдаёт узлы в порядке возрастания ключей
+        size_t rank = 0;
+        size_t node = 1;
+        SimpleVector<size_t> stack;
+        while (node <= size || !stack.IsEmpty()) {
+            for (; node <= size; node *= 2) {
+                stack.PushBack(node);
+            }
+            node = stack[stack.GetSize() - 1];
+            stack.PopBack();
+            ranks[node] = rank++;
+            node = node * 2 + 1;
+        }
+        SimpleVector<Key> tree(::Reserve(size));
+        for (size_t k = 1; k <= size; ++k) {
+            tree.PushBack(sorted[ranks[k]]);
+        }
+        tree_ = std::move(tree);
+        ranks_ = std::move(ranks);
+    }
+
+    // Удаляет индекс
+    void Clear() noexcept {
+        tree_ = SimpleVector<Key>();
+        ranks_ = SimpleVector<size_t>();
+    }
+
+    // Сообщает, построен ли индекс
+    bool IsBuilt() const noexcept {
+        return !ranks_.IsEmpty();
+    }
+
+    // Возвращает индекс первого ключа исходного массива, не меньшего key
+    size_t LowerBound(const Key& key, const Compare& comp) const {
+        const size_t node = LowerBoundNode(key, comp);
+        return node == 0 ? tree_.GetSize() : ranks_[node];
+    }
+
+    // Сообщает, есть ли ключ key. Обращается только к дереву, без таблицы индексов
+    bool Contains(const Key& key, const Compare& comp) const {
+        const size_t node = LowerBoundNode(key, comp);
+        return node != 0 && !comp(key, tree_[node - 1]);
+    }
+
+private:
+    // Ключей в строке кеша: потомки узла k через столько уровней лежат в одной строке
+    static constexpr size_t kKeysPerLine = sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+
+    // Возвращает номер узла (с 1) первого ключа, не меньшего key, или 0, если ключ больше всех
+    size_t LowerBoundNode(const Key& key, const Compare& comp) const {
+        const size_t size = tree_.GetSize();
+        const Key* tree = tree_.begin();
+        size_t k = 1;
+        while (k <= size) {
+            // Потомки на несколько уровней ниже: к моменту обращения они уже будут в кеше
+            if (k * kKeysPerLine <= size) {
+                __builtin_prefetch(tree + k * kKeysPerLine - 1);
+            }
+            k = 2 * k + (comp(tree[k - 1], key) ? 1 : 0);
+        }
+        // Отбрасывает шаги вправо после последнего шага влево: остаётся искомый узел
+        return k >> __builtin_ffsll(static_cast<long long>(~k));
+    }
+
+    SimpleVector<Key> tree_;
+    SimpleVector<size_t> ranks_;
+};
+
+// Множество на отсортированном SimpleVector: ключи лежат подряд, поиск - двоичный без ветвлений.
+// Одиночная вставка и удаление - O(n); пакетная вставка (Insert(first, last)) дописывает ключи в конец,
+// сортирует только новую серию и один раз сливает её с имеющимися - O(n + m log m).
+// BuildSearchIndex строит индекс Эйтцингера для больших таблиц, которые в основном читаются;
+// любое изменение множества удаляет индекс
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+public:
+    using Iterator = const Key*;
+    using ConstIterator = const Key*;
+    using value_type = Key;
+    using key_compare = Compare;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp)
+        : comp_(comp)
+    {}
+
+    FlatSet(std::initializer_list<Key> init, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        Insert(init.begin(), init.end());
+    }
+
+    // Создаёт множество из ключей [first, last)
+    template <typename InputIt, typename = std::enable_if_t<IsInputIterator<InputIt>::value>>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        Insert(first, last);
+    }
+
+    // Возвращает количество ключей
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    // Сообщает, пустое ли множество
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Возвращает отсортированные ключи
+    const SimpleVector<Key>& Keys() const noexcept {
+        return keys_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return keys_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return keys_.begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return keys_.end();
+    }
+
+    // Возвращает итератор на первый ключ, не меньший key
+    ConstIterator LowerBound(const Key& key) const {
+        return begin() + LowerBoundIndex(key);
+    }
+
+    // Возвращает итератор на первый ключ, больший key
+    ConstIterator UpperBound(const Key& key) const {
+        return std::upper_bound(begin(), end(), key, comp_);
+    }
+
+    // Возвращает итератор на ключ, равный key, или end()
+    ConstIterator Find(const Key& key) const {
+        const ConstIterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    // Сообщает, есть ли ключ key в множестве
+    bool Contains(const Key& key) const {
+        if (index_.IsBuilt()) {
+            return index_.Contains(key, comp_);
+        }
+        return Find(key) != end();
+    }
+
+    // Возвращает количество ключей, равных key (0 или 1)
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Вставляет ключ key, если его ещё нет.
+    // Возвращает итератор на ключ и признак того, что вставка произошла
+    std::pair<ConstIterator, bool> Insert(const Key& key) {
+        return EmplaceKey(key);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Вставляет ключ key, если его ещё нет
+    std::pair<ConstIterator, bool> Insert(Key&& key) {
+        return EmplaceKey(std::move(key));
+    }
+
+    // Вставляет ключи [first, last) одним пакетом: новые ключи дописываются в конец,
+    // сортируются и сливаются с имеющимися за один проход. Из равных ключей остаётся
+    // уже имевшийся в множестве, а среди новых - первый
+    template <typename InputIt, typename = std::enable_if_t<IsInputIterator<InputIt>::value>>
+    void Insert(InputIt first, InputIt last) {
+        const size_t old_size = keys_.GetSize();
+        keys_.Append(first, last);
+        if (keys_.GetSize() == old_size) {
+            return;
+        }
+        index_.Clear();
+        const auto middle = keys_.begin() + old_size;
+        std::stable_sort(middle, keys_.end(), comp_);
+        const auto new_end = std::unique(middle, keys_.end(), Equivalent());
+        keys_.Erase(new_end, keys_.end());
+        std::inplace_merge(keys_.begin(), keys_.begin() + old_size, keys_.end(), comp_);
+        keys_.Erase(std::unique(keys_.begin(), keys_.end(), Equivalent()), keys_.end());
+    }
+
+    void Insert(std::initializer_list<Key> init) {
+        Insert(init.begin(), init.end());
+    }
+
+    // Удаляет ключ key. Возвращает количество удалённых ключей (0 или 1)
+    size_t Erase(const Key& key) {
+        const ConstIterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        Erase(it);
+        return 1;
+    }
+
+    // Удаляет ключ в позиции pos. Возвращает итератор на следующий ключ
+    ConstIterator Erase(ConstIterator pos) {
+        index_.Clear();
+        return keys_.Erase(pos);
+    }
+
+    // Удаляет все ключи, для которых pred возвращает true. Возвращает количество удалённых ключей
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        index_.Clear();
+        return keys_.EraseIf(pred);
+    }
+
+    // Резервирует место под capacity ключей
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+    }
+
+    // Удаляет все ключи
+    void Clear() noexcept {
+        index_.Clear();
+        keys_.Clear();
+    }
+
+    // Строит индекс Эйтцингера: поиск в большой таблице обращается к памяти предсказуемо.
+    // Индекс действует до следующего изменения множества
+    void BuildSearchIndex() {
+        index_.Build(keys_.begin(), keys_.GetSize());
+    }
+
+    // Сообщает, построен ли индекс Эйтцингера
+    bool HasSearchIndex() const noexcept {
+        return index_.IsBuilt();
+    }
+
+    void swap(FlatSet& other) noexcept {
+        keys_.swap(other.keys_);
+        std::swap(index_, other.index_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    // Сравнение на равенство через Compare
+    auto Equivalent() const {
+        return [this](const Key& lhs, const Key& rhs) { return !comp_(lhs, rhs) && !comp_(rhs, lhs); };
+    }
+
+    size_t LowerBoundIndex(const Key& key) const {
+        if (index_.IsBuilt()) {
+            return index_.LowerBound(key, comp_);
+        }
+        return BranchlessLowerBound(keys_.begin(), keys_.GetSize(), key, comp_);
+    }
+
+    template <typename Arg>
+    std::pair<ConstIterator, bool> EmplaceKey(Arg&& key) {
+        const size_t index = LowerBoundIndex(key);
+        if (index < keys_.GetSize() && !comp_(key, keys_[index])) {
+            return {begin() + index, false};
+        }
+        index_.Clear();
+        return {keys_.Insert(keys_.cbegin() + index, std::forward<Arg>(key)), true};
+    }
+
+    SimpleVector<Key> keys_;
+    EytzingerIndex<Key, Compare> index_;
+    Compare comp_;
+};
+
+template <typename Key, typename Compare>
+inline bool operator==(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs) {
+    return lhs.Keys() == rhs.Keys();
+}
+
+template <typename Key, typename Compare>
+inline bool operator!=(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+// Ассоциативный массив на двух SimpleVector: отсортированные ключи отдельно от значений,
+// поэтому поиск читает только плотный массив ключей, а значения не засоряют кеш.
+// Поиск, пакетная вставка и индекс Эйтцингера устроены так же, как у FlatSet.
+// Итератор разыменовывается в std::pair<const Key&, Value&>
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+    template <typename Owner, typename ValueRef>
+    class BasicIterator;
+
+public:
+    using value_type = std::pair<Key, Value>;
+    using key_type = Key;
+    using mapped_type = Value;
+    using key_compare = Compare;
+    using Iterator = BasicIterator<FlatMap, Value>;
+    using ConstIterator = BasicIterator<const FlatMap, const Value>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_(comp)
+    {}
+
+    FlatMap(std::initializer_list<value_type> init, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        Insert(init.begin(), init.end());
+    }
+
+    // Возвращает количество пар
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Возвращает отсортированные ключи
+    const SimpleVector<Key>& Keys() const noexcept {
+        return keys_;
+    }
+
+    // Возвращает значения в порядке ключей
+    const SimpleVector<Value>& Values() const noexcept {
+        return values_;
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Возвращает итератор на пару с ключом key или end()
+    Iterator Find(const Key& key) {
+        return Iterator(this, FindIndex(key));
+    }
+
+    ConstIterator Find(const Key& key) const {
+        return ConstIterator(this, FindIndex(key));
+    }
+
+    // Возвращает итератор на первую пару с ключом, не меньшим key
+    Iterator LowerBound(const Key& key) {
+        return Iterator(this, LowerBoundIndex(key));
+    }
+
+    ConstIterator LowerBound(const Key& key) const {
+        return ConstIterator(this, LowerBoundIndex(key));
+    }
+
+    // Сообщает, есть ли ключ key
+    bool Contains(const Key& key) const {
+        if (index_.IsBuilt()) {
+            return index_.Contains(key, comp_);
+        }
+        return FindIndex(key) != GetSize();
+    }
+
+    // Возвращает количество пар с ключом key (0 или 1)
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Возвращает ссылку на значение по ключу key
+    // Выбрасывает исключение std::out_of_range, если ключа нет
+    Value& At(const Key& key) {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            throw std::out_of_range("Error: Key not found!");
+        }
+        return values_[index];
+    }
+
+    const Value& At(const Key& key) const {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            throw std::out_of_range("Error: Key not found!");
+        }
+        return values_[index];
+    }
+
+    // Возвращает ссылку на значение по ключу key, вставляя значение по умолчанию, если ключа нет
+    Value& operator[](const Key& key) {
+        return *TryEmplace(key).first.ValuePtr();
+    }
+
+    // Вставляет пару (key, value), если ключа ещё нет.
+    // Возвращает итератор на пару с ключом key и признак того, что вставка произошла
+    std::pair<Iterator, bool> Insert(const Key& key, const Value& value) {
+        return TryEmplace(key, value);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Вставляет пару (key, value), если ключа ещё нет
+    std::pair<Iterator, bool> Insert(Key&& key, Value&& value) {
+        return TryEmplace(std::move(key), std::move(value));
+    }
+
+    // Вставляет или заменяет значение по ключу key.
+    // Возвращает итератор на пару и признак того, что ключ был вставлен
+    template <typename Arg>
+    std::pair<Iterator, bool> InsertOrAssign(const Key& key, Arg&& value) {
+        auto result = TryEmplace(key, std::forward<Arg>(value));
+        if (!result.second) {
+            *result.first.ValuePtr() = std::forward<Arg>(value);
+        }
+        return result;
+    }
+
+    // Вставляет пары [first, last) одним пакетом: новые пары сортируются отдельно
+    // и сливаются с имеющимися за один проход. Из пар с равными ключами остаётся
+    // уже имевшаяся в массиве, а среди новых - первая
+    template <typename InputIt, typename = std::enable_if_t<IsInputIterator<InputIt>::value>>
+    void Insert(InputIt first, InputIt last) {
+        SimpleVector<value_type> batch;
+        batch.Append(first, last);
+        if (batch.IsEmpty()) {
+            return;
+        }
+        index_.Clear();
+        std::stable_sort(batch.begin(), batch.end(), [this](const value_type& lhs, const value_type& rhs) {
+            return comp_(lhs.first, rhs.first);
+        });
+        batch.Erase(std::unique(batch.begin(), batch.end(), [this](const value_type& lhs, const value_type& rhs) {
+            return !comp_(lhs.first, rhs.first);
+        }), batch.end());
+        SimpleVector<Key> keys(::Reserve(keys_.GetSize() + batch.GetSize()));
+        SimpleVector<Value> values(::Reserve(keys_.GetSize() + batch.GetSize()));
+        size_t old_index = 0;
+        for (value_type& item : batch) {
+            Key& key = item.first;
+            for (; old_index < keys_.GetSize() && comp_(keys_[old_index], key); ++old_index) {
+                keys.PushBack(std::move(keys_[old_index]));
+                values.PushBack(std::move(values_[old_index]));
+            }
+            if (old_index < keys_.GetSize() && !comp_(key, keys_[old_index])) {
+                continue;
+            }
+            keys.PushBack(std::move(key));
+            values.PushBack(std::move(item.second));
+        }
+        for (; old_index < keys_.GetSize(); ++old_index) {
+            keys.PushBack(std::move(keys_[old_index]));
+            values.PushBack(std::move(values_[old_index]));
+        }
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+
+    void Insert(std::initializer_list<value_type> init) {
+        Insert(init.begin(), init.end());
+    }
+
+    // Удаляет пару с ключом key. Возвращает количество удалённых пар (0 или 1)
+    size_t Erase(const Key& key) {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            return 0;
+        }
+        Erase(ConstIterator(this, index));
+        return 1;
+    }
+
+    // Удаляет пару в позиции pos. Возвращает итератор на следующую пару
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = pos.GetIndex();
+        assert((index < GetSize()) && "Error: Out of range!");
+        index_.Clear();
+        keys_.Erase(keys_.cbegin() + index);
+        values_.Erase(values_.cbegin() + index);
+        return Iterator(this, index);
+    }
+
+    // Резервирует место под capacity пар
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    // Удаляет все пары
+    void Clear() noexcept {
+        index_.Clear();
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    // Строит индекс Эйтцингера по ключам. Индекс действует до следующей вставки или удаления
+    void BuildSearchIndex() {
+        index_.Build(keys_.begin(), keys_.GetSize());
+    }
+
+    // Сообщает, построен ли индекс Эйтцингера
+    bool HasSearchIndex() const noexcept {
+        return index_.IsBuilt();
+    }
+
+    void swap(FlatMap& other) noexcept {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        std::swap(index_, other.index_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    // Итератор произвольного доступа по парам
+    template <typename Owner, typename ValueRef>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename FlatMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::pair<const Key&, ValueRef&>;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {}
+
+        // Неконстантный итератор приводится к константному
+        template <typename OtherOwner, typename OtherValue,
+                  typename = std::enable_if_t<std::is_const_v<Owner> && !std::is_const_v<OtherOwner>>>
+        BasicIterator(const BasicIterator<OtherOwner, OtherValue>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return reference(owner_->keys_[index_], owner_->values_[index_]);
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        // Возвращает ключ пары
+        const Key& GetKey() const noexcept {
+            return owner_->keys_[index_];
+        }
+
+        // Возвращает указатель на значение пары
+        ValueRef* ValuePtr() const noexcept {
+            return &owner_->values_[index_];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ = static_cast<size_t>(static_cast<difference_type>(index_) + offset);
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            return *this += -offset;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+        // Возвращает индекс пары, на которую указывает итератор
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+    private:
+        template <typename, typename>
+        friend class BasicIterator;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    size_t LowerBoundIndex(const Key& key) const {
+        if (index_.IsBuilt()) {
+            return index_.LowerBound(key, comp_);
+        }
+        return BranchlessLowerBound(keys_.begin(), keys_.GetSize(), key, comp_);
+    }
+
+    // Индекс пары с ключом key или GetSize(), если ключа нет
+    size_t FindIndex(const Key& key) const {
+        const size_t index = LowerBoundIndex(key);
+        return index < GetSize() && !comp_(key, keys_[index]) ? index : GetSize();
+    }
+
+    template <typename KeyArg, typename... Args>
+    std::pair<Iterator, bool> TryEmplace(KeyArg&& key, Args&&... args) {
+        const size_t index = LowerBoundIndex(key);
+        if (index < GetSize() && !comp_(key, keys_[index])) {
+            return {Iterator(this, index), false};
+        }
+        index_.Clear();
+        values_.Emplace(values_.cbegin() + index, std::forward<Args>(args)...);
+        try {
+            keys_.Insert(keys_.cbegin() + index, std::forward<KeyArg>(key));
+        }
+        catch (...) {
+            values_.Erase(values_.cbegin() + index);
+            throw;
+        }
+        return {Iterator(this, index), true};
+    }
+
+    SimpleVector<Key> keys_;
+    SimpleVector<Value> values_;
+    EytzingerIndex<Key, Compare> index_;
+    Compare comp_;
+};
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator==(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return lhs.Keys() == rhs.Keys() && lhs.Values() == rhs.Values();
+}
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator!=(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+// Политики роста ёмкости SimpleVector.
+// Политика - это тип со статическим методом
+//     size_t NextCapacity(size_t capacity, size_t required, size_t element_size)
+// который возвращает новую ёмкость (не меньше required), когда при текущей ёмкости capacity
+// нужно разместить required элементов размера element_size.
+// Если в политике объявлено kClaimsSlack = true, вектор после каждого выделения забирает
+// весь фактически выделенный аллокатором объём (см. usable_size у DefaultAllocator).
+// Политика может также объявить
+//     size_t ShrinkCapacity(size_t capacity, size_t size, size_t element_size)
+// и тогда вектор после удаления элементов сжимает буфер до возвращённой ёмкости, если она меньше текущей
+
+// Удвоение ёмкости: минимум перевыделений, но до 50% памяти может пустовать
+struct DoublingGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(required, capacity * 2);
+    }
+};
+
+// Рост в 1.5 раза: меньше пустующей памяти, а освобождённые при росте блоки
+// со временем складываются в блок, достаточный для следующего перевыделения
+struct OneAndHalfGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(required, capacity + capacity / 2);
+    }
+};
+
+// Округляет ёмкость, выбранную политикой Base, вверх до целого числа страниц размера PageSize.
+// Буферы меньше страницы не округляются
+template <size_t PageSize, typename Base = DoublingGrowth>
+struct PageRoundedGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "Page size must be a power of two");
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t new_capacity = Base::NextCapacity(capacity, required, element_size);
+        const size_t bytes = new_capacity * element_size;
+        if (bytes < PageSize) {
+            return new_capacity;
+        }
+        return ((bytes + PageSize - 1) & ~(PageSize - 1)) / element_size;
+    }
+};
+
+// Округление до обычных страниц (4 КиБ)
+using PageGrowth = PageRoundedGrowth<4096>;
+
+// Округление до больших страниц (2 МиБ), чтобы большие буферы целиком покрывались huge pages
+using HugePageGrowth = PageRoundedGrowth<2 * 1024 * 1024>;
+
+// Рост по политике Base, после которого вектор забирает запас, фактически выделенный аллокатором
+// (malloc округляет запросы до своих классов размеров)
+template <typename Base = OneAndHalfGrowth>
+struct UsableSizeGrowth : Base {
+    static constexpr bool kClaimsSlack = true;
+};
+
+// Признак политики, забирающей запас аллокатора
+template <typename Growth, typename = void>
+struct GrowthClaimsSlack : std::false_type {};
+
+template <typename Growth>
+struct GrowthClaimsSlack<Growth, std::enable_if_t<Growth::kClaimsSlack>> : std::true_type {};
+
+// Рост по политике Base и автоматический возврат памяти с гистерезисом: когда после удаления
+// размер становится меньше capacity / ShrinkDivisor, ёмкость сжимается до size * ShrinkDivisor / 2.
+// После сжатия вектор заполнен не больше чем наполовину: до следующего роста размер должен
+// удвоиться, а до следующего сжатия - снова упасть вдвое, поэтому чередование вставок и удалений
+// у границы не вызывает перевыделений на каждой операции. Буферы до MinBytes байт не сжимаются
+template <typename Base = DoublingGrowth, size_t ShrinkDivisor = 4, size_t MinBytes = 4096>
+struct HysteresisShrink : Base {
+    static_assert(ShrinkDivisor >= 4, "A smaller divisor leaves no room between shrinking and growth");
+
+    static constexpr size_t ShrinkCapacity(size_t capacity, size_t size, size_t element_size) noexcept {
+        if (capacity * element_size <= MinBytes || size >= capacity / ShrinkDivisor) {
+            return capacity;
+        }
+        return std::max(size * (ShrinkDivisor / 2), MinBytes / element_size);
+    }
+};
+
+// Признак политики, сжимающей буфер после удаления элементов
+template <typename Growth, typename = void>
+struct GrowthShrinks : std::false_type {};
+
+template <typename Growth>
+struct GrowthShrinks<Growth, std::void_t<decltype(Growth::ShrinkCapacity(size_t{}, size_t{}, size_t{}))>>
+    : std::true_type {};
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Инструментирование SimpleVector: счётчики выделений памяти, перевыделений по причинам,
+// копирований и перемещений элементов и пиковой ёмкости, сгруппированные по тегам векторов.
+// Включается при компиляции: -DSIMPLE_VECTOR_INSTRUMENTATION=1 (в CMake - опция
+// SIMPLE_VECTOR_INSTRUMENTATION). В выключенном виде от него остаются только пустая база
+// VectorProbe и перечисление GrowthCause: реестр счётчиков, отчёты и их заголовки
+// не компилируются, а размер и код вектора не меняются
+#ifndef SIMPLE_VECTOR_INSTRUMENTATION
+#define SIMPLE_VECTOR_INSTRUMENTATION 0
+#endif
+
+// Причина перевыделения памяти вектора
+enum class GrowthCause {
+    kPushBack,  // PushBack, EmplaceBack
+    kInsert,    // Insert, Emplace, Append
+    kResize,    // Resize, ResizeForOverwrite
+    kReserve,   // Reserve
+    kShrink,    // ShrinkToFit и автоматическое сжатие (см. HysteresisShrink)
+};
+
+inline constexpr size_t kGrowthCauseCount = 5;
+
+#if SIMPLE_VECTOR_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+
+// Формат отчёта DumpVectorStats
+enum class StatsFormat {
+    kText,
+    kJson,
+};
+
+// Значения счётчиков одного тега
+struct VectorStatsSnapshot {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytes_allocated = 0;
+    size_t bytes_freed = 0;
+    size_t reallocations[kGrowthCauseCount] = {};
+    size_t copies = 0;
+    size_t moves = 0;
+    size_t peak_capacity = 0;
+
+    // Возвращает число перевыделений по причине cause
+    size_t Reallocations(GrowthCause cause) const noexcept {
+        return reallocations[static_cast<size_t>(cause)];
+    }
+
+    // Возвращает число перевыделений по всем причинам
+    size_t TotalReallocations() const noexcept {
+        size_t total = 0;
+        for (size_t count : reallocations) {
+            total += count;
+        }
+        return total;
+    }
+};
+
+// Счётчики одного тега. Обновляются из любых потоков
+class VectorStats {
+public:
+    void OnAllocate(size_t capacity, size_t bytes) noexcept {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+        size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (capacity > peak && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+        }
+    }
+
+    void OnFree(size_t bytes) noexcept {
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_freed_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void OnGrowth(GrowthCause cause) noexcept {
+        reallocations_[static_cast<size_t>(cause)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnCopies(size_t count) noexcept {
+        copies_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void OnMoves(size_t count) noexcept {
+        moves_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // Возвращает текущие значения счётчиков
+    VectorStatsSnapshot Snapshot() const noexcept {
+        VectorStatsSnapshot snapshot;
+        snapshot.allocations = allocations_.load(std::memory_order_relaxed);
+        snapshot.deallocations = deallocations_.load(std::memory_order_relaxed);
+        snapshot.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+        snapshot.bytes_freed = bytes_freed_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kGrowthCauseCount; ++i) {
+            snapshot.reallocations[i] = reallocations_[i].load(std::memory_order_relaxed);
+        }
+        snapshot.copies = copies_.load(std::memory_order_relaxed);
+        snapshot.moves = moves_.load(std::memory_order_relaxed);
+        snapshot.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    // Обнуляет счётчики
+    void Reset() noexcept {
+        for (std::atomic<size_t>* counter : {&allocations_, &deallocations_, &bytes_allocated_, &bytes_freed_,
+                                             &copies_, &moves_, &peak_capacity_}) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+        for (std::atomic<size_t>& counter : reallocations_) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<size_t> allocations_{0};
+    std::atomic<size_t> deallocations_{0};
+    std::atomic<size_t> bytes_allocated_{0};
+    std::atomic<size_t> bytes_freed_{0};
+    std::atomic<size_t> reallocations_[kGrowthCauseCount] = {};
+    std::atomic<size_t> copies_{0};
+    std::atomic<size_t> moves_{0};
+    std::atomic<size_t> peak_capacity_{0};
+};
+
+// Счётчики всех тегов процесса. Векторы без тега учитываются под тегом "untagged".
+// Реестр не разрушается до завершения процесса, поэтому его можно использовать
+// из деструкторов статических векторов
+class VectorStatsRegistry {
+public:
+    static VectorStatsRegistry& Instance() {
+        static VectorStatsRegistry* registry = new VectorStatsRegistry();
+        return *registry;
+    }
+
+    // Возвращает счётчики тега tag, создавая их при первом обращении.
+    // Адрес счётчиков не меняется до конца работы процесса
+    VectorStats& ForTag(std::string_view tag) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = stats_.find(tag);
+        if (it == stats_.end()) {
+            it = stats_.emplace(std::string(tag), std::make_unique<VectorStats>()).first;
+        }
+        return *it->second;
+    }
+
+    VectorStats& Untagged() {
+        static VectorStats& untagged = ForTag("untagged");
+        return untagged;
+    }
+
+    // Возвращает значения счётчиков тега tag (нулевые, если тег не встречался)
+    VectorStatsSnapshot Snapshot(std::string_view tag) const {
+        std::lock_guard<std::mutex> guard(mutex_);
+        const auto it = stats_.find(tag);
+        return it == stats_.end() ? VectorStatsSnapshot{} : it->second->Snapshot();
+    }
+
+    // Обнуляет счётчики всех тегов
+    void Reset() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (auto& [tag, stats] : stats_) {
+            stats->Reset();
+        }
+    }
+
+    // Печатает счётчики всех тегов в алфавитном порядке тегов
+    void Dump(std::ostream& out, StatsFormat format) const {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (format == StatsFormat::kJson) {
+            out << "{\"vectors\": [";
+            bool first = true;
+            for (const auto& [tag, stats] : stats_) {
+                const VectorStatsSnapshot s = stats->Snapshot();
+                out << (first ? "\n" : ",\n") << "  {\"tag\": \"" << EscapeJson(tag) << "\""
+                    << ", \"allocations\": " << s.allocations << ", \"deallocations\": " << s.deallocations
+                    << ", \"bytes_allocated\": " << s.bytes_allocated << ", \"bytes_freed\": " << s.bytes_freed
+                    << ", \"reallocations\": {\"push_back\": " << s.Reallocations(GrowthCause::kPushBack)
+                    << ", \"insert\": " << s.Reallocations(GrowthCause::kInsert)
+                    << ", \"resize\": " << s.Reallocations(GrowthCause::kResize)
+                    << ", \"reserve\": " << s.Reallocations(GrowthCause::kReserve)
+                    << ", \"shrink\": " << s.Reallocations(GrowthCause::kShrink) << "}"
+                    << ", \"copies\": " << s.copies << ", \"moves\": " << s.moves
+                    << ", \"peak_capacity\": " << s.peak_capacity << "}";
+                first = false;
+            }
+            out << "\n]}" << std::endl;
+            return;
+        }
+        out << std::left << std::setw(24) << "tag" << std::right
+            << std::setw(10) << "allocs" << std::setw(10) << "frees"
+            << std::setw(14) << "bytes_alloc" << std::setw(14) << "bytes_freed"
+            << std::setw(10) << "re:push" << std::setw(10) << "re:ins" << std::setw(10) << "re:resize"
+            << std::setw(10) << "re:resrv" << std::setw(10) << "re:shrink"
+            << std::setw(12) << "copies" << std::setw(12) << "moves"
+            << std::setw(12) << "peak_cap" << std::endl;
+        for (const auto& [tag, stats] : stats_) {
+            const VectorStatsSnapshot s = stats->Snapshot();
+            out << std::left << std::setw(24) << tag << std::right
+                << std::setw(10) << s.allocations << std::setw(10) << s.deallocations
+                << std::setw(14) << s.bytes_allocated << std::setw(14) << s.bytes_freed
+                << std::setw(10) << s.Reallocations(GrowthCause::kPushBack)
+                << std::setw(10) << s.Reallocations(GrowthCause::kInsert)
+                << std::setw(10) << s.Reallocations(GrowthCause::kResize)
+                << std::setw(10) << s.Reallocations(GrowthCause::kReserve)
+                << std::setw(10) << s.Reallocations(GrowthCause::kShrink)
+                << std::setw(12) << s.copies << std::setw(12) << s.moves
+                << std::setw(12) << s.peak_capacity << std::endl;
+        }
+    }
+
+private:
+    VectorStatsRegistry() = default;
+
+    static std::string EscapeJson(const std::string& text) {
+        std::string escaped;
+        for (const char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+        }
+        return escaped;
+    }
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<VectorStats>, std::less<>> stats_;
+};
+
+// Печатает счётчики всех тегов
+inline void DumpVectorStats(std::ostream& out = std::cerr, StatsFormat format = StatsFormat::kText) {
+    VectorStatsRegistry::Instance().Dump(out, format);
+}
+
+// Печатает счётчики при завершении процесса (exit или возврат из main):
+// в файл path или, если он пуст, в std::cerr. Повторный вызов меняет формат и файл
+inline void DumpVectorStatsAtExit(StatsFormat format = StatsFormat::kText, std::string path = {}) {
+    static StatsFormat exit_format = format;
+    static std::string exit_path;
+    static const bool registered = [] {
+        VectorStatsRegistry::Instance();
+        std::atexit([] {
+            if (exit_path.empty()) {
+                DumpVectorStats(std::cerr, exit_format);
+            } else {
+                std::ofstream out(exit_path);
+                DumpVectorStats(out, exit_format);
+            }
+        });
+        return true;
+    }();
+    (void)registered;
+    exit_format = format;
+    exit_path = std::move(path);
+}
+
+// Точка учёта событий вектора: ссылается на счётчики его тега.
+// Копия вектора наследует тег оригинала
+class VectorProbe {
+public:
+    VectorProbe() noexcept
+        : stats_(&VectorStatsRegistry::Instance().Untagged())
+    {}
+
+    // Учитывает события вектора под тегом tag
+    void SetTag(std::string_view tag) {
+        stats_ = &VectorStatsRegistry::Instance().ForTag(tag);
+    }
+
+protected:
+    // Выделен буфер под capacity элементов размера element_size
+    void OnAllocate(size_t capacity, size_t element_size) const noexcept {
+        if (capacity > 0) {
+            stats_->OnAllocate(capacity, capacity * element_size);
+        }
+    }
+
+    // Освобождён буфер под capacity элементов размера element_size
+    void OnFree(size_t capacity, size_t element_size) const noexcept {
+        if (capacity > 0) {
+            stats_->OnFree(capacity * element_size);
+        }
+    }
+
+    // Буфер заменён другим по причине cause
+    void OnGrowth(GrowthCause cause, size_t old_capacity, size_t new_capacity, size_t element_size) const noexcept {
+        stats_->OnGrowth(cause);
+        OnAllocate(new_capacity, element_size);
+        OnFree(old_capacity, element_size);
+    }
+
+    void OnCopies(size_t count) const noexcept {
+        stats_->OnCopies(count);
+    }
+
+    void OnMoves(size_t count) const noexcept {
+        stats_->OnMoves(count);
+    }
+
+private:
+    VectorStats* stats_;
+};
+
+#else
+
+// Выключенное инструментирование: пустая база, вызовы которой компилятор удаляет
+class VectorProbe {
+public:
+    constexpr void SetTag(std::string_view) noexcept {}
+
+protected:
+    constexpr void OnAllocate(size_t, size_t) const noexcept {}
+    constexpr void OnFree(size_t, size_t) const noexcept {}
+    constexpr void OnGrowth(GrowthCause, size_t, size_t, size_t) const noexcept {}
+    constexpr void OnCopies(size_t) const noexcept {}
+    constexpr void OnMoves(size_t) const noexcept {}
+};
+
+#endif
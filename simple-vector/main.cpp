@@ -65,7 +65,7 @@ inline void MyTestAsserts() {
         assert(v[4] == 4);
         v.Erase(v.begin());
         assert(v[0] == 1);
-        v.Erase(v.end());
+        v.Erase(v.end() - 1);
         assert(v[2] == 3);
 
         v.Clear();
@@ -123,8 +123,47 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestMoveStealsBuffer();
+    TestRangeInsert();
+    TestEmplace();
+    TestBulkErase();
     cout << "< NEW TESTS > -OK-" << endl << endl;
 
+    TestRawCapacity();
+    TestResizeForOverwrite();
+    TestTriviallyRelocatable();
+    TestGrowthPolicies();
+    TestShrinkToFit();
+    TestSimdKernels();
+    TestBitVector();
+    TestCompressedIntVector();
+    TestInstrumentation();
+    cout << "< STORAGE TESTS > -OK-" << endl << endl;
+
+    TestArenaAllocator();
+    TestPoolAllocator();
+    TestPmrSimpleVector();
+    TestAlignedAllocators();
+    cout << "< ALLOCATOR TESTS > -OK-" << endl << endl;
+
+    TestSmallSimpleVector();
+    TestFixedVector();
+    TestSegmentedSimpleVector();
+    TestSoAVector();
+    TestFlatContainers();
+    cout << "< SMALL VECTOR TESTS > -OK-" << endl << endl;
+
+    TestSharedSimpleVector();
+    cout << "< SHARED VECTOR TESTS > -OK-" << endl << endl;
+
+    TestConcurrentSimpleVector();
+    TestParallelAlgorithms();
+    cout << "< PARALLEL TESTS > -OK-" << endl << endl;
+
+    TestMappedSimpleVector();
+    TestSerialization();
+    cout << "< PERSISTENCE TESTS > -OK-" << endl << endl;
+
     MyTestAsserts();
     cout << "< MY TESTS > -OK-" << endl << endl;
     return 0;
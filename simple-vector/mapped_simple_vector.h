@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "growth_policy.h"
+
+// Режим открытия файла MappedSimpleVector
+enum class MapMode {
+    kReadOnly,   // только чтение; файл должен существовать
+    kReadWrite,  // чтение и запись; файл создаётся, если его нет
+    kCreate,     // чтение и запись с пустого файла (существующий файл усекается)
+};
+
+// Подсказки ядру о порядке обращения к отображённой памяти (madvise)
+enum class MapAdvice {
+    kNormal,
+    kSequential,  // последовательное чтение: агрессивное упреждающее чтение
+    kRandom,      // случайный доступ: без упреждающего чтения
+    kWillNeed,    // подгрузить страницы заранее
+    kDontNeed,    // страницы можно вытеснить
+    kHugePage,    // использовать большие страницы, если ядро это поддерживает
+};
+
+// Вектор тривиально копируемых элементов, хранящихся в файле, отображённом в память (mmap).
+// Файл - это просто элементы подряд, без заголовка: открытие существующего файла не копирует
+// и не разбирает данные, а страницы подгружаются ядром по мере обращения.
+// Рост выполняется через ftruncate + mremap, изменения попадают в файл (MAP_SHARED);
+// Flush принудительно сбрасывает их на диск. При закрытии файл усекается до размера вектора.
+// Growth - политика роста ёмкости (см. growth_policy.h), по умолчанию кратная страницам
+template <typename Type, typename Growth = PageGrowth>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "MappedSimpleVector stores elements as raw file bytes");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using value_type = Type;
+
+    // Создаёт вектор, не связанный с файлом
+    MappedSimpleVector() noexcept = default;
+
+    // Открывает файл path и отображает его в память.
+    // Выбрасывает std::system_error при ошибке системного вызова и std::runtime_error,
+    // если размер файла не кратен размеру элемента
+    explicit MappedSimpleVector(const std::string& path, MapMode mode = MapMode::kReadWrite)
+        : writable_(mode != MapMode::kReadOnly)
+    {
+        int flags = writable_ ? O_RDWR | O_CREAT : O_RDONLY;
+        if (mode == MapMode::kCreate) {
+            flags |= O_TRUNC;
+        }
+        fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            ThrowSystemError("open " + path);
+        }
+        try {
+            struct stat info {};
+            if (::fstat(fd_, &info) != 0) {
+                ThrowSystemError("fstat " + path);
+            }
+            const size_t bytes = static_cast<size_t>(info.st_size);
+            if (bytes % sizeof(Type) != 0) {
+                throw std::runtime_error("Error: File size of " + path + " is not a multiple of the element size!");
+            }
+            if (bytes > 0) {
+                Map(bytes / sizeof(Type));
+            }
+            size_ = capacity_;
+        }
+        catch (...) {
+            Close();
+            throw;
+        }
+    }
+
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Забирает отображение и файл other
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , fd_(std::exchange(other.fd_, -1))
+        , writable_(std::exchange(other.writable_, false))
+    {}
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Закрывает свой файл и забирает отображение и файл rhs
+    MappedSimpleVector& operator=(MappedSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Close();
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+            fd_ = std::exchange(rhs.fd_, -1);
+            writable_ = std::exchange(rhs.writable_, false);
+        }
+        return *this;
+    }
+
+    ~MappedSimpleVector() {
+        Close();
+    }
+
+    // Снимает отображение, усекает файл до размера вектора и закрывает его
+    void Close() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(data_, capacity_ * sizeof(Type));
+            data_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            if (writable_) {
+                [[maybe_unused]] const int result = ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(Type)));
+            }
+            ::close(fd_);
+            fd_ = -1;
+        }
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+    // Сообщает, связан ли вектор с файлом
+    bool IsOpen() const noexcept {
+        return fd_ >= 0;
+    }
+
+    // Сообщает, можно ли изменять вектор
+    bool IsWritable() const noexcept {
+        return writable_;
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива (столько элементов помещается в файл без его увеличения)
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index.
+    // Запись в вектор, открытый только для чтения, недопустима: страницы отображены без PROT_WRITE,
+    // и запись через ссылку завершит процесс сигналом SIGSEGV. Для такого вектора читайте через const
+    Type& operator[](size_t index) noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size,
+    // и std::logic_error, если вектор открыт только для чтения
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        RequireWritable();
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return data_[index];
+    }
+
+    // Изменяемые итераторы, как и operator[], не проверяют режим:
+    // писать через них в вектор, открытый только для чтения, нельзя
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Обнуляет размер массива, не изменяя его вместимость
+    void Clear() noexcept {
+        size_ = 0;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места файл увеличивается по политике Growth
+    void PushBack(const Type& item) {
+        if (size_ == capacity_) {
+            // item может лежать в самом отображении, которое mremap способен перенести
+            const Type copy = item;
+            Reserve(Growth::NextCapacity(capacity_, size_ + 1, sizeof(Type)));
+            data_[size_++] = copy;
+            return;
+        }
+        RequireWritable();
+        data_[size_++] = item;
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        --size_;
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        if (new_size > size_) {
+            if (new_size > capacity_) {
+                Reserve(Growth::NextCapacity(capacity_, new_size, sizeof(Type)));
+            }
+            RequireWritable();
+            std::fill(data_ + size_, data_ + new_size, Type{});
+        }
+        size_ = new_size;
+    }
+
+    // Увеличивает файл и отображение до new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            RequireWritable();
+            Map(new_capacity);
+        }
+    }
+
+    // Синхронно записывает изменённые страницы на диск
+    void Flush() {
+        if (data_ != nullptr && size_ > 0 && ::msync(data_, size_ * sizeof(Type), MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+
+    // Передаёт ядру подсказку о порядке обращения к данным.
+    // Возвращает false, если подсказка не поддерживается (например, большие страницы для файлов)
+    bool Advise(MapAdvice advice) noexcept {
+        if (data_ == nullptr) {
+            return false;
+        }
+        return ::madvise(data_, capacity_ * sizeof(Type), ToMadvise(advice)) == 0;
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(MappedSimpleVector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(fd_, other.fd_);
+        std::swap(writable_, other.writable_);
+    }
+
+private:
+    [[noreturn]] static void ThrowSystemError(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), "Error: " + what);
+    }
+
+    void RequireWritable() const {
+        if (!writable_) {
+            throw std::logic_error("Error: Vector is read-only!");
+        }
+    }
+
+    // Отображает в память new_capacity элементов файла, при необходимости увеличивая файл.
+    // Существующее отображение расширяется через mremap, которое может перенести его по другому адресу
+    void Map(size_t new_capacity) {
+        if (new_capacity > static_cast<size_t>(std::numeric_limits<off_t>::max()) / sizeof(Type)) {
+            throw std::length_error("Error: Vector is too long!");
+        }
+        const size_t new_bytes = new_capacity * sizeof(Type);
+        if (writable_ && new_capacity > capacity_ && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+        void* mapped = MAP_FAILED;
+        if (data_ == nullptr) {
+            const int protection = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+            mapped = ::mmap(nullptr, new_bytes, protection, MAP_SHARED, fd_, 0);
+        } else {
+#if defined(__linux__)
+            mapped = ::mremap(data_, capacity_ * sizeof(Type), new_bytes, MREMAP_MAYMOVE);
+#else
+            mapped = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (mapped != MAP_FAILED) {
+                ::munmap(data_, capacity_ * sizeof(Type));
+            }
+#endif
+        }
+        if (mapped == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        data_ = static_cast<Type*>(mapped);
+        capacity_ = new_capacity;
+    }
+
+    static int ToMadvise(MapAdvice advice) noexcept {
+        switch (advice) {
+            case MapAdvice::kSequential:
+                return MADV_SEQUENTIAL;
+            case MapAdvice::kRandom:
+                return MADV_RANDOM;
+            case MapAdvice::kWillNeed:
+                return MADV_WILLNEED;
+            case MapAdvice::kDontNeed:
+                return MADV_DONTNEED;
+            case MapAdvice::kHugePage:
+#if defined(MADV_HUGEPAGE)
+                return MADV_HUGEPAGE;
+#else
+                return MADV_NORMAL;
+#endif
+            case MapAdvice::kNormal:
+                break;
+        }
+        return MADV_NORMAL;
+    }
+
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    int fd_ = -1;
+    bool writable_ = false;
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+#include "simple_vector.h"
+#include "thread_pool.h"
+
+// Параллельные алгоритмы над диапазонами SimpleVector (Iterator = Type*) и над самими векторами.
+// Диапазон режется на блоки по grain_size элементов, блоки выполняются задачами WorkStealingPool
+
+// Настройки параллельного алгоритма
+struct ParallelOptions {
+    // Число элементов в блоке; 0 - подобрать по размеру диапазона и числу потоков
+    size_t grain_size = 0;
+    // Пул потоков; nullptr - общий пул DefaultThreadPool()
+    WorkStealingPool* pool = nullptr;
+};
+
+namespace parallel_detail {
+
+// Наименьший блок, который имеет смысл отдавать отдельной задаче
+inline constexpr size_t kMinGrainSize = 4096;
+
+inline WorkStealingPool& PoolOf(const ParallelOptions& options) {
+    return options.pool != nullptr ? *options.pool : DefaultThreadPool();
+}
+
+// Размер блока: заданный явно или около восьми блоков на поток, чтобы было что перехватывать
+inline size_t GrainOf(const ParallelOptions& options, size_t count) {
+    if (options.grain_size != 0) {
+        return options.grain_size;
+    }
+    const size_t blocks = PoolOf(options).GetConcurrency() * 8;
+    return std::max(kMinGrainSize, (count + blocks - 1) / blocks);
+}
+
+// Вызывает body(first, last) для блоков [0, count) размером grain и дожидается их выполнения
+template <typename Body>
+void ForEachBlock(WorkStealingPool& pool, size_t count, size_t grain, const Body& body) {
+    if (count <= grain || pool.GetConcurrency() == 1) {
+        for (size_t first = 0; first < count; first += grain) {
+            body(first, std::min(count, first + grain));
+        }
+        return;
+    }
+    TaskGroup group(pool);
+    for (size_t first = 0; first < count; first += grain) {
+        const size_t last = std::min(count, first + grain);
+        group.Run([&body, first, last] { body(first, last); });
+    }
+    group.Wait();
+}
+
+} // namespace parallel_detail
+
+// Вызывает fn для каждого элемента [first, last)
+template <typename Type, typename Fn>
+void ParallelForEach(Type* first, Type* last, Fn fn, const ParallelOptions& options = {}) {
+    const size_t count = static_cast<size_t>(last - first);
+    parallel_detail::ForEachBlock(parallel_detail::PoolOf(options), count, parallel_detail::GrainOf(options, count),
+                                  [&](size_t block_first, size_t block_last) {
+                                      std::for_each(first + block_first, first + block_last, fn);
+                                  });
+}
+
+// Записывает fn(x) для каждого x из [first, last) в dest (dest может совпадать с first)
+template <typename InType, typename OutType, typename Fn>
+void ParallelTransform(const InType* first, const InType* last, OutType* dest, Fn fn,
+                       const ParallelOptions& options = {}) {
+    const size_t count = static_cast<size_t>(last - first);
+    parallel_detail::ForEachBlock(parallel_detail::PoolOf(options), count, parallel_detail::GrainOf(options, count),
+                                  [&](size_t block_first, size_t block_last) {
+                                      std::transform(first + block_first, first + block_last, dest + block_first, fn);
+                                  });
+}
+
+// Сворачивает [first, last) ассоциативной операцией op, начиная с init.
+// Блоки сворачиваются параллельно, а их результаты - по порядку блоков
+template <typename Type, typename Init, typename Op = std::plus<>>
+Init ParallelReduce(const Type* first, const Type* last, Init init, Op op = {}, const ParallelOptions& options = {}) {
+    const size_t count = static_cast<size_t>(last - first);
+    const size_t grain = parallel_detail::GrainOf(options, count);
+    const size_t blocks = (count + grain - 1) / grain;
+    SimpleVector<Init> partial(blocks, init);
+    parallel_detail::ForEachBlock(parallel_detail::PoolOf(options), count, grain,
+                                  [&](size_t block_first, size_t block_last) {
+                                      partial[block_first / grain] = std::accumulate(
+                                          first + block_first + 1, first + block_last,
+                                          Init(first[block_first]), op);
+                                  });
+    return std::accumulate(partial.begin(), partial.end(), std::move(init), op);
+}
+
+// Записывает в dest префиксные «суммы» [first, last) по ассоциативной операции op:
+// dest[i] = first[0] op first[1] op ... op first[i]. dest может совпадать с first.
+// Первый проход считает префиксы внутри блоков, затем последние элементы блоков
+// последовательно доводятся до глобальных значений, а второй проход добавляет их к остальным
+template <typename Type, typename Op = std::plus<>>
+void ParallelInclusiveScan(const Type* first, const Type* last, Type* dest, Op op = {},
+                           const ParallelOptions& options = {}) {
+    const size_t count = static_cast<size_t>(last - first);
+    if (count == 0) {
+        return;
+    }
+    WorkStealingPool& pool = parallel_detail::PoolOf(options);
+    const size_t grain = parallel_detail::GrainOf(options, count);
+    parallel_detail::ForEachBlock(pool, count, grain, [&](size_t block_first, size_t block_last) {
+        std::partial_sum(first + block_first, first + block_last, dest + block_first, op);
+    });
+    for (size_t block_last = 2 * grain; block_last - grain < count; block_last += grain) {
+        const size_t last_index = std::min(block_last, count) - 1;
+        dest[last_index] = op(dest[block_last - grain - 1], dest[last_index]);
+    }
+    parallel_detail::ForEachBlock(pool, count, grain, [&](size_t block_first, size_t block_last) {
+        if (block_first == 0) {
+            return;
+        }
+        const Type& carry = dest[block_first - 1];
+        for (size_t i = block_first; i + 1 < block_last; ++i) {
+            dest[i] = op(carry, dest[i]);
+        }
+    });
+}
+
+// Сортирует [first, last): блоки сортируются параллельно, затем попарно сливаются,
+// причём слияния одного уровня тоже выполняются параллельно
+template <typename Type, typename Compare = std::less<>>
+void ParallelSort(Type* first, Type* last, Compare comp = {}, const ParallelOptions& options = {}) {
+    const size_t count = static_cast<size_t>(last - first);
+    WorkStealingPool& pool = parallel_detail::PoolOf(options);
+    const size_t grain = parallel_detail::GrainOf(options, count);
+    parallel_detail::ForEachBlock(pool, count, grain, [&](size_t block_first, size_t block_last) {
+        std::sort(first + block_first, first + block_last, comp);
+    });
+    for (size_t width = grain; width < count; width *= 2) {
+        const size_t pairs = (count + 2 * width - 1) / (2 * width);
+        parallel_detail::ForEachBlock(pool, pairs, 1, [&](size_t pair_first, size_t pair_last) {
+            for (size_t pair = pair_first; pair < pair_last; ++pair) {
+                const size_t low = pair * 2 * width;
+                const size_t middle = std::min(low + width, count);
+                const size_t high = std::min(low + 2 * width, count);
+                std::inplace_merge(first + low, first + middle, first + high, comp);
+            }
+        });
+    }
+}
+
+// Перегрузки для целых векторов
+
+template <typename Type, typename Alloc, typename Growth, typename Fn>
+void ParallelForEach(SimpleVector<Type, Alloc, Growth>& vector, Fn fn, const ParallelOptions& options = {}) {
+    ParallelForEach(vector.begin(), vector.end(), std::move(fn), options);
+}
+
+template <typename Type, typename Alloc, typename Growth, typename OutType, typename Fn>
+void ParallelTransform(const SimpleVector<Type, Alloc, Growth>& vector, OutType* dest, Fn fn,
+                       const ParallelOptions& options = {}) {
+    ParallelTransform(vector.begin(), vector.end(), dest, std::move(fn), options);
+}
+
+template <typename Type, typename Alloc, typename Growth, typename Init, typename Op = std::plus<>>
+Init ParallelReduce(const SimpleVector<Type, Alloc, Growth>& vector, Init init, Op op = {},
+                    const ParallelOptions& options = {}) {
+    return ParallelReduce(vector.begin(), vector.end(), std::move(init), std::move(op), options);
+}
+
+template <typename Type, typename Alloc, typename Growth, typename Op = std::plus<>>
+void ParallelInclusiveScan(SimpleVector<Type, Alloc, Growth>& vector, Op op = {}, const ParallelOptions& options = {}) {
+    ParallelInclusiveScan(vector.begin(), vector.end(), vector.begin(), std::move(op), options);
+}
+
+template <typename Type, typename Alloc, typename Growth, typename Compare = std::less<>>
+void ParallelSort(SimpleVector<Type, Alloc, Growth>& vector, Compare comp = {}, const ParallelOptions& options = {}) {
+    ParallelSort(vector.begin(), vector.end(), std::move(comp), options);
+}
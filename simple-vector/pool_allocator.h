@@ -0,0 +1,292 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+// Пул с классами размеров: запросы до kMaxBlockSize байт округляются вверх до степени двойки
+// и выдаются из плит (slab) своего класса; освобождённые блоки попадают в список свободных
+// блоков класса и переиспользуются без обращения к upstream. Более крупные запросы
+// уходят в upstream напрямую, но тоже учитываются пулом.
+// Reset() возвращает upstream всю память пула разом, включая крупные блоки.
+// Пул также является std::pmr::memory_resource и годится для PmrSimpleVector
+class SizeClassPool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kMinBlockSize = 16;
+    static constexpr size_t kMaxBlockSize = 64 * 1024;
+
+    // slab_size - размер плит, запрашиваемых у upstream для каждого класса
+    explicit SizeClassPool(size_t slab_size = 256 * 1024,
+                           std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : slab_size_(slab_size)
+        , upstream_(upstream)
+    {}
+
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    ~SizeClassPool() override {
+        Reset();
+    }
+
+    // Возвращает размер блока, который будет выдан под bytes байт с выравниванием alignment,
+    // либо 0, если запрос обслуживается upstream напрямую
+    static size_t GetBlockSize(size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept {
+        size_t block_size = kMinBlockSize;
+        const size_t needed = bytes > alignment ? bytes : alignment;
+        if (needed > kMaxBlockSize || alignment > kMaxSlabAlignment) {
+            return 0;
+        }
+        while (block_size < needed) {
+            block_size <<= 1;
+        }
+        return block_size;
+    }
+
+    // Выделяет bytes байт с выравниванием alignment
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        const size_t block_size = GetBlockSize(bytes, alignment);
+        if (block_size == 0) {
+            return AllocateLarge(bytes, alignment);
+        }
+        SizeClass& size_class = classes_[ClassIndex(block_size)];
+        if (size_class.free_list != nullptr) {
+            FreeBlock* block = size_class.free_list;
+            size_class.free_list = block->next;
+            return block;
+        }
+        if (size_class.cursor == size_class.end) {
+            AddSlab(size_class, block_size);
+        }
+        void* block = size_class.cursor;
+        size_class.cursor += block_size;
+        return block;
+    }
+
+    // Возвращает блок в список свободных блоков его класса
+    void Deallocate(void* ptr, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        const size_t block_size = GetBlockSize(bytes, alignment);
+        if (block_size == 0) {
+            DeallocateLarge(ptr);
+            return;
+        }
+        SizeClass& size_class = classes_[ClassIndex(block_size)];
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = size_class.free_list;
+        size_class.free_list = block;
+    }
+
+    // Возвращает upstream всю память пула. Все объекты, размещённые в пуле,
+    // к этому моменту должны быть разрушены
+    void Reset() noexcept {
+        while (slabs_ != nullptr) {
+            SlabRecord* next = slabs_->next;
+            upstream_->deallocate(slabs_->ptr, slabs_->size, slabs_->alignment);
+            upstream_->deallocate(slabs_, sizeof(SlabRecord), alignof(SlabRecord));
+            slabs_ = next;
+        }
+        while (large_ != nullptr) {
+            DeallocateLarge(large_ + 1);
+        }
+        for (SizeClass& size_class : classes_) {
+            size_class = SizeClass{};
+        }
+        slab_count_ = 0;
+    }
+
+    // Возвращает количество плит, полученных от upstream
+    size_t GetSlabCount() const noexcept {
+        return slab_count_;
+    }
+
+private:
+    static constexpr size_t kMaxSlabAlignment = 4096;
+    static constexpr size_t kClassCount = 13;  // 16, 32, ..., 64K
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        FreeBlock* free_list = nullptr;
+        std::byte* cursor = nullptr;
+        std::byte* end = nullptr;
+    };
+
+    struct SlabRecord {
+        SlabRecord* next;
+        void* ptr;
+        size_t size;
+        size_t alignment;
+    };
+
+    // Заголовок крупного блока; располагается непосредственно перед выданной памятью
+    struct alignas(std::max_align_t) LargeHeader {
+        LargeHeader* prev;
+        LargeHeader* next;
+        size_t size;
+        size_t offset;
+        size_t alignment;
+    };
+
+    static size_t ClassIndex(size_t block_size) noexcept {
+        size_t index = 0;
+        while ((kMinBlockSize << index) < block_size) {
+            ++index;
+        }
+        return index;
+    }
+
+    // Запрашивает у upstream новую плиту для класса block_size
+    void AddSlab(SizeClass& size_class, size_t block_size) {
+        const size_t size = slab_size_ > block_size ? slab_size_ - slab_size_ % block_size : block_size;
+        const size_t alignment = block_size < kMaxSlabAlignment ? block_size : kMaxSlabAlignment;
+        SlabRecord* record = static_cast<SlabRecord*>(upstream_->allocate(sizeof(SlabRecord), alignof(SlabRecord)));
+        try {
+            record->ptr = upstream_->allocate(size, alignment);
+        }
+        catch (...) {
+            upstream_->deallocate(record, sizeof(SlabRecord), alignof(SlabRecord));
+            throw;
+        }
+        record->size = size;
+        record->alignment = alignment;
+        record->next = slabs_;
+        slabs_ = record;
+        ++slab_count_;
+        size_class.cursor = static_cast<std::byte*>(record->ptr);
+        size_class.end = size_class.cursor + size;
+    }
+
+    void* AllocateLarge(size_t bytes, size_t alignment) {
+        if (alignment < alignof(LargeHeader)) {
+            alignment = alignof(LargeHeader);
+        }
+        const size_t offset = (sizeof(LargeHeader) + alignment - 1) / alignment * alignment;
+        if (bytes > std::numeric_limits<size_t>::max() - offset) {
+            throw std::bad_alloc();
+        }
+        std::byte* base = static_cast<std::byte*>(upstream_->allocate(offset + bytes, alignment));
+        LargeHeader* header = reinterpret_cast<LargeHeader*>(base + offset) - 1;
+        header->prev = nullptr;
+        header->next = large_;
+        header->size = offset + bytes;
+        header->offset = offset;
+        header->alignment = alignment;
+        if (large_ != nullptr) {
+            large_->prev = header;
+        }
+        large_ = header;
+        return header + 1;
+    }
+
+    void DeallocateLarge(void* ptr) noexcept {
+        LargeHeader* header = static_cast<LargeHeader*>(ptr) - 1;
+        if (header->prev != nullptr) {
+            header->prev->next = header->next;
+        } else {
+            large_ = header->next;
+        }
+        if (header->next != nullptr) {
+            header->next->prev = header->prev;
+        }
+        std::byte* base = static_cast<std::byte*>(ptr) - header->offset;
+        upstream_->deallocate(base, header->size, header->alignment);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        return Allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        Deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    size_t slab_size_;
+    std::pmr::memory_resource* upstream_;
+    SizeClass classes_[kClassCount];
+    SlabRecord* slabs_ = nullptr;
+    LargeHeader* large_ = nullptr;
+    size_t slab_count_ = 0;
+};
+
+// Типизированный аллокатор поверх SizeClassPool для SimpleVector<Type, PoolAllocator<Type>>.
+// Рост буфера в пределах того же класса размеров происходит на месте (reallocate)
+template <typename Type>
+class PoolAllocator {
+public:
+    using value_type = Type;
+
+    static constexpr bool kCanReallocate = true;
+
+    PoolAllocator(SizeClassPool& pool) noexcept
+        : pool_(&pool)
+    {}
+
+    template <typename Other>
+    PoolAllocator(const PoolAllocator<Other>& other) noexcept
+        : pool_(other.GetPool())
+    {}
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        CheckSize(size);
+        return static_cast<Type*>(pool_->Allocate(size * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type* raw_ptr, size_t size) noexcept {
+        pool_->Deallocate(raw_ptr, size * sizeof(Type), alignof(Type));
+    }
+
+    // Оставляет блок на месте, если новый размер попадает в тот же класс,
+    // иначе переносит содержимое побайтово в новый блок
+    [[nodiscard]] Type* reallocate(Type* raw_ptr, size_t old_size, size_t new_size) {
+        CheckSize(new_size);
+        const size_t old_block = SizeClassPool::GetBlockSize(old_size * sizeof(Type), alignof(Type));
+        if (old_block != 0 && old_block == SizeClassPool::GetBlockSize(new_size * sizeof(Type), alignof(Type))) {
+            return raw_ptr;
+        }
+        Type* new_ptr = allocate(new_size);
+        std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(raw_ptr),
+                    (old_size < new_size ? old_size : new_size) * sizeof(Type));
+        deallocate(raw_ptr, old_size);
+        return new_ptr;
+    }
+
+    // Возвращает, сколько элементов помещается в блок, выданный под size элементов
+    size_t usable_size(Type* /*raw_ptr*/, size_t size) const noexcept {
+        const size_t block_size = SizeClassPool::GetBlockSize(size * sizeof(Type), alignof(Type));
+        return block_size != 0 ? block_size / sizeof(Type) : size;
+    }
+
+    SizeClassPool* GetPool() const noexcept {
+        return pool_;
+    }
+
+private:
+    static void CheckSize(size_t size) {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+    }
+
+    SizeClassPool* pool_;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const PoolAllocator<Lhs>& lhs, const PoolAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetPool() == rhs.GetPool();
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const PoolAllocator<Lhs>& lhs, const PoolAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
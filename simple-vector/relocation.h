@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_support.h"
+
+// Признак тривиальной перемещаемости: объект типа Type можно перенести в другое место
+// побайтовым копированием (memcpy/memmove/realloc), не вызывая ни конструктор перемещения
+// у нового объекта, ни деструктор у старого.
+// Для тривиально копируемых типов (int, double, POD-структуры) выполняется автоматически.
+// Свои типы подключаются явной специализацией, например:
+//     template <>
+//     struct IsTriviallyRelocatable<MyType> : std::true_type {};
+template <typename Type>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<Type>> {};
+
+// std::unique_ptr со стандартным удалителем хранит только указатель
+template <typename Type>
+struct IsTriviallyRelocatable<std::unique_ptr<Type>> : std::true_type {};
+
+template <typename Type>
+inline constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<std::remove_cv_t<Type>>::value;
+
+// Поэлементный перенос [first, last) в dest для вычисления при компиляции, где memcpy недоступен.
+// Для пересекающихся диапазонов со сдвигом вправо элементы переносятся с конца (from_end)
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void RelocateEach(Type* first, Type* last, Type* dest, bool from_end = false) noexcept {
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+    const std::ptrdiff_t count = last - first;
+    for (std::ptrdiff_t step = 0; step < count; ++step) {
+        const std::ptrdiff_t i = from_end ? count - 1 - step : step;
+        std::construct_at(dest + i, std::move(first[i]));
+        std::destroy_at(first + i);
+    }
+#else
+    (void)first;
+    (void)last;
+    (void)dest;
+    (void)from_end;
+#endif
+}
+
+// Переносит тривиально перемещаемые элементы [first, last) в сырую (непересекающуюся) память dest.
+// После вызова исходный диапазон считается сырой памятью
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void RelocateBytes(Type* first, Type* last, Type* dest) noexcept {
+    static_assert(kIsTriviallyRelocatable<Type>, "memcpy is valid only for trivially relocatable types");
+    if (IsConstantEvaluated()) {
+        RelocateEach(first, last, dest);
+        return;
+    }
+    if (first != last) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                    static_cast<size_t>(last - first) * sizeof(Type));
+    }
+}
+
+// Сдвигает тривиально перемещаемые элементы [first, last) на место, начинающееся с dest.
+// Диапазоны могут пересекаться; освободившиеся ячейки считаются сырой памятью
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void RelocateOverlapping(Type* first, Type* last, Type* dest) noexcept {
+    static_assert(kIsTriviallyRelocatable<Type>, "memmove is valid only for trivially relocatable types");
+    if (IsConstantEvaluated()) {
+        RelocateEach(first, last, dest, first < dest);
+        return;
+    }
+    if (first != last) {
+        std::memmove(static_cast<void*>(dest), static_cast<const void*>(first),
+                     static_cast<size_t>(last - first) * sizeof(Type));
+    }
+}
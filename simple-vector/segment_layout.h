@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+// Разбиение индексов на сегменты удваивающегося размера: сегмент 0 вмещает 2^FirstBits элементов,
+// каждый следующий - вдвое больше предыдущего. Номер сегмента и смещение в нём вычисляются
+// за O(1) по старшему биту индекса, а таблица из kCount сегментов покрывает весь диапазон size_t
+template <size_t FirstBits>
+struct SegmentLayout {
+    static constexpr size_t kCount = std::numeric_limits<size_t>::digits - FirstBits + 1;
+
+    // Номер сегмента, в котором лежит элемент index
+    static size_t SegmentOf(size_t index) noexcept {
+        const unsigned long long scaled = (index >> FirstBits) + 1;
+        return static_cast<size_t>(std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(scaled));
+    }
+
+    // Индекс первого элемента сегмента segment
+    static size_t SegmentBegin(size_t segment) noexcept {
+        return ((size_t{1} << segment) - 1) << FirstBits;
+    }
+
+    // Количество элементов в сегменте segment
+    static size_t SegmentSize(size_t segment) noexcept {
+        return size_t{1} << (segment + FirstBits);
+    }
+
+    // Количество сегментов, покрывающих элементы [0, size)
+    static size_t SegmentsFor(size_t size) noexcept {
+        return size == 0 ? 0 : SegmentOf(size - 1) + 1;
+    }
+};
@@ -0,0 +1,531 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "segment_layout.h"
+
+// Вектор, хранящий элементы в сегментах удваивающегося размера (16, 32, 64, ...).
+// При росте выделяется только новый сегмент, а существующие элементы не переносятся,
+// поэтому PushBack не копирует весь буфер, а ссылки, указатели и итераторы на элементы
+// остаются действительными при добавлении (до удаления этих элементов, Clear или ShrinkToFit).
+// Доступ по индексу - O(1): номер сегмента вычисляется по старшему биту индекса.
+// Итераторы произвольного доступа работают со стандартными алгоритмами.
+// Таблица сегментов хранится в самом объекте, поэтому перемещение и swap вектора
+// делают недействительными итераторы, но не ссылки на элементы
+template <typename Type, typename Alloc = DefaultAllocator<Type>>
+class SegmentedSimpleVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using Layout = SegmentLayout<4>;
+
+    template <typename ValueType>
+    class BasicIterator;
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+    using value_type = Type;
+    using allocator_type = Alloc;
+
+    // Создаёт пустой вектор, не выделяя память
+    SegmentedSimpleVector() noexcept(std::is_nothrow_default_constructible_v<Alloc>) = default;
+
+    explicit SegmentedSimpleVector(const Alloc& alloc) noexcept
+        : alloc_(alloc)
+    {}
+
+    // Создаёт вектор из size элементов, инициализированных значением value (или по умолчанию)
+    explicit SegmentedSimpleVector(size_t size, const Type& value = Type(), const Alloc& alloc = Alloc())
+        : SegmentedSimpleVector(alloc)
+    {
+        Reserve(size);
+        ForEachChunk(0, size, [&](Type* chunk, size_t count) {
+            UninitializedFillN(alloc_, chunk, count, value);
+            size_ += count;
+        });
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SegmentedSimpleVector(std::initializer_list<Type> init, const Alloc& alloc = Alloc())
+        : SegmentedSimpleVector(alloc)
+    {
+        Append(init.begin(), init.end());
+    }
+
+    // Создаёт копию другого вектора (конструктор копирования)
+    SegmentedSimpleVector(const SegmentedSimpleVector& other)
+        : SegmentedSimpleVector(AllocTraits::select_on_container_copy_construction(other.alloc_))
+    {
+        Append(other.begin(), other.end());
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Забирает сегменты other за O(1)
+    SegmentedSimpleVector(SegmentedSimpleVector&& other) noexcept
+        : alloc_(other.alloc_)
+    {
+        TakeFrom(other);
+    }
+
+    // Оператор присваивания копированием
+    SegmentedSimpleVector& operator=(const SegmentedSimpleVector& rhs) {
+        if (this != &rhs) {
+            SegmentedSimpleVector tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Оператор присваивания перемещением
+    SegmentedSimpleVector& operator=(SegmentedSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            FreeSegments(0);
+            alloc_ = rhs.alloc_;
+            TakeFrom(rhs);
+        }
+        return *this;
+    }
+
+    ~SegmentedSimpleVector() {
+        Clear();
+        FreeSegments(0);
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость выделенных сегментов
+    size_t GetCapacity() const noexcept {
+        return Layout::SegmentBegin(segment_count_);
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает копию аллокатора вектора
+    Alloc GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return *Slot(index);
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return *Slot(index);
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return *Slot(index);
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return *Slot(index);
+    }
+
+    // Разрушает все элементы и обнуляет размер массива, не освобождая сегменты
+    void Clear() noexcept {
+        Truncate(0);
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            Truncate(new_size);
+            return;
+        }
+        Reserve(new_size);
+        ForEachChunk(size_, new_size, [&](Type* chunk, size_t count) {
+            UninitializedValueConstructN(alloc_, chunk, count);
+            size_ += count;
+        });
+    }
+
+    // Выделяет сегменты под new_capacity элементов. Существующие элементы не переносятся
+    void Reserve(size_t new_capacity) {
+        const size_t needed = Layout::SegmentsFor(new_capacity);
+        while (segment_count_ < needed) {
+            segments_[segment_count_] = AllocTraits::allocate(alloc_, Layout::SegmentSize(segment_count_));
+            ++segment_count_;
+        }
+    }
+
+    // Освобождает сегменты, в которых нет элементов
+    void ShrinkToFit() noexcept {
+        FreeSegments(Layout::SegmentsFor(size_));
+    }
+
+    // Итераторы произвольного доступа
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Добавляет элемент в конец вектора
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args.
+    // Аргументы могут ссылаться на элементы самого вектора: рост их не переносит.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        Reserve(size_ + 1);
+        Type* slot = Slot(size_);
+        ConstructAt(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    // Добавляет элементы [first, last) в конец вектора
+    template <typename InputIt>
+    void Append(InputIt first, InputIt last) {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>) {
+            Reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+    }
+
+    // Вставляет значение value в позицию pos, сдвигая хвост.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Вставляет значение value в позицию pos, сдвигая хвост.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = IndexOf(pos);
+        EmplaceBack(std::forward<Args>(args)...);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        --size_;
+        DestroyAt(alloc_, Slot(size_));
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    // Возвращает итератор на, следующий после удалённого, элемент
+    Iterator Erase(ConstIterator pos) {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        return Erase(pos, std::next(pos));
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост вектора один раз
+    // Возвращает итератор на элемент, следующий за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t index = IndexOf(first);
+        const size_t count = static_cast<size_t>(last - first);
+        assert((index + count <= size_) && "Error: Out of range!");
+        std::move(begin() + index + count, end(), begin() + index);
+        Truncate(size_ - count);
+        return begin() + index;
+    }
+
+    // Удаляет все элементы, для которых pred возвращает true, за один проход.
+    // Возвращает количество удалённых элементов
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        const size_t new_size = static_cast<size_t>(std::remove_if(begin(), end(), pred) - begin());
+        const size_t count = size_ - new_size;
+        Truncate(new_size);
+        return count;
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SegmentedSimpleVector& other) noexcept {
+        std::swap(alloc_, other.alloc_);
+        std::swap(segments_, other.segments_);
+        std::swap(segment_count_, other.segment_count_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    // Итератор произвольного доступа. Помнит границы текущего сегмента, поэтому
+    // последовательный проход внутри сегмента не пересчитывает номер сегмента
+    template <typename ValueType>
+    class BasicIterator {
+        using Owner = std::conditional_t<std::is_const_v<ValueType>,
+                                         const SegmentedSimpleVector, SegmentedSimpleVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {}
+
+        // Неконстантный итератор приводится к константному
+        template <typename Other, typename = std::enable_if_t<std::is_const_v<ValueType> && !std::is_const_v<Other>>>
+        BasicIterator(const BasicIterator<Other>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return *Current();
+        }
+
+        pointer operator->() const noexcept {
+            return Current();
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ = static_cast<size_t>(static_cast<difference_type>(index_) + offset);
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            return *this += -offset;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+        // Возвращает индекс элемента, на который указывает итератор
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+    private:
+        template <typename>
+        friend class BasicIterator;
+
+        // Адрес элемента; при выходе за запомненный сегмент границы пересчитываются
+        pointer Current() const noexcept {
+            if (index_ - segment_begin_ >= segment_end_ - segment_begin_) {
+                const size_t segment = Layout::SegmentOf(index_);
+                segment_begin_ = Layout::SegmentBegin(segment);
+                segment_end_ = segment_begin_ + Layout::SegmentSize(segment);
+                items_ = owner_->segments_[segment];
+            }
+            return items_ + (index_ - segment_begin_);
+        }
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+        mutable pointer items_ = nullptr;
+        mutable size_t segment_begin_ = 0;
+        mutable size_t segment_end_ = 0;
+    };
+
+    Type* Slot(size_t index) const noexcept {
+        const size_t segment = Layout::SegmentOf(index);
+        return segments_[segment] + (index - Layout::SegmentBegin(segment));
+    }
+
+    size_t IndexOf(ConstIterator pos) const noexcept {
+        assert((pos.GetIndex() <= size_) && "Error: Out of range!");
+        return pos.GetIndex();
+    }
+
+    // Вызывает func(chunk, count) для частей диапазона индексов [first, last),
+    // лежащих в одном сегменте, по порядку
+    template <typename Func>
+    void ForEachChunk(size_t first, size_t last, Func func) const {
+        while (first < last) {
+            const size_t segment = Layout::SegmentOf(first);
+            const size_t segment_end = std::min(last, Layout::SegmentBegin(segment + 1));
+            func(Slot(first), segment_end - first);
+            first = segment_end;
+        }
+    }
+
+    // Разрушает элементы с индексами [new_size, size)
+    void Truncate(size_t new_size) noexcept {
+        ForEachChunk(new_size, size_, [this](Type* chunk, size_t count) {
+            DestroyRange(alloc_, chunk, chunk + count);
+        });
+        size_ = std::min(size_, new_size);
+    }
+
+    // Освобождает сегменты, начиная с first. В них не должно быть элементов
+    void FreeSegments(size_t first) noexcept {
+        while (segment_count_ > first) {
+            --segment_count_;
+            AllocTraits::deallocate(alloc_, segments_[segment_count_], Layout::SegmentSize(segment_count_));
+            segments_[segment_count_] = nullptr;
+        }
+    }
+
+    void TakeFrom(SegmentedSimpleVector& other) noexcept {
+        std::copy(std::begin(other.segments_), std::end(other.segments_), std::begin(segments_));
+        std::fill(std::begin(other.segments_), std::end(other.segments_), nullptr);
+        segment_count_ = std::exchange(other.segment_count_, 0);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    Alloc alloc_;
+    Type* segments_[Layout::kCount] = {};
+    size_t segment_count_ = 0;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename Alloc>
+inline bool operator==(const SegmentedSimpleVector<Type, Alloc>& lhs, const SegmentedSimpleVector<Type, Alloc>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Alloc>
+inline bool operator!=(const SegmentedSimpleVector<Type, Alloc>& lhs, const SegmentedSimpleVector<Type, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Alloc>
+inline bool operator<(const SegmentedSimpleVector<Type, Alloc>& lhs, const SegmentedSimpleVector<Type, Alloc>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Alloc>
+inline bool operator<=(const SegmentedSimpleVector<Type, Alloc>& lhs, const SegmentedSimpleVector<Type, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Alloc>
+inline bool operator>(const SegmentedSimpleVector<Type, Alloc>& lhs, const SegmentedSimpleVector<Type, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Alloc>
+inline bool operator>=(const SegmentedSimpleVector<Type, Alloc>& lhs, const SegmentedSimpleVector<Type, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "simple_vector.h"
+
+// Двоичный формат SimpleVector: заголовок SerializedHeader, за которым следуют элементы.
+// Тривиально копируемые элементы записываются одним блоком байтов в порядке байтов записавшей машины
+// (без накладных расходов на элемент), остальные - по одному через Serializer<Type>.
+// Чтение проверяет сигнатуру, версию, порядок байтов и размер элемента
+
+// Заголовок потока. Все поля, кроме однобайтовых, записаны в порядке байтов записавшей машины
+struct SerializedHeader {
+    static constexpr char kMagic[4] = {'S', 'V', 'E', 'C'};
+    static constexpr uint16_t kVersion = 1;
+    static constexpr uint8_t kLittleEndian = 1;
+    static constexpr uint8_t kBigEndian = 2;
+    // Флаг: элементы записаны одним блоком байтов
+    static constexpr uint8_t kRawElements = 1;
+
+    char magic[4] = {'S', 'V', 'E', 'C'};
+    uint16_t version = kVersion;
+    uint8_t endianness = 0;
+    uint8_t flags = 0;
+    uint32_t element_size = 0;
+    uint32_t reserved = 0;
+    uint64_t count = 0;
+};
+
+static_assert(sizeof(SerializedHeader) == 24 && std::is_trivially_copyable_v<SerializedHeader>,
+              "SerializedHeader is written as raw bytes");
+
+// Точка расширения: сериализация элементов, которые нельзя записать побайтно.
+// Свои типы подключаются явной специализацией, например:
+//     template <>
+//     struct Serializer<MyType> {
+//         static void Write(std::ostream& out, const MyType& item);
+//         static void Read(std::istream& in, MyType& item);
+//     };
+template <typename Type, typename = void>
+struct Serializer;
+
+namespace serialization_detail {
+
+// Наибольший блок одного системного вызова (Linux переносит не более 0x7ffff000 байт за раз)
+inline constexpr size_t kMaxIoChunk = size_t{1} << 30;
+
+// Первая порция чтения. Число элементов в потоке не проверено, поэтому память под них
+// выделяется по мере прихода данных: каждая следующая порция не больше уже прочитанного,
+// и поддельный заголовок не заставит выделить больше, чем вдвое от реально полученных байтов
+inline constexpr size_t kFirstReadChunkBytes = size_t{1} << 20;
+
+// Возвращает, сколько элементов Type читать следующей порцией, если done уже прочитано, а remaining осталось
+template <typename Type>
+size_t NextReadChunk(size_t done, size_t remaining) noexcept {
+    return std::min(remaining, std::max({done, kFirstReadChunkBytes / sizeof(Type), size_t{1}}));
+}
+
+inline constexpr uint8_t NativeEndianness() noexcept {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return SerializedHeader::kBigEndian;
+#else
+    return SerializedHeader::kLittleEndian;
+#endif
+}
+
+inline void WriteBytes(std::ostream& out, const void* data, size_t bytes) {
+    const char* first = static_cast<const char*>(data);
+    while (bytes > 0) {
+        const size_t chunk = std::min(bytes, kMaxIoChunk);
+        if (!out.write(first, static_cast<std::streamsize>(chunk))) {
+            throw std::runtime_error("Error: Failed to write vector!");
+        }
+        first += chunk;
+        bytes -= chunk;
+    }
+}
+
+inline void ReadBytes(std::istream& in, void* data, size_t bytes) {
+    char* first = static_cast<char*>(data);
+    while (bytes > 0) {
+        const size_t chunk = std::min(bytes, kMaxIoChunk);
+        if (!in.read(first, static_cast<std::streamsize>(chunk))) {
+            throw std::runtime_error("Error: Unexpected end of vector data!");
+        }
+        first += chunk;
+        bytes -= chunk;
+    }
+}
+
+template <typename Type>
+SerializedHeader MakeHeader(size_t count) noexcept {
+    SerializedHeader header;
+    header.endianness = NativeEndianness();
+    header.flags = std::is_trivially_copyable_v<Type> ? SerializedHeader::kRawElements : 0;
+    header.element_size = static_cast<uint32_t>(sizeof(Type));
+    header.count = count;
+    return header;
+}
+
+// Проверяет, что заголовок описывает вектор элементов Type, записанный совместимой машиной
+template <typename Type>
+void CheckHeader(const SerializedHeader& header) {
+    if (std::memcmp(header.magic, SerializedHeader::kMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Error: Not a serialized vector!");
+    }
+    if (header.endianness != NativeEndianness()) {
+        throw std::runtime_error("Error: Byte order of serialized vector does not match!");
+    }
+    if (header.version > SerializedHeader::kVersion) {
+        throw std::runtime_error("Error: Unsupported serialized vector version!");
+    }
+    const bool raw = (header.flags & SerializedHeader::kRawElements) != 0;
+    if (raw != std::is_trivially_copyable_v<Type> || (raw && header.element_size != sizeof(Type))) {
+        throw std::runtime_error("Error: Serialized element type does not match!");
+    }
+    if (header.count > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+        throw std::length_error("Error: Serialized vector is too long!");
+    }
+}
+
+template <typename Type>
+SerializedHeader ReadHeader(std::istream& in) {
+    SerializedHeader header;
+    ReadBytes(in, &header, sizeof(header));
+    CheckHeader<Type>(header);
+    return header;
+}
+
+// Записывает count элементов, начиная с data, без заголовка
+template <typename Type>
+void WriteElements(std::ostream& out, const Type* data, size_t count) {
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        WriteBytes(out, data, count * sizeof(Type));
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            Serializer<Type>::Write(out, data[i]);
+        }
+    }
+}
+
+// Дописывает в пустой vector count элементов из потока порциями (см. NextReadChunk).
+// Если поток обрывается, vector содержит только полностью прочитанные элементы
+template <typename Type, typename Alloc, typename Growth>
+void ReadElementsInto(std::istream& in, SimpleVector<Type, Alloc, Growth>& vector, size_t count) {
+    assert(vector.IsEmpty());
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        size_t done = 0;
+        while (done < count) {
+            const size_t chunk = NextReadChunk<Type>(done, count - done);
+            vector.ResizeForOverwrite(done + chunk);
+            try {
+                ReadBytes(in, vector.begin() + done, chunk * sizeof(Type));
+            }
+            catch (...) {
+                vector.ResizeForOverwrite(done);
+                throw;
+            }
+            done += chunk;
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            Type item{};
+            Serializer<Type>::Read(in, item);
+            vector.PushBack(std::move(item));
+        }
+    }
+}
+
+// Заменяет содержимое vector count элементами из потока.
+// Элементы читаются во временный вектор, поэтому при ошибке vector не меняется
+template <typename Type, typename Alloc, typename Growth>
+void ReadElements(std::istream& in, SimpleVector<Type, Alloc, Growth>& vector, size_t count) {
+    SimpleVector<Type, Alloc, Growth> result(vector.GetAllocator());
+    ReadElementsInto(in, result, count);
+    vector.swap(result);
+}
+
+} // namespace serialization_detail
+
+// Тривиально копируемые значения записываются как есть
+template <typename Type>
+struct Serializer<Type, std::enable_if_t<std::is_trivially_copyable_v<Type>>> {
+    static void Write(std::ostream& out, const Type& item) {
+        serialization_detail::WriteBytes(out, &item, sizeof(Type));
+    }
+
+    static void Read(std::istream& in, Type& item) {
+        serialization_detail::ReadBytes(in, &item, sizeof(Type));
+    }
+};
+
+// Строка: длина (uint64_t), затем символы
+template <>
+struct Serializer<std::string> {
+    static void Write(std::ostream& out, const std::string& item) {
+        Serializer<uint64_t>::Write(out, item.size());
+        serialization_detail::WriteBytes(out, item.data(), item.size());
+    }
+
+    // Длина не проверена, поэтому строка растёт порциями по мере прихода символов
+    static void Read(std::istream& in, std::string& item) {
+        uint64_t size = 0;
+        Serializer<uint64_t>::Read(in, size);
+        if (size > item.max_size()) {
+            throw std::length_error("Error: Serialized string is too long!");
+        }
+        std::string result;
+        size_t done = 0;
+        while (done < size) {
+            const size_t chunk = serialization_detail::NextReadChunk<char>(done, static_cast<size_t>(size) - done);
+            result.resize(done + chunk);
+            serialization_detail::ReadBytes(in, result.data() + done, chunk);
+            done += chunk;
+        }
+        item.swap(result);
+    }
+};
+
+// Вложенный вектор: число элементов (uint64_t), затем элементы
+template <typename Type, typename Alloc, typename Growth>
+struct Serializer<SimpleVector<Type, Alloc, Growth>> {
+    static void Write(std::ostream& out, const SimpleVector<Type, Alloc, Growth>& item) {
+        Serializer<uint64_t>::Write(out, item.GetSize());
+        serialization_detail::WriteElements(out, item.begin(), item.GetSize());
+    }
+
+    static void Read(std::istream& in, SimpleVector<Type, Alloc, Growth>& item) {
+        uint64_t size = 0;
+        Serializer<uint64_t>::Read(in, size);
+        serialization_detail::ReadElements(in, item, size);
+    }
+};
+
+// Записывает вектор в поток: заголовок и элементы
+template <typename Type, typename Alloc, typename Growth>
+void Serialize(std::ostream& out, const SimpleVector<Type, Alloc, Growth>& vector) {
+    const SerializedHeader header = serialization_detail::MakeHeader<Type>(vector.GetSize());
+    serialization_detail::WriteBytes(out, &header, sizeof(header));
+    serialization_detail::WriteElements(out, vector.begin(), vector.GetSize());
+}
+
+// Заменяет содержимое vector вектором, прочитанным из потока.
+// Выбрасывает std::runtime_error, если поток повреждён или записан для другого типа или машины;
+// в этом случае vector не меняется
+template <typename Type, typename Alloc, typename Growth>
+void Deserialize(std::istream& in, SimpleVector<Type, Alloc, Growth>& vector) {
+    const SerializedHeader header = serialization_detail::ReadHeader<Type>(in);
+    serialization_detail::ReadElements(in, vector, static_cast<size_t>(header.count));
+}
+
+// Записывает вектор тривиально копируемых элементов в файловый дескриптор.
+// Заголовок и данные уходят одним writev (большие буферы - блоками не более kMaxIoChunk)
+template <typename Type, typename Alloc, typename Growth>
+void WriteToFd(int fd, const SimpleVector<Type, Alloc, Growth>& vector) {
+    static_assert(std::is_trivially_copyable_v<Type>, "WriteToFd writes elements as raw bytes");
+    SerializedHeader header = serialization_detail::MakeHeader<Type>(vector.GetSize());
+    SimpleVector<iovec> iov;
+    iov.PushBack(iovec{&header, sizeof(header)});
+    char* data = reinterpret_cast<char*>(const_cast<Type*>(vector.begin()));
+    for (size_t offset = 0, bytes = vector.GetSize() * sizeof(Type); offset < bytes;
+         offset += serialization_detail::kMaxIoChunk) {
+        iov.PushBack(iovec{data + offset, std::min(bytes - offset, serialization_detail::kMaxIoChunk)});
+    }
+
+    iovec* first = iov.begin();
+    while (first != iov.end()) {
+        const int iov_count = static_cast<int>(std::min<ptrdiff_t>(iov.end() - first, IOV_MAX));
+        const ssize_t written = ::writev(fd, first, iov_count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Error: writev");
+        }
+        // Пропускаем записанное, частично записанный блок продолжится со своей середины
+        size_t done = static_cast<size_t>(written);
+        while (first != iov.end() && done >= first->iov_len) {
+            done -= first->iov_len;
+            ++first;
+        }
+        if (first != iov.end()) {
+            first->iov_base = static_cast<char*>(first->iov_base) + done;
+            first->iov_len -= done;
+        }
+    }
+}
+
+// Заменяет содержимое vector вектором, прочитанным из файлового дескриптора.
+// Данные читаются через readv во временный вектор, растущий порциями (см. NextReadChunk),
+// блоками не более kMaxIoChunk; при ошибке vector не меняется
+template <typename Type, typename Alloc, typename Growth>
+void ReadFromFd(int fd, SimpleVector<Type, Alloc, Growth>& vector) {
+    static_assert(std::is_trivially_copyable_v<Type>, "ReadFromFd reads elements as raw bytes");
+    auto read_all = [fd](iovec* first, iovec* last) {
+        while (first != last) {
+            const int iov_count = static_cast<int>(std::min<ptrdiff_t>(last - first, IOV_MAX));
+            const ssize_t received = ::readv(fd, first, iov_count);
+            if (received < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "Error: readv");
+            }
+            if (received == 0) {
+                throw std::runtime_error("Error: Unexpected end of vector data!");
+            }
+            size_t done = static_cast<size_t>(received);
+            while (first != last && done >= first->iov_len) {
+                done -= first->iov_len;
+                ++first;
+            }
+            if (first != last) {
+                first->iov_base = static_cast<char*>(first->iov_base) + done;
+                first->iov_len -= done;
+            }
+        }
+    };
+
+    SerializedHeader header;
+    iovec header_iov{&header, sizeof(header)};
+    read_all(&header_iov, &header_iov + 1);
+    serialization_detail::CheckHeader<Type>(header);
+
+    const size_t count = static_cast<size_t>(header.count);
+    SimpleVector<Type, Alloc, Growth> result(vector.GetAllocator());
+    SimpleVector<iovec> iov;
+    for (size_t done = 0; done < count;) {
+        const size_t chunk = serialization_detail::NextReadChunk<Type>(done, count - done);
+        result.ResizeForOverwrite(done + chunk);
+        iov.Clear();
+        char* data = reinterpret_cast<char*>(result.begin() + done);
+        for (size_t offset = 0, bytes = chunk * sizeof(Type); offset < bytes;
+             offset += serialization_detail::kMaxIoChunk) {
+            iov.PushBack(iovec{data + offset, std::min(bytes - offset, serialization_detail::kMaxIoChunk)});
+        }
+        read_all(iov.begin(), iov.end());
+        done += chunk;
+    }
+    vector.swap(result);
+}
+
+// Потоковое чтение вектора частями фиксированного размера: в памяти находится только
+// текущая часть, поэтому так можно обработать файл больше оперативной памяти
+template <typename Type>
+class ChunkedVectorReader {
+public:
+    // Читает и проверяет заголовок. Поток должен жить дольше читателя
+    explicit ChunkedVectorReader(std::istream& in)
+        : in_(in)
+        , count_(static_cast<size_t>(serialization_detail::ReadHeader<Type>(in).count))
+        , remaining_(count_)
+    {}
+
+    // Возвращает общее число элементов в потоке
+    size_t GetCount() const noexcept {
+        return count_;
+    }
+
+    // Возвращает число ещё не прочитанных элементов
+    size_t GetRemaining() const noexcept {
+        return remaining_;
+    }
+
+    // Заменяет содержимое chunk следующими не более чем max_elements (> 0) элементами.
+    // Вместимость chunk переиспользуется между вызовами, поэтому при ошибке чтения chunk остаётся пустым.
+    // Возвращает false (и оставляет chunk пустым), если элементов больше нет
+    template <typename Alloc, typename Growth>
+    bool ReadChunk(SimpleVector<Type, Alloc, Growth>& chunk, size_t max_elements) {
+        assert((max_elements > 0) && "Error: Empty chunk!");
+        const size_t count = std::min(remaining_, max_elements);
+        if (count == 0) {
+            chunk.Clear();
+            return false;
+        }
+        chunk.Clear();
+        try {
+            serialization_detail::ReadElementsInto(in_, chunk, count);
+        }
+        catch (...) {
+            chunk.Clear();
+            throw;
+        }
+        remaining_ -= count;
+        return true;
+    }
+
+private:
+    std::istream& in_;
+    size_t count_;
+    size_t remaining_;
+};
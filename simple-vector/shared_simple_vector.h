@@ -0,0 +1,370 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Вектор с копированием при записи (copy-on-write).
+// Копии разделяют один буфер со счётчиком ссылок, поэтому копирование стоит O(1) и не выделяет память.
+// Первый изменяющий вызов (неконстантные operator[], At, begin/end, PushBack, Insert, Erase и т.д.)
+// у копии, чей буфер разделён, сначала клонирует буфер (Unshare). Константные методы буфер не клонируют.
+// Как и std::shared_ptr, разные объекты с общим буфером можно читать и изменять из разных потоков
+// без синхронизации; один и тот же объект из нескольких потоков - только читать.
+// Ссылки и итераторы, полученные до клонирования, продолжают указывать в старый буфер.
+// Выданная изменяемая ссылка или итератор делает буфер неразделяемым (как «утёкшая» строка в старой
+// COW-реализации std::string): следующие копии клонируют его сразу, чтобы запись через эту ссылку
+// не была видна в копиях. Буфер снова разделяем, когда его сменяет новый (клон, Clear, присваивание)
+template <typename Type, typename Alloc = DefaultAllocator<Type>, typename Growth = DoublingGrowth>
+class SharedSimpleVector {
+public:
+    using Vector = SimpleVector<Type, Alloc, Growth>;
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using value_type = Type;
+    using allocator_type = Alloc;
+
+    // Создаёт пустой вектор, не выделяя память
+    SharedSimpleVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением value (или по умолчанию)
+    explicit SharedSimpleVector(size_t size, const Type& value = Type())
+        : block_(size > 0 ? new Block(Vector(size, value)) : nullptr)
+    {}
+
+    // Создаёт вектор из std::initializer_list
+    SharedSimpleVector(std::initializer_list<Type> init)
+        : block_(init.size() > 0 ? new Block(Vector(init)) : nullptr)
+    {}
+
+    // Забирает содержимое обычного вектора без копирования элементов
+    explicit SharedSimpleVector(Vector&& vector)
+        : block_(!vector.IsEmpty() ? new Block(std::move(vector)) : nullptr)
+    {}
+
+    // Создаёт копию, разделяющую буфер с other, за O(1).
+    // Если у other выданы изменяемые ссылки на элементы, буфер клонируется
+    SharedSimpleVector(const SharedSimpleVector& other)
+        : block_(other.block_ != nullptr && other.block_->unshareable ? new Block(Vector(other.block_->vector))
+                                                                       : other.block_)
+    {
+        if (block_ == other.block_) {
+            AddRef();
+        }
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Забирает буфер other
+    SharedSimpleVector(SharedSimpleVector&& other) noexcept
+        : block_(std::exchange(other.block_, nullptr))
+    {}
+
+    // Начинает разделять буфер rhs за O(1) (или клонирует его, см. конструктор копирования)
+    SharedSimpleVector& operator=(const SharedSimpleVector& rhs) {
+        SharedSimpleVector tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Забирает буфер rhs
+    SharedSimpleVector& operator=(SharedSimpleVector&& rhs) noexcept {
+        SharedSimpleVector tmp(std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~SharedSimpleVector() {
+        Release();
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return block_ != nullptr ? block_->vector.GetSize() : 0;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept {
+        return block_ != nullptr ? block_->vector.GetCapacity() : 0;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Возвращает количество векторов, разделяющих буфер (0 для вектора без буфера)
+    size_t UseCount() const noexcept {
+        return block_ != nullptr ? block_->refs.load(std::memory_order_acquire) : 0;
+    }
+
+    // Сообщает, разделяет ли вектор буфер с другими векторами
+    bool IsShared() const noexcept {
+        return UseCount() > 1;
+    }
+
+    // Делает буфер собственным: если он разделён, клонирует его
+    void Unshare() {
+        MakeUnique(0);
+    }
+
+    // Возвращает константную ссылку на вектор с элементами, не клонируя буфер
+    const Vector& Get() const noexcept {
+        return block_ != nullptr ? block_->vector : EmptyVector();
+    }
+
+    // Возвращает ссылку на собственный вектор с элементами, при необходимости клонируя буфер.
+    // Буфер становится неразделяемым: следующие копии клонируют его
+    Vector& GetMutable() {
+        MakeUnique(0);
+        block_->unshareable = true;
+        return block_->vector;
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return block_->vector[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index, при необходимости клонируя буфер
+    Type& operator[](size_t index) {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return GetMutable()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return block_->vector[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index, при необходимости клонируя буфер
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return GetMutable()[index];
+    }
+
+    // Неконстантные итераторы позволяют изменять элементы, поэтому клонируют разделённый буфер
+    // и делают его неразделяемым
+    Iterator begin() {
+        return block_ != nullptr ? GetMutable().begin() : nullptr;
+    }
+
+    Iterator end() {
+        return block_ != nullptr ? GetMutable().end() : nullptr;
+    }
+
+    ConstIterator begin() const noexcept {
+        return Get().begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return Get().end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return Get().begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return Get().end();
+    }
+
+    // Удаляет все элементы. Разделённый буфер не клонируется, а просто отпускается.
+    // Ссылок на элементы не остаётся, поэтому буфер снова разделяем
+    void Clear() noexcept {
+        if (IsShared()) {
+            Release();
+        } else if (block_ != nullptr) {
+            block_->vector.Clear();
+            block_->unshareable = false;
+        }
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        MakeUnique(new_size > GetSize() ? new_size - GetSize() : 0);
+        block_->vector.Resize(new_size);
+    }
+
+    // Резервирует ёмкость. Разделённый буфер клонируется сразу с нужной ёмкостью
+    void Reserve(size_t new_capacity) {
+        MakeUnique(new_capacity > GetSize() ? new_capacity - GetSize() : 0);
+        block_->vector.Reserve(new_capacity);
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const Type& item) {
+        MakeUnique(1);
+        block_->vector.PushBack(item);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Добавляет элемент в конец вектора
+    void PushBack(Type&& item) {
+        MakeUnique(1);
+        block_->vector.PushBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        MakeUnique(1);
+        block_->unshareable = true;
+        return block_->vector.EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        const size_t index = IndexOf(pos);
+        MakeUnique(1);
+        block_->unshareable = true;
+        return block_->vector.Insert(block_->vector.cbegin() + index, value);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t index = IndexOf(pos);
+        MakeUnique(1);
+        block_->unshareable = true;
+        return block_->vector.Insert(block_->vector.cbegin() + index, std::move(value));
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        MakeUnique(0);
+        block_->vector.PopBack();
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    // Возвращает итератор на, следующий после удалённого, элемент
+    Iterator Erase(ConstIterator pos) {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last)
+    // Возвращает итератор на элемент, следующий за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t index = IndexOf(first);
+        const size_t count = static_cast<size_t>(last - first);
+        MakeUnique(0);
+        block_->unshareable = true;
+        ConstIterator new_first = block_->vector.cbegin() + index;
+        return block_->vector.Erase(new_first, new_first + count);
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SharedSimpleVector& other) noexcept {
+        std::swap(block_, other.block_);
+    }
+
+private:
+    // Буфер вместе со счётчиком векторов, которые его разделяют.
+    // unshareable меняет только единственный владелец буфера, поэтому атомарность не нужна
+    struct Block {
+        explicit Block(Vector&& data)
+            : vector(std::move(data))
+        {}
+
+        std::atomic<size_t> refs{1};
+        bool unshareable = false;
+        Vector vector;
+    };
+
+    static const Vector& EmptyVector() noexcept {
+        static const Vector empty;
+        return empty;
+    }
+
+    size_t IndexOf(ConstIterator pos) const noexcept {
+        assert((pos >= cbegin() && pos <= cend()) && "Error: Out of range!");
+        return static_cast<size_t>(pos - cbegin());
+    }
+
+    void AddRef() const noexcept {
+        if (block_ != nullptr) {
+            block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Отпускает буфер; последний владелец его разрушает
+    void Release() noexcept {
+        if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete block_;
+        }
+        block_ = nullptr;
+    }
+
+    // Обеспечивает собственный буфер. Разделённый буфер клонируется с запасом extra элементов,
+    // чтобы следующая за клонированием вставка не перевыделяла память ещё раз
+    void MakeUnique(size_t extra) {
+        if (block_ == nullptr) {
+            block_ = new Block(Vector());
+            return;
+        }
+        if (block_->refs.load(std::memory_order_acquire) == 1) {
+            return;
+        }
+        const Vector& shared = block_->vector;
+        Vector copy(::Reserve(shared.GetSize() + extra), shared.GetAllocator());
+        copy.Insert(copy.cend(), shared.begin(), shared.end());
+        Block* unique = new Block(std::move(copy));
+        Release();
+        block_ = unique;
+    }
+
+    Block* block_ = nullptr;
+};
+
+template <typename Type, typename Alloc, typename Growth>
+inline bool operator==(const SharedSimpleVector<Type, Alloc, Growth>& lhs,
+                       const SharedSimpleVector<Type, Alloc, Growth>& rhs) {
+    return lhs.Get() == rhs.Get();
+}
+
+template <typename Type, typename Alloc, typename Growth>
+inline bool operator!=(const SharedSimpleVector<Type, Alloc, Growth>& lhs,
+                       const SharedSimpleVector<Type, Alloc, Growth>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Alloc, typename Growth>
+inline bool operator<(const SharedSimpleVector<Type, Alloc, Growth>& lhs,
+                      const SharedSimpleVector<Type, Alloc, Growth>& rhs) {
+    return lhs.Get() < rhs.Get();
+}
+
+template <typename Type, typename Alloc, typename Growth>
+inline bool operator<=(const SharedSimpleVector<Type, Alloc, Growth>& lhs,
+                       const SharedSimpleVector<Type, Alloc, Growth>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Alloc, typename Growth>
+inline bool operator>(const SharedSimpleVector<Type, Alloc, Growth>& lhs,
+                      const SharedSimpleVector<Type, Alloc, Growth>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Alloc, typename Growth>
+inline bool operator>=(const SharedSimpleVector<Type, Alloc, Growth>& lhs,
+                       const SharedSimpleVector<Type, Alloc, Growth>& rhs) {
+    return !(lhs < rhs);
+}
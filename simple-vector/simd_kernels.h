@@ -0,0 +1,670 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+
+// Векторные (SIMD) ядра для массивов int32_t, uint8_t, float и double:
+// заполнение, поиск, подсчёт, минимум, максимум, сумма, поиск первого расхождения,
+// а также побитовые операции, подсчёт и распаковка битов над массивами 64-битных слов.
+// Набор инструкций (SSE4.2, AVX2 или AVX-512) выбирается при выполнении по cpuid;
+// на других процессорах и компиляторах используется скалярная реализация.
+// Ядра собираются через #pragma GCC target, поэтому весь проект можно компилировать без -mavx2
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define SIMPLE_VECTOR_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define SIMPLE_VECTOR_X86_SIMD 0
+#endif
+
+// Уровень набора векторных инструкций
+enum class SimdLevel {
+    kScalar,
+    kSse42,
+    kAvx2,
+    kAvx512,
+};
+
+// Определяет лучший набор инструкций, поддерживаемый процессором
+inline SimdLevel DetectSimdLevel() noexcept {
+#if SIMPLE_VECTOR_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SimdLevel::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::kAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+        return SimdLevel::kSse42;
+    }
+#endif
+    return SimdLevel::kScalar;
+}
+
+namespace simd_detail {
+
+inline SimdLevel& ActiveSimdLevel() noexcept {
+    static SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+} // namespace simd_detail
+
+// Возвращает набор инструкций, которым пользуются ядра
+inline SimdLevel GetSimdLevel() noexcept {
+    return simd_detail::ActiveSimdLevel();
+}
+
+// Ограничивает ядра набором инструкций level (например, для сравнения со скалярной реализацией).
+// Уровень выше поддерживаемого процессором понижается до поддерживаемого
+inline void SetSimdLevel(SimdLevel level) noexcept {
+    simd_detail::ActiveSimdLevel() = std::min(level, DetectSimdLevel());
+}
+
+// Признак типа, для которого есть векторные ядра
+template <typename Type>
+struct HasSimdKernels : std::bool_constant<std::is_same_v<Type, int32_t> || std::is_same_v<Type, uint8_t>
+                                           || std::is_same_v<Type, float> || std::is_same_v<Type, double>> {};
+
+template <typename Type>
+inline constexpr bool kHasSimdKernels = HasSimdKernels<std::remove_cv_t<Type>>::value;
+
+// Тип суммы элементов: целые суммируются в 64 бита без переполнения
+template <typename Type>
+using SimdSumType = std::conditional_t<std::is_floating_point_v<Type>, Type,
+                                       std::conditional_t<std::is_signed_v<Type>, int64_t, uint64_t>>;
+
+// Побитовая операция над массивами слов
+enum class BitOp {
+    kAnd,
+    kOr,
+    kXor,
+};
+
+// Количество чередующихся потоков в упаковке битов: значение i лежит в потоке i % 4,
+// а слово j потока s - в packed[4 * j + s]. Четыре соседних значения имеют одинаковое
+// смещение в своих потоках, поэтому распаковываются одним сдвигом регистра
+inline constexpr size_t kBitStreams = 4;
+
+namespace simd_detail {
+
+// Маска младших bits битов, bits от 0 до 64
+constexpr uint64_t LowBitsMask(unsigned bits) noexcept {
+    return bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+}
+
+template <BitOp kOp>
+constexpr uint64_t ApplyBitOp(uint64_t lhs, uint64_t rhs) noexcept {
+    if constexpr (kOp == BitOp::kAnd) {
+        return lhs & rhs;
+    } else if constexpr (kOp == BitOp::kOr) {
+        return lhs | rhs;
+    } else {
+        return lhs ^ rhs;
+    }
+}
+
+// Скалярная реализация ядер
+struct ScalarKernels {
+    template <typename T>
+    static void Fill(T* dest, size_t count, T value) noexcept {
+        std::fill_n(dest, count, value);
+    }
+
+    template <typename T>
+    static size_t Find(const T* data, size_t count, T value) noexcept {
+        return static_cast<size_t>(std::find(data, data + count, value) - data);
+    }
+
+    template <typename T>
+    static size_t Count(const T* data, size_t count, T value) noexcept {
+        return static_cast<size_t>(std::count(data, data + count, value));
+    }
+
+    template <typename T>
+    static T Min(const T* data, size_t count) noexcept {
+        return *std::min_element(data, data + count);
+    }
+
+    template <typename T>
+    static T Max(const T* data, size_t count) noexcept {
+        return *std::max_element(data, data + count);
+    }
+
+    template <typename T>
+    static SimdSumType<T> Sum(const T* data, size_t count) noexcept {
+        return std::accumulate(data, data + count, SimdSumType<T>{});
+    }
+
+    template <typename T>
+    static size_t Mismatch(const T* lhs, const T* rhs, size_t count) noexcept {
+        return static_cast<size_t>(std::mismatch(lhs, lhs + count, rhs).first - lhs);
+    }
+
+    template <BitOp kOp>
+    static void BitwiseWords(uint64_t* dest, const uint64_t* src, size_t count) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            dest[i] = ApplyBitOp<kOp>(dest[i], src[i]);
+        }
+    }
+
+    static void UnpackBits(const uint64_t* packed, size_t count, unsigned bits, uint64_t base, uint64_t* out) noexcept {
+        const uint64_t mask = LowBitsMask(bits);
+        for (size_t i = 0; i < count; ++i) {
+            const size_t position = i / kBitStreams * bits;
+            const unsigned shift = static_cast<unsigned>(position % 64);
+            const uint64_t* word = packed + position / 64 * kBitStreams + i % kBitStreams;
+            uint64_t value = word[0] >> shift;
+            if (shift + bits > 64) {
+                value |= word[kBitStreams] << (64 - shift);
+            }
+            out[i] = base + (value & mask);
+        }
+    }
+
+    static size_t PopCountWords(const uint64_t* data, size_t count) noexcept {
+        size_t result = 0;
+        for (size_t i = 0; i < count; ++i) {
+            result += static_cast<size_t>(__builtin_popcountll(data[i]));
+        }
+        return result;
+    }
+};
+
+} // namespace simd_detail
+
+#if SIMPLE_VECTOR_X86_SIMD
+
+// ---------------- SSE4.2: регистры по 128 бит
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2,popcnt")
+
+namespace simd_sse42 {
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<int32_t> {
+    using Vec = __m128i;
+    using Acc = __m128i;
+    static constexpr size_t kLanes = 4;
+    static Vec Load(const int32_t* ptr) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+    static void Store(int32_t* ptr, Vec value) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), value); }
+    static Vec Set1(int32_t value) noexcept { return _mm_set1_epi32(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs))));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm_min_epi32(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm_max_epi32(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm_setzero_si128(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept {
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(value));
+        return _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(value, 8)));
+    }
+    static int64_t ReduceSum(Acc acc) noexcept {
+        return _mm_cvtsi128_si64(acc) + _mm_extract_epi64(acc, 1);
+    }
+};
+
+template <>
+struct Ops<uint8_t> {
+    using Vec = __m128i;
+    using Acc = __m128i;
+    static constexpr size_t kLanes = 16;
+    static Vec Load(const uint8_t* ptr) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+    static void Store(uint8_t* ptr, Vec value) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), value); }
+    static Vec Set1(uint8_t value) noexcept { return _mm_set1_epi8(static_cast<char>(value)); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm_min_epu8(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm_max_epu8(lhs, rhs); }
+    static Vec And(Vec lhs, Vec rhs) noexcept { return _mm_and_si128(lhs, rhs); }
+    static Vec Or(Vec lhs, Vec rhs) noexcept { return _mm_or_si128(lhs, rhs); }
+    static Vec Xor(Vec lhs, Vec rhs) noexcept { return _mm_xor_si128(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm_setzero_si128(); }
+    // Сумма абсолютных разностей с нулём складывает байты в два 64-битных слова
+    static Acc Accumulate(Acc acc, Vec value) noexcept {
+        return _mm_add_epi64(acc, _mm_sad_epu8(value, _mm_setzero_si128()));
+    }
+    static uint64_t ReduceSum(Acc acc) noexcept {
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(acc)) + static_cast<uint64_t>(_mm_extract_epi64(acc, 1));
+    }
+};
+
+template <>
+struct Ops<float> {
+    using Vec = __m128;
+    using Acc = __m128;
+    static constexpr size_t kLanes = 4;
+    static Vec Load(const float* ptr) noexcept { return _mm_loadu_ps(ptr); }
+    static void Store(float* ptr, Vec value) noexcept { _mm_storeu_ps(ptr, value); }
+    static Vec Set1(float value) noexcept { return _mm_set1_ps(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs)));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm_min_ps(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm_max_ps(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm_setzero_ps(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept { return _mm_add_ps(acc, value); }
+    static float ReduceSum(Acc acc) noexcept {
+        float lanes[kLanes];
+        _mm_storeu_ps(lanes, acc);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+template <>
+struct Ops<double> {
+    using Vec = __m128d;
+    using Acc = __m128d;
+    static constexpr size_t kLanes = 2;
+    static Vec Load(const double* ptr) noexcept { return _mm_loadu_pd(ptr); }
+    static void Store(double* ptr, Vec value) noexcept { _mm_storeu_pd(ptr, value); }
+    static Vec Set1(double value) noexcept { return _mm_set1_pd(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpeq_pd(lhs, rhs)));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm_min_pd(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm_max_pd(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm_setzero_pd(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept { return _mm_add_pd(acc, value); }
+    static double ReduceSum(Acc acc) noexcept {
+        double lanes[kLanes];
+        _mm_storeu_pd(lanes, acc);
+        return lanes[0] + lanes[1];
+    }
+};
+
+template <>
+struct Ops<uint64_t> {
+    using Vec = __m128i;
+    static constexpr size_t kLanes = 2;
+    static Vec Load(const uint64_t* ptr) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+    static void Store(uint64_t* ptr, Vec value) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), value); }
+    static Vec Set1(uint64_t value) noexcept { return _mm_set1_epi64x(static_cast<long long>(value)); }
+    static Vec Add(Vec lhs, Vec rhs) noexcept { return _mm_add_epi64(lhs, rhs); }
+    static Vec And(Vec lhs, Vec rhs) noexcept { return _mm_and_si128(lhs, rhs); }
+    static Vec Or(Vec lhs, Vec rhs) noexcept { return _mm_or_si128(lhs, rhs); }
+    // Сдвиги на общее для всех элементов число битов; сдвиг на 64 даёт ноль
+    static Vec ShiftRight(Vec value, unsigned count) noexcept { return _mm_srl_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count))); }
+    static Vec ShiftLeft(Vec value, unsigned count) noexcept { return _mm_sll_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count))); }
+};
+
+#include "simd_kernels_impl.h"
+
+} // namespace simd_sse42
+
+#pragma GCC pop_options
+
+// ---------------- AVX2: регистры по 256 бит
+
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+
+namespace simd_avx2 {
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<int32_t> {
+    using Vec = __m256i;
+    using Acc = __m256i;
+    static constexpr size_t kLanes = 8;
+    static Vec Load(const int32_t* ptr) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static void Store(int32_t* ptr, Vec value) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+    static Vec Set1(int32_t value) noexcept { return _mm256_set1_epi32(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs))));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm256_min_epi32(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm256_max_epi32(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm256_setzero_si256(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept {
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+        return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+    }
+    static int64_t ReduceSum(Acc acc) noexcept {
+        const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        return _mm_cvtsi128_si64(half) + _mm_extract_epi64(half, 1);
+    }
+};
+
+template <>
+struct Ops<uint8_t> {
+    using Vec = __m256i;
+    using Acc = __m256i;
+    static constexpr size_t kLanes = 32;
+    static Vec Load(const uint8_t* ptr) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static void Store(uint8_t* ptr, Vec value) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+    static Vec Set1(uint8_t value) noexcept { return _mm256_set1_epi8(static_cast<char>(value)); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm256_min_epu8(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm256_max_epu8(lhs, rhs); }
+    static Vec And(Vec lhs, Vec rhs) noexcept { return _mm256_and_si256(lhs, rhs); }
+    static Vec Or(Vec lhs, Vec rhs) noexcept { return _mm256_or_si256(lhs, rhs); }
+    static Vec Xor(Vec lhs, Vec rhs) noexcept { return _mm256_xor_si256(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm256_setzero_si256(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept {
+        return _mm256_add_epi64(acc, _mm256_sad_epu8(value, _mm256_setzero_si256()));
+    }
+    static uint64_t ReduceSum(Acc acc) noexcept {
+        const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(half)) + static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+    }
+};
+
+template <>
+struct Ops<float> {
+    using Vec = __m256;
+    using Acc = __m256;
+    static constexpr size_t kLanes = 8;
+    static Vec Load(const float* ptr) noexcept { return _mm256_loadu_ps(ptr); }
+    static void Store(float* ptr, Vec value) noexcept { _mm256_storeu_ps(ptr, value); }
+    static Vec Set1(float value) noexcept { return _mm256_set1_ps(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ)));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm256_min_ps(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm256_max_ps(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm256_setzero_ps(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept { return _mm256_add_ps(acc, value); }
+    static float ReduceSum(Acc acc) noexcept {
+        const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        float lanes[4];
+        _mm_storeu_ps(lanes, half);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+template <>
+struct Ops<double> {
+    using Vec = __m256d;
+    using Acc = __m256d;
+    static constexpr size_t kLanes = 4;
+    static Vec Load(const double* ptr) noexcept { return _mm256_loadu_pd(ptr); }
+    static void Store(double* ptr, Vec value) noexcept { _mm256_storeu_pd(ptr, value); }
+    static Vec Set1(double value) noexcept { return _mm256_set1_pd(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ)));
+    }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm256_min_pd(lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm256_max_pd(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm256_setzero_pd(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept { return _mm256_add_pd(acc, value); }
+    static double ReduceSum(Acc acc) noexcept {
+        const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+        double lanes[2];
+        _mm_storeu_pd(lanes, half);
+        return lanes[0] + lanes[1];
+    }
+};
+
+template <>
+struct Ops<uint64_t> {
+    using Vec = __m256i;
+    static constexpr size_t kLanes = 4;
+    static Vec Load(const uint64_t* ptr) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static void Store(uint64_t* ptr, Vec value) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+    static Vec Set1(uint64_t value) noexcept { return _mm256_set1_epi64x(static_cast<long long>(value)); }
+    static Vec Add(Vec lhs, Vec rhs) noexcept { return _mm256_add_epi64(lhs, rhs); }
+    static Vec And(Vec lhs, Vec rhs) noexcept { return _mm256_and_si256(lhs, rhs); }
+    static Vec Or(Vec lhs, Vec rhs) noexcept { return _mm256_or_si256(lhs, rhs); }
+    static Vec ShiftRight(Vec value, unsigned count) noexcept { return _mm256_srl_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count))); }
+    static Vec ShiftLeft(Vec value, unsigned count) noexcept { return _mm256_sll_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count))); }
+};
+
+#include "simd_kernels_impl.h"
+
+} // namespace simd_avx2
+
+#pragma GCC pop_options
+
+// ---------------- AVX-512 (F + BW): регистры по 512 бит, сравнения сразу дают битовые маски
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,popcnt")
+
+namespace simd_avx512 {
+
+// Часть встроенных функций AVX-512 в GCC 12 (_mm512_reduce_*, _mm512_min_* и т.п.) заполняет
+// неиспользуемые части регистров через _mm*_undefined_*, что даёт ложные предупреждения
+// -Wmaybe-uninitialized. Поэтому ниже используются maskz-варианты с полной маской,
+// а суммы слов регистра складываются через память
+
+// Складывает 64-битные слова регистра
+template <typename Word>
+Word ReduceLanes(__m512i acc) noexcept {
+    Word lanes[8];
+    _mm512_storeu_si512(lanes, acc);
+    return std::accumulate(lanes, lanes + 8, Word{0});
+}
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<int32_t> {
+    using Vec = __m512i;
+    using Acc = __m512i;
+    static constexpr size_t kLanes = 16;
+    static Vec Load(const int32_t* ptr) noexcept { return _mm512_loadu_si512(ptr); }
+    static void Store(int32_t* ptr, Vec value) noexcept { _mm512_storeu_si512(ptr, value); }
+    static Vec Set1(int32_t value) noexcept { return _mm512_set1_epi32(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept { return _mm512_cmpeq_epi32_mask(lhs, rhs); }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_min_epi32(0xFFFF, lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_max_epi32(0xFFFF, lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm512_setzero_si512(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept {
+        acc = _mm512_add_epi64(acc, _mm512_maskz_cvtepi32_epi64(0xFF, _mm512_maskz_extracti64x4_epi64(0xF, value, 0)));
+        return _mm512_add_epi64(acc, _mm512_maskz_cvtepi32_epi64(0xFF, _mm512_maskz_extracti64x4_epi64(0xF, value, 1)));
+    }
+    static int64_t ReduceSum(Acc acc) noexcept { return ReduceLanes<int64_t>(acc); }
+};
+
+template <>
+struct Ops<uint8_t> {
+    using Vec = __m512i;
+    using Acc = __m512i;
+    static constexpr size_t kLanes = 64;
+    static Vec Load(const uint8_t* ptr) noexcept { return _mm512_loadu_si512(ptr); }
+    static void Store(uint8_t* ptr, Vec value) noexcept { _mm512_storeu_si512(ptr, value); }
+    static Vec Set1(uint8_t value) noexcept { return _mm512_set1_epi8(static_cast<char>(value)); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept { return _mm512_cmpeq_epi8_mask(lhs, rhs); }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_min_epu8(~__mmask64{0}, lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_max_epu8(~__mmask64{0}, lhs, rhs); }
+    static Vec And(Vec lhs, Vec rhs) noexcept { return _mm512_and_si512(lhs, rhs); }
+    static Vec Or(Vec lhs, Vec rhs) noexcept { return _mm512_or_si512(lhs, rhs); }
+    static Vec Xor(Vec lhs, Vec rhs) noexcept { return _mm512_xor_si512(lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm512_setzero_si512(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept {
+        return _mm512_add_epi64(acc, _mm512_sad_epu8(value, _mm512_setzero_si512()));
+    }
+    static uint64_t ReduceSum(Acc acc) noexcept { return ReduceLanes<uint64_t>(acc); }
+};
+
+template <>
+struct Ops<float> {
+    using Vec = __m512;
+    using Acc = __m512;
+    static constexpr size_t kLanes = 16;
+    static Vec Load(const float* ptr) noexcept { return _mm512_loadu_ps(ptr); }
+    static void Store(float* ptr, Vec value) noexcept { _mm512_storeu_ps(ptr, value); }
+    static Vec Set1(float value) noexcept { return _mm512_set1_ps(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept { return _mm512_cmp_ps_mask(lhs, rhs, _CMP_EQ_OQ); }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_min_ps(0xFFFF, lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_max_ps(0xFFFF, lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm512_setzero_ps(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept { return _mm512_add_ps(acc, value); }
+    static float ReduceSum(Acc acc) noexcept {
+        float lanes[kLanes];
+        _mm512_storeu_ps(lanes, acc);
+        return std::accumulate(lanes, lanes + kLanes, 0.0f);
+    }
+};
+
+template <>
+struct Ops<double> {
+    using Vec = __m512d;
+    using Acc = __m512d;
+    static constexpr size_t kLanes = 8;
+    static Vec Load(const double* ptr) noexcept { return _mm512_loadu_pd(ptr); }
+    static void Store(double* ptr, Vec value) noexcept { _mm512_storeu_pd(ptr, value); }
+    static Vec Set1(double value) noexcept { return _mm512_set1_pd(value); }
+    static uint64_t EqMask(Vec lhs, Vec rhs) noexcept { return _mm512_cmp_pd_mask(lhs, rhs, _CMP_EQ_OQ); }
+    static Vec Min(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_min_pd(0xFF, lhs, rhs); }
+    static Vec Max(Vec lhs, Vec rhs) noexcept { return _mm512_maskz_max_pd(0xFF, lhs, rhs); }
+    static Acc AccZero() noexcept { return _mm512_setzero_pd(); }
+    static Acc Accumulate(Acc acc, Vec value) noexcept { return _mm512_add_pd(acc, value); }
+    static double ReduceSum(Acc acc) noexcept {
+        double lanes[kLanes];
+        _mm512_storeu_pd(lanes, acc);
+        return std::accumulate(lanes, lanes + kLanes, 0.0);
+    }
+};
+
+// Распаковка битов читает по kBitStreams = 4 слова за шаг, поэтому здесь хватает 256-битных регистров
+template <>
+struct Ops<uint64_t> {
+    using Vec = __m256i;
+    static constexpr size_t kLanes = 4;
+    static Vec Load(const uint64_t* ptr) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static void Store(uint64_t* ptr, Vec value) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+    static Vec Set1(uint64_t value) noexcept { return _mm256_set1_epi64x(static_cast<long long>(value)); }
+    static Vec Add(Vec lhs, Vec rhs) noexcept { return _mm256_add_epi64(lhs, rhs); }
+    static Vec And(Vec lhs, Vec rhs) noexcept { return _mm256_and_si256(lhs, rhs); }
+    static Vec Or(Vec lhs, Vec rhs) noexcept { return _mm256_or_si256(lhs, rhs); }
+    static Vec ShiftRight(Vec value, unsigned count) noexcept { return _mm256_srl_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count))); }
+    static Vec ShiftLeft(Vec value, unsigned count) noexcept { return _mm256_sll_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count))); }
+};
+
+#include "simd_kernels_impl.h"
+
+} // namespace simd_avx512
+
+#pragma GCC pop_options
+
+#endif // SIMPLE_VECTOR_X86_SIMD
+
+namespace simd_detail {
+
+// Вызывает call с ядрами выбранного набора инструкций
+template <typename Call>
+decltype(auto) DispatchSimd(Call call) {
+#if SIMPLE_VECTOR_X86_SIMD
+    switch (GetSimdLevel()) {
+        case SimdLevel::kAvx512:
+            return call(simd_avx512::Kernels{});
+        case SimdLevel::kAvx2:
+            return call(simd_avx2::Kernels{});
+        case SimdLevel::kSse42:
+            return call(simd_sse42::Kernels{});
+        case SimdLevel::kScalar:
+            break;
+    }
+#endif
+    return call(ScalarKernels{});
+}
+
+} // namespace simd_detail
+
+// Записывает value в count элементов dest
+template <typename Type>
+void SimdFill(Type* dest, size_t count, Type value) noexcept {
+    simd_detail::DispatchSimd([&](auto kernels) { kernels.Fill(dest, count, value); });
+}
+
+// Возвращает индекс первого элемента, равного value, или count
+template <typename Type>
+size_t SimdFind(const Type* data, size_t count, Type value) noexcept {
+    return simd_detail::DispatchSimd([&](auto kernels) { return kernels.Find(data, count, value); });
+}
+
+// Возвращает количество элементов, равных value
+template <typename Type>
+size_t SimdCount(const Type* data, size_t count, Type value) noexcept {
+    return simd_detail::DispatchSimd([&](auto kernels) { return kernels.Count(data, count, value); });
+}
+
+// Возвращает наименьший элемент. Массив не должен быть пустым; для чисел с NaN результат не определён
+template <typename Type>
+Type SimdMin(const Type* data, size_t count) noexcept {
+    return simd_detail::DispatchSimd([&](auto kernels) { return kernels.Min(data, count); });
+}
+
+// Возвращает наибольший элемент. Массив не должен быть пустым; для чисел с NaN результат не определён
+template <typename Type>
+Type SimdMax(const Type* data, size_t count) noexcept {
+    return simd_detail::DispatchSimd([&](auto kernels) { return kernels.Max(data, count); });
+}
+
+// Возвращает сумму элементов. Числа с плавающей точкой складываются в другом порядке,
+// чем при последовательном сложении, поэтому результат может отличаться в последних разрядах
+template <typename Type>
+SimdSumType<Type> SimdSum(const Type* data, size_t count) noexcept {
+    return simd_detail::DispatchSimd([&](auto kernels) { return kernels.Sum(data, count); });
+}
+
+// Возвращает индекс первого i, для которого lhs[i] == rhs[i] ложно, или count
+template <typename Type>
+size_t SimdMismatch(const Type* lhs, const Type* rhs, size_t count) noexcept {
+    return simd_detail::DispatchSimd([&](auto kernels) { return kernels.Mismatch(lhs, rhs, count); });
+}
+
+// Сравнивает массивы поэлементно (как std::equal)
+template <typename Type>
+bool SimdEqual(const Type* lhs, size_t lhs_count, const Type* rhs, size_t rhs_count) noexcept {
+    return lhs_count == rhs_count && SimdMismatch(lhs, rhs, lhs_count) == lhs_count;
+}
+
+// Сравнивает массивы лексикографически (как std::lexicographical_compare): ищет первое
+// расхождение векторно и сравнивает только его. Несравнимые значения (NaN) пропускаются
+template <typename Type>
+bool SimdLexicographicalLess(const Type* lhs, size_t lhs_count, const Type* rhs, size_t rhs_count) noexcept {
+    const size_t count = std::min(lhs_count, rhs_count);
+    for (size_t offset = 0; offset < count;) {
+        const size_t index = offset + SimdMismatch(lhs + offset, rhs + offset, count - offset);
+        if (index == count) {
+            break;
+        }
+        if (lhs[index] < rhs[index]) {
+            return true;
+        }
+        if (rhs[index] < lhs[index]) {
+            return false;
+        }
+        offset = index + 1;
+    }
+    return lhs_count < rhs_count;
+}
+
+// Выполняет dest[i] = dest[i] op src[i] для count 64-битных слов (битовых наборов).
+// Массивы не должны частично перекрываться; dest == src допустимо
+template <BitOp kOp>
+void SimdBitwiseWords(uint64_t* dest, const uint64_t* src, size_t count) noexcept {
+    simd_detail::DispatchSimd([&](auto kernels) { kernels.template BitwiseWords<kOp>(dest, src, count); });
+}
+
+// Возвращает количество установленных битов в count 64-битных словах
+inline size_t SimdPopCountWords(const uint64_t* data, size_t count) noexcept {
+    return simd_detail::DispatchSimd([&](auto kernels) { return kernels.PopCountWords(data, count); });
+}
+
+// Распаковывает count значений шириной bits (от 0 до 64) из раскладки в kBitStreams потоков:
+// out[i] = base + значение i. count должен быть кратен kBitStreams
+inline void SimdUnpackBits(const uint64_t* packed, size_t count, unsigned bits, uint64_t base, uint64_t* out) noexcept {
+    if (bits == 0) {
+        std::fill_n(out, count, base);
+        return;
+    }
+    simd_detail::DispatchSimd([&](auto kernels) { kernels.UnpackBits(packed, count, bits, base, out); });
+}
@@ -0,0 +1,221 @@
+// Обобщённые векторные ядра. Файл намеренно не защищён от повторного включения:
+// simd_kernels.h включает его внутрь пространства имён каждого набора инструкций
+// (под соответствующей #pragma GCC target), где объявлен шаблон Ops<T> с операциями над регистрами.
+// Ops<T> предоставляет:
+//     Vec, kLanes                 - тип регистра и число элементов в нём
+//     Load, Store, Set1           - невыровненные загрузка и запись, заполнение значением
+//     EqMask(a, b)                - битовая маска равных элементов (бит i - элемент i)
+//     Min, Max                    - поэлементные минимум и максимум
+//     And, Or, Xor                - побитовые операции (только Ops<uint8_t> и Ops<uint64_t>)
+//     Add, ShiftRight, ShiftLeft  - сложение и сдвиги на общее число битов (только Ops<uint64_t>)
+//     Acc, AccZero, Accumulate,
+//     ReduceSum                   - накопление суммы в расширенном типе SimdSumType<T>
+
+struct Kernels {
+    // Маска, в которой установлены биты всех элементов регистра
+    template <typename T>
+    static constexpr uint64_t FullMask() noexcept {
+        return Ops<T>::kLanes == 64 ? ~uint64_t{0} : (uint64_t{1} << Ops<T>::kLanes) - 1;
+    }
+
+    template <typename T>
+    static void Fill(T* dest, size_t count, T value) noexcept {
+        using V = Ops<T>;
+        const typename V::Vec pattern = V::Set1(value);
+        size_t i = 0;
+        for (; i + V::kLanes <= count; i += V::kLanes) {
+            V::Store(dest + i, pattern);
+        }
+        for (; i < count; ++i) {
+            dest[i] = value;
+        }
+    }
+
+    template <typename T>
+    static size_t Find(const T* data, size_t count, T value) noexcept {
+        using V = Ops<T>;
+        const typename V::Vec needle = V::Set1(value);
+        size_t i = 0;
+        for (; i + V::kLanes <= count; i += V::kLanes) {
+            const uint64_t mask = V::EqMask(V::Load(data + i), needle);
+            if (mask != 0) {
+                return i + static_cast<size_t>(__builtin_ctzll(mask));
+            }
+        }
+        for (; i < count; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    template <typename T>
+    static size_t Count(const T* data, size_t count, T value) noexcept {
+        using V = Ops<T>;
+        const typename V::Vec needle = V::Set1(value);
+        size_t result = 0;
+        size_t i = 0;
+        for (; i + V::kLanes <= count; i += V::kLanes) {
+            result += static_cast<size_t>(__builtin_popcountll(V::EqMask(V::Load(data + i), needle)));
+        }
+        for (; i < count; ++i) {
+            result += data[i] == value ? 1 : 0;
+        }
+        return result;
+    }
+
+    // count должен быть больше нуля
+    template <typename T>
+    static T Min(const T* data, size_t count) noexcept {
+        return Reduce<T, true>(data, count);
+    }
+
+    // count должен быть больше нуля
+    template <typename T>
+    static T Max(const T* data, size_t count) noexcept {
+        return Reduce<T, false>(data, count);
+    }
+
+    template <typename T>
+    static SimdSumType<T> Sum(const T* data, size_t count) noexcept {
+        using V = Ops<T>;
+        // Четыре независимых аккумулятора скрывают задержку сложения
+        typename V::Acc acc0 = V::AccZero();
+        typename V::Acc acc1 = V::AccZero();
+        typename V::Acc acc2 = V::AccZero();
+        typename V::Acc acc3 = V::AccZero();
+        size_t i = 0;
+        for (; i + 4 * V::kLanes <= count; i += 4 * V::kLanes) {
+            acc0 = V::Accumulate(acc0, V::Load(data + i));
+            acc1 = V::Accumulate(acc1, V::Load(data + i + V::kLanes));
+            acc2 = V::Accumulate(acc2, V::Load(data + i + 2 * V::kLanes));
+            acc3 = V::Accumulate(acc3, V::Load(data + i + 3 * V::kLanes));
+        }
+        for (; i + V::kLanes <= count; i += V::kLanes) {
+            acc0 = V::Accumulate(acc0, V::Load(data + i));
+        }
+        SimdSumType<T> result = (V::ReduceSum(acc0) + V::ReduceSum(acc1)) + (V::ReduceSum(acc2) + V::ReduceSum(acc3));
+        for (; i < count; ++i) {
+            result += data[i];
+        }
+        return result;
+    }
+
+    // Возвращает индекс первого элемента, для которого lhs[i] == rhs[i] ложно, или count
+    template <typename T>
+    static size_t Mismatch(const T* lhs, const T* rhs, size_t count) noexcept {
+        using V = Ops<T>;
+        size_t i = 0;
+        for (; i + V::kLanes <= count; i += V::kLanes) {
+            const uint64_t mask = V::EqMask(V::Load(lhs + i), V::Load(rhs + i));
+            if (mask != FullMask<T>()) {
+                return i + static_cast<size_t>(__builtin_ctzll(~mask & FullMask<T>()));
+            }
+        }
+        for (; i < count; ++i) {
+            if (!(lhs[i] == rhs[i])) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    // Побитовая операция над словами: регистр uint8_t обрабатывает сразу kLanes / 8 слов
+    template <BitOp kOp>
+    static void BitwiseWords(uint64_t* dest, const uint64_t* src, size_t count) noexcept {
+        using V = Ops<uint8_t>;
+        constexpr size_t kWords = V::kLanes / sizeof(uint64_t);
+        size_t i = 0;
+        for (; i + kWords <= count; i += kWords) {
+            uint8_t* out = reinterpret_cast<uint8_t*>(dest + i);
+            const typename V::Vec lhs = V::Load(out);
+            const typename V::Vec rhs = V::Load(reinterpret_cast<const uint8_t*>(src + i));
+            if constexpr (kOp == BitOp::kAnd) {
+                V::Store(out, V::And(lhs, rhs));
+            } else if constexpr (kOp == BitOp::kOr) {
+                V::Store(out, V::Or(lhs, rhs));
+            } else {
+                V::Store(out, V::Xor(lhs, rhs));
+            }
+        }
+        for (; i < count; ++i) {
+            dest[i] = simd_detail::ApplyBitOp<kOp>(dest[i], src[i]);
+        }
+    }
+
+    // Распаковка по kBitStreams значений за шаг: у них общее смещение, поэтому сдвиг один на весь регистр,
+    // а следующее слово потоков читается, только если значения пересекают границу слова
+    static void UnpackBits(const uint64_t* packed, size_t count, unsigned bits, uint64_t base, uint64_t* out) noexcept {
+        using V = Ops<uint64_t>;
+        static_assert(kBitStreams % V::kLanes == 0);
+        const typename V::Vec mask = V::Set1(simd_detail::LowBitsMask(bits));
+        const typename V::Vec offset = V::Set1(base);
+        for (size_t i = 0; i < count; i += kBitStreams) {
+            const size_t position = i / kBitStreams * bits;
+            const unsigned shift = static_cast<unsigned>(position % 64);
+            const uint64_t* word = packed + position / 64 * kBitStreams;
+            const bool straddles = shift + bits > 64;
+            for (size_t lane = 0; lane < kBitStreams; lane += V::kLanes) {
+                typename V::Vec value = V::ShiftRight(V::Load(word + lane), shift);
+                if (straddles) {
+                    value = V::Or(value, V::ShiftLeft(V::Load(word + kBitStreams + lane), 64 - shift));
+                }
+                V::Store(out + i + lane, V::Add(V::And(value, mask), offset));
+            }
+        }
+    }
+
+    // Подсчёт битов инструкцией popcnt; четыре независимых счётчика скрывают её задержку
+    static size_t PopCountWords(const uint64_t* data, size_t count) noexcept {
+        size_t acc0 = 0;
+        size_t acc1 = 0;
+        size_t acc2 = 0;
+        size_t acc3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            acc0 += static_cast<size_t>(__builtin_popcountll(data[i]));
+            acc1 += static_cast<size_t>(__builtin_popcountll(data[i + 1]));
+            acc2 += static_cast<size_t>(__builtin_popcountll(data[i + 2]));
+            acc3 += static_cast<size_t>(__builtin_popcountll(data[i + 3]));
+        }
+        for (; i < count; ++i) {
+            acc0 += static_cast<size_t>(__builtin_popcountll(data[i]));
+        }
+        return (acc0 + acc1) + (acc2 + acc3);
+    }
+
+private:
+    // Сводит диапазон к минимуму (kMin) или максимуму.
+    // Хвост обрабатывается повторной загрузкой последних kLanes элементов: для min/max это безопасно
+    template <typename T, bool kMin>
+    static T Reduce(const T* data, size_t count) noexcept {
+        using V = Ops<T>;
+        const auto pick = [](T lhs, T rhs) {
+            return (kMin ? rhs < lhs : lhs < rhs) ? rhs : lhs;
+        };
+        if (count < V::kLanes) {
+            T result = data[0];
+            for (size_t i = 1; i < count; ++i) {
+                result = pick(result, data[i]);
+            }
+            return result;
+        }
+        typename V::Vec acc = V::Load(data);
+        size_t i = V::kLanes;
+        for (; i + V::kLanes <= count; i += V::kLanes) {
+            acc = kMin ? V::Min(acc, V::Load(data + i)) : V::Max(acc, V::Load(data + i));
+        }
+        if (i < count) {
+            const typename V::Vec last = V::Load(data + count - V::kLanes);
+            acc = kMin ? V::Min(acc, last) : V::Max(acc, last);
+        }
+        T lanes[V::kLanes];
+        V::Store(lanes, acc);
+        T result = lanes[0];
+        for (size_t lane = 1; lane < V::kLanes; ++lane) {
+            result = pick(result, lanes[lane]);
+        }
+        return result;
+    }
+};
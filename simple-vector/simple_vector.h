@@ -1,12 +1,27 @@
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <initializer_list>
 #include <algorithm>
 #include <stdexcept>
+#include <tuple>
 #include <iostream>
-
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
 #include "array_ptr.h"
+#include "constexpr_support.h"
+#include "growth_policy.h"
+#include "instrumentation.h"
+#include "relocation.h"
+#include "simd_kernels.h"
 //#include "my_assert.h"
 
 
@@ -14,135 +29,208 @@
 class ReserveProxyObj {
 public:
 
-    ReserveProxyObj() noexcept = default;
+    constexpr ReserveProxyObj() noexcept = default;
 
-    ReserveProxyObj (size_t capacity_to_reserve)
+    constexpr ReserveProxyObj (size_t capacity_to_reserve)
         : capacity_to_reserve_(capacity_to_reserve)
     {}
 
-    size_t GetValue() { return capacity_to_reserve_; }
+    constexpr size_t GetValue() const { return capacity_to_reserve_; }
 
 private:
     size_t capacity_to_reserve_ = 0;
 };
 
 // Функция Reserve для запуска класса-обёртки
-ReserveProxyObj Reserve(size_t capacity_to_reserve) {
+constexpr ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
-template <typename Type>
-class SimpleVector {
+// Признак итератора, по которому можно пройти хотя бы один раз (input iterator).
+// Отличает Insert(pos, first, last) от Insert(pos, count, value) для целочисленных аргументов
+template <typename Iterator, typename = void>
+struct IsInputIterator : std::false_type {};
+
+template <typename Iterator>
+struct IsInputIterator<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>>
+    : std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category> {};
+
+// Память под элементы выделяется аллокатором Alloc через std::allocator_traits.
+// Подходят стандартные аллокаторы, std::pmr::polymorphic_allocator (см. PmrSimpleVector),
+// а также ArenaAllocator и PoolAllocator.
+// Growth - политика роста ёмкости при нехватке места (см. growth_policy.h).
+// Со сжимающей политикой (HysteresisShrink) удаление элементов может перенести их в меньший буфер,
+// и тогда PopBack, Erase, SwapErase, EraseIf и уменьшающий Resize делают итераторы недействительными.
+// При SIMPLE_VECTOR_INSTRUMENTATION события вектора учитываются под его тегом (см. instrumentation.h).
+// В C++20 вектор с аллокатором по умолчанию можно использовать в константных выражениях (см. constexpr_support.h)
+template <typename Type, typename Alloc = DefaultAllocator<Type>, typename Growth = DoublingGrowth>
+class SimpleVector : private VectorProbe {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using Buffer = ArrayPtr<Type, Alloc>;
+
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
 
+    // Имена, по которым стандартная библиотека распознаёт контейнер с аллокатором
+    // (std::uses_allocator, конструирование вложенных pmr-контейнеров)
+    using value_type = Type;
+    using allocator_type = Alloc;
+
     // Создаёт пустой вектор
-    SimpleVector() noexcept
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector() noexcept(std::is_nothrow_default_constructible_v<Alloc>)
         : size_(0)
         , capacity_(0)
-        , vector_{ArrayPtr<Type>{}}
+        , vector_{}
     {}
 
-    // Создаёт пустой вектор c заданной ёмкостью
-    SimpleVector(ReserveProxyObj obj)
+    // Создаёт пустой вектор, память которого будет выделять alloc
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(const Alloc& alloc) noexcept
         : size_(0)
-        , capacity_(obj.GetValue())
-        , vector_{size_}
+        , capacity_(0)
+        , vector_{alloc}
     {}
 
+    // Создаёт пустой вектор c заданной ёмкостью.
+    // Память выделяется сырой: элементы в ней не создаются
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(ReserveProxyObj obj, const Alloc& alloc = Alloc())
+        : size_(0)
+        , capacity_(obj.GetValue())
+        , vector_{capacity_, alloc}
+    {
+        OnAllocate(capacity_, sizeof(Type));
+    }
+
     // Создаёт вектор из size элементов, инициализированных значением value (или по умолчанию)
-    SimpleVector(size_t size, const Type& value = Type())
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value = Type(), const Alloc& alloc = Alloc())
         : size_(size)
         , capacity_(size)
-        , vector_{size_}
+        , vector_{size_, alloc}
     {
-        std::fill(vector_.Get(), vector_.Get() + size_, value);
+        UninitializedFillN(Allocator(), vector_.Get(), size_, value);
+        OnAllocate(capacity_, sizeof(Type));
+        OnCopies(size_);
     }
 
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init)
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init, const Alloc& alloc = Alloc())
         : size_(init.size())
         , capacity_(init.size())
-        , vector_{size_}
+        , vector_{size_, alloc}
     {
-        std::copy(init.begin(), init.end(), vector_.Get());
+        UninitializedCopy(Allocator(), init.begin(), init.end(), vector_.Get());
+        OnAllocate(capacity_, sizeof(Type));
+        OnCopies(size_);
     }
 
     // Создаёт копию другого вектора (конструктор копирования)
-    SimpleVector(const SimpleVector& other)
-        : size_(other.size_)
-        , capacity_(other.capacity_)
-        , vector_{size_}
-    {
-        //assert((*this != other) && "Error: Himself's copy");
-        std::copy(other.begin(), other.end(), vector_.Get());
-    }
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other)
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {}
+
+    // Создаёт копию другого вектора в памяти аллокатора alloc
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other, const Alloc& alloc)
+        : SimpleVector(other, alloc, other)
+    {}
 
     // ПЕРЕМЕЩЕНИЕ
     // Перемещает вектор в другой вектор (конструктор перемещения)
-    SimpleVector(SimpleVector&& other)
-        : size_(other.size_)
-        , capacity_(other.capacity_)
-        , vector_{size_}
-    {
-        std::move(other.begin(), other.end(), vector_.Get());
+    // Забирает буфер other за O(1), не выделяя память и не трогая элементы
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other) noexcept
+        : VectorProbe(other)
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , vector_(std::move(other.vector_))
+    {}
 
-        other.Clear();
-        other.capacity_ = 0;
-        other.vector_.Delete();
-    }
+    // ПЕРЕМЕЩЕНИЕ
+    // Перемещает вектор в память аллокатора alloc.
+    // Буфер забирается за O(1), только если alloc может освободить память other,
+    // иначе элементы перемещаются поштучно
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other, const Alloc& alloc)
+        : SimpleVector(std::move(other), alloc, other)
+    {}
 
     // Оператор присваивания копированием
-    SimpleVector& operator=(const SimpleVector& rhs) {
-        SimpleVector tmp{rhs};
-        this->swap(tmp);   // copy&swap
-        tmp.Clear();
-        tmp.capacity_ = 0;
-        tmp.vector_.Delete();
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs) {
+        if (this != &rhs) {
+            constexpr bool kPropagate = AllocTraits::propagate_on_container_copy_assignment::value;
+            SimpleVector tmp(rhs, kPropagate ? rhs.GetAllocator() : GetAllocator(), *this);
+            *this = std::move(tmp);   // copy&move
+        }
         return *this;
     }
 
     // ПЕРЕМЕЩЕНИЕ
     // Опереатор присваивания перемещением
-    SimpleVector& operator=(SimpleVector&& rhs) {
-        this->swap(rhs);
+    // Освобождает свои элементы и забирает буфер rhs за O(1).
+    // Если аллокаторы не равны и аллокатор не распространяется, элементы перемещаются поштучно
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+        if (this == &rhs) {
+            return *this;
+        }
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                      && !AllocTraits::is_always_equal::value) {
+            if (Allocator() != rhs.Allocator()) {
+                SimpleVector tmp(std::move(rhs), GetAllocator(), *this);
+                swap(tmp);
+                return *this;
+            }
+        }
+        Clear();
+        OnFree(capacity_, sizeof(Type));
+        vector_ = std::move(rhs.vector_);
+        size_ = std::exchange(rhs.size_, 0);
+        capacity_ = std::exchange(rhs.capacity_, 0);
         return *this;
     }
 
     // Деструктор
-    ~SimpleVector() { Clear(); }
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector() {
+        Clear();
+        OnFree(capacity_, sizeof(Type));
+    }
+
+    // Задаёт тег, под которым учитываются события вектора (при SIMPLE_VECTOR_INSTRUMENTATION).
+    // Копии вектора наследуют его тег
+    using VectorProbe::SetTag;
 
     // Возвращает количество элементов в массиве
-    std::size_t GetSize() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR std::size_t GetSize() const noexcept {
         return size_;
     }
 
     // Возвращает вместимость массива
-    std::size_t GetCapacity() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR std::size_t GetCapacity() const noexcept {
         return capacity_;
     }
 
+    // Возвращает копию аллокатора вектора
+    SIMPLE_VECTOR_CONSTEXPR Alloc GetAllocator() const noexcept {
+        return vector_.GetAllocator();
+    }
+
     // Сообщает, пустой ли массив
-    bool IsEmpty() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept {
         return GetSize() == 0;
     }
 
     // Возвращает ссылку на элемент с индексом index
-    Type& operator[](std::size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](std::size_t index) noexcept {
         assert((index <= size_) && "Error: Out of range!");
         return vector_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
-    const Type& operator[](std::size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](std::size_t index) const noexcept {
         assert((index <= size_) && "Error: Out of range!");
         return const_cast<Type&>(vector_[index]);
     }
 
     // Возвращает ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    Type& At(std::size_t index) {
+    SIMPLE_VECTOR_CONSTEXPR Type& At(std::size_t index) {
         if (index >= size_) {
             throw std::out_of_range("Error: Out of range!");
         }
@@ -151,217 +239,293 @@ public:
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    const Type& At(std::size_t index) const {
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(std::size_t index) const {
         if (index >= size_) {
             throw std::out_of_range("Error: Out of range!");
         }
         return const_cast<Type&>(vector_[index]);
     }
 
-    // Обнуляет размер массива, не изменяя его вместимость
-    void Clear() noexcept {
+    // Разрушает все элементы и обнуляет размер массива, не изменяя его вместимость
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        DestroyRange(Allocator(), begin(), end());
         size_ = 0;
     }
 
     // Возвращает итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator begin() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept {
         return Iterator(vector_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator end() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept {
         return Iterator(vector_.Get() + size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator begin() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept {
         return ConstIterator(vector_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator end() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
         return ConstIterator(vector_.Get() + size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cbegin() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept {
         return ConstIterator(vector_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cend() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
         return ConstIterator(vector_.Get() + size_);
     }
 
     // Изменяет размер массива.
     // При увеличении размера новые элементы получают значение по умолчанию для типа Type
-    void Resize(size_t new_size) {
-        if (new_size < size_) {
-            size_ = new_size;
-         }
-            else if (new_size < capacity_) {
-                //std::fill(begin() + size_, begin() + new_size, Type()); //не проходит тренажёр
-                for (auto it = begin() + size_; it != begin() + new_size; ++it) { *it = std::move(Type()); }
-                size_ = new_size;
-                }
-                else if (new_size >= capacity_) {
-                        size_t new_capacity = 2*new_size;
-                        try {
-                            ArrayPtr<Type> tmp{new_size};
-                            std::move(begin(), begin() + size_, tmp.Get());
-                            vector_.swap(tmp);
-                            tmp.Delete();
-                        }
-                        catch (std::bad_alloc&) {
-                            std::cerr << "Error: Bad allocation!" << std::endl;
-                            throw std::bad_alloc();
-                        }
-                        size_ = new_size;
-                        capacity_ = new_capacity;
-                    }
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            Truncate(new_size);
+            ShrinkIfSparse();
+            return;
+        }
+        ReserveForResize(new_size);
+        UninitializedValueConstructN(Allocator(), end(), new_size - size_);
+        size_ = new_size;
     }
 
-    // Добавляет элемент в конец вектора
-    // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(const Type& item) {
-        if (capacity_ == 0) {
-            capacity_ = 1;
-            ArrayPtr<Type> tmp{capacity_};
-            vector_.swap(tmp);
-            tmp.Delete();
-        }
-        if (size_ < capacity_) {
-            vector_[size_] = item;
-            ++size_;
-        }
-        else {
-            ArrayPtr<Type> tmp{capacity_ * 2};
-            std::copy(begin(), end(), tmp.Get());
-            tmp[size_] = item;
-            vector_.swap(tmp);
-            ++size_;
-            capacity_ *= 2;
-            tmp.Delete();
+    // Изменяет размер массива, не инициализируя новые элементы значением.
+    // Новые элементы создаются инициализацией по умолчанию: для тривиальных типов
+    // (int, double, POD-структуры) их значения не определены и должны быть сразу перезаписаны
+    SIMPLE_VECTOR_CONSTEXPR void ResizeForOverwrite(size_t new_size) {
+        if (new_size <= size_) {
+            Truncate(new_size);
+            ShrinkIfSparse();
+            return;
         }
+        ReserveForResize(new_size);
+        UninitializedDefaultConstructN(Allocator(), end(), new_size - size_);
+        size_ = new_size;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вместимость вектора по политике Growth (по умолчанию вдвое)
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBackImpl(item);
     }
 
     // ПЕРЕМЕЩЕНИЕ
     // Добавляет элемент в конец вектора
-    // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(Type&& item) {
-        if (capacity_ == 0) {
-            capacity_ = 1;
-            ArrayPtr<Type> tmp{capacity_};
-            vector_.swap(tmp);
-            tmp.Delete();
-        }
-        if (size_ < capacity_) {
-            vector_[size_] = std::move(item);
-            ++size_;
-        }
-        else {
-            ArrayPtr<Type> tmp{capacity_ * 2};
-            std::move(begin(), end(), tmp.Get());
-            tmp[size_] = std::move(item);
-            vector_.swap(tmp);
-            ++size_;
-            capacity_ *= 2;
-            tmp.Delete();
-        }
+    // При нехватке места увеличивает вместимость вектора по политике Growth (по умолчанию вдвое)
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBackImpl(std::move(item));
     }
 
     // Вставляет значение value в позицию pos.
     // Возвращает итератор на вставленное значение
     // Если перед вставкой значения вектор был заполнен полностью,
-    // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
-    Iterator Insert(ConstIterator pos, Type& value) {
-        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
-        Iterator it_pos = const_cast<Iterator>(pos);
-        if (size_ < capacity_) {
-            std::copy_backward(it_pos, end(), end() + 1);
-            *it_pos = value;
-            ++size_;
-            return it_pos;
-        }
-        size_t new_capacity = (capacity_ > 0 ? 2*capacity_: 1);
-        auto distance = std::distance(vector_.Get(), it_pos);
-        ArrayPtr<Type> tmp{new_capacity};
-        if (distance == 0) {
-            std::copy(vector_.Get(), vector_.Get() + size_, tmp.Get() + 1);
-        } else {
-            std::copy(vector_.Get(), it_pos, tmp.Get());
-            std::copy(it_pos, vector_.Get() + size_, tmp.Get() + distance + 1);
-        }
-        *(tmp.Get() + distance) = value;
-        vector_.swap(tmp);
-        ++size_;
-        capacity_ = new_capacity;
-        tmp.Delete();
-        return Iterator{vector_.Get() + distance};
+    // вместимость вектора увеличивается по политике Growth (по умолчанию вдвое, а для вектора вместимостью 0 становится равной 1)
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return EmplaceImpl(pos, value);
     }
 
     // ПЕРЕМЕЩЕНИЕ
     // Вставляет значение value в позицию pos.
     // Возвращает итератор на вставленное значение
     // Если перед вставкой значения вектор был заполнен полностью,
-    // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
-    Iterator Insert(ConstIterator pos, Type&& value) {
+    // вместимость вектора увеличивается по политике Growth (по умолчанию вдвое, а для вектора вместимостью 0 становится равной 1)
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return EmplaceImpl(pos, std::move(value));
+    }
+
+    // Вставляет count копий value в позицию pos.
+    // Возвращает итератор на первое вставленное значение (или pos, если count == 0)
+    // Память перевыделяется не более одного раза, хвост вектора сдвигается один раз
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
         assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
-        Iterator it_pos = const_cast<Iterator>(pos);
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        if (count == 0) {
+            return begin() + index;
+        }
+        OnCopies(count);
+        if (Contains(&value)) {
+            // value - элемент самого вектора: сдвиг и перевыделение его испортят
+            const Type copy(value);
+            return InsertN(index, count, [&](Type* dest) { UninitializedFillN(Allocator(), dest, count, copy); });
+        }
+        return InsertN(index, count, [&](Type* dest) { UninitializedFillN(Allocator(), dest, count, value); });
+    }
 
-        if (size_ < capacity_) {
-            std::move_backward(it_pos, end(), end() + 1);
-            *it_pos = std::move(value);
-            ++size_;
-            return it_pos;
+    // Вставляет элементы диапазона [first, last) в позицию pos.
+    // Возвращает итератор на первое вставленное значение (или pos, если диапазон пуст)
+    // Для forward-итераторов итоговая ёмкость вычисляется сразу: память перевыделяется
+    // не более одного раза, хвост вектора сдвигается один раз.
+    // Диапазон может быть частью самого вектора, только если его итераторы - указатели
+    template <typename InputIt, std::enable_if_t<IsInputIterator<InputIt>::value, int> = 0>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            // Длина диапазона заранее неизвестна: собираем его во временный вектор
+            SimpleVector tmp(GetAllocator());
+            for (; first != last; ++first) {
+                tmp.PushBack(*first);
+            }
+            return Insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+        } else {
+            if (first == last) {
+                return begin() + index;
+            }
+            if constexpr (std::is_pointer_v<InputIt>) {
+                if (Contains(std::addressof(*first))) {
+                    SimpleVector tmp(GetAllocator());
+                    tmp.Reserve(static_cast<size_t>(std::distance(first, last)));
+                    tmp.Insert(tmp.cend(), first, last);
+                    return Insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+                }
+            }
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if constexpr (std::is_rvalue_reference_v<typename std::iterator_traits<InputIt>::reference>) {
+                OnMoves(count);
+            } else {
+                OnCopies(count);
+            }
+            return InsertN(index, count, [&](Type* dest) { UninitializedCopy(Allocator(), first, last, dest); });
         }
+    }
+
+    // Вставляет элементы списка init в позицию pos
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, std::initializer_list<Type> init) {
+        return Insert(pos, init.begin(), init.end());
+    }
+
+    // Добавляет элементы диапазона [first, last) в конец вектора
+    // Память перевыделяется не более одного раза
+    template <typename InputIt, std::enable_if_t<IsInputIterator<InputIt>::value, int> = 0>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last) {
+        Insert(cend(), first, last);
+    }
 
-        size_t new_capacity = (capacity_ > 0 ? 2*capacity_ : 1);
-        auto distance = std::distance(begin(), it_pos);
-        ArrayPtr<Type> tmp{new_capacity};
-        if (distance == 0) {
-            std::move(begin(), end(), tmp.Get() + 1);
+    // Добавляет элементы контейнера range в конец вектора.
+    // Элементы временного контейнера перемещаются, а не копируются
+    template <typename Range>
+    SIMPLE_VECTOR_CONSTEXPR void Append(Range&& range) {
+        if constexpr (std::is_lvalue_reference_v<Range>) {
+            Insert(cend(), std::begin(range), std::end(range));
         } else {
-            std::move(begin(), it_pos, tmp.Get());
-            std::move(it_pos, end(), tmp.Get() + distance + 1);
+            Insert(cend(), std::make_move_iterator(std::begin(range)), std::make_move_iterator(std::end(range)));
         }
-        *(tmp.Get() + distance) = std::move(value);
-        vector_.swap(tmp);
-        ++size_;
-        capacity_ = new_capacity;
-        tmp.Delete();
-        return Iterator{begin() + distance};
     }
 
-    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
-    void PopBack() noexcept {
+    // Добавляет элементы списка init в конец вектора
+    SIMPLE_VECTOR_CONSTEXPR void Append(std::initializer_list<Type> init) {
+        Insert(cend(), init.begin(), init.end());
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args, не создавая временных объектов.
+    // Аргументы могут ссылаться на элементы самого вектора.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        return EmplaceBackImpl(std::forward<Args>(args)...);
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        return EmplaceImpl(pos, std::forward<Args>(args)...);
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
         assert(!IsEmpty() && "Error: Vector is empty!");
         --size_;
+        DestroyAt(Allocator(), end());
+        ShrinkIfSparse();
     }
 
     // Удаляет элемент вектора в указанной позиции
     // Возвращает итератор на, следующий после удалённого, элемент
-    Iterator Erase(ConstIterator pos) {
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
         assert(!IsEmpty() && "Error: Vector is empty!");
-        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
-        Iterator it_pos = const_cast<Iterator>(pos);
+        assert( (pos >= begin() && pos < end()) && "Error: Out of range!" );
+        return Erase(pos, pos + 1);
+    }
 
-        //std::move_backward(it_pos + 1, end(), end() - 1);
+    // Удаляет элементы [first, last), сдвигая хвост вектора один раз
+    // Возвращает итератор на элемент, следующий за удалёнными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert( (first >= begin() && first <= last && last <= end()) && "Error: Out of range!" );
+        Iterator it_first = const_cast<Iterator>(first);
+        Iterator it_last = const_cast<Iterator>(last);
+        if (it_first == it_last) {
+            return it_first;
+        }
+        const size_t count = static_cast<size_t>(it_last - it_first);
+        if constexpr (kIsTriviallyRelocatable<Type>) {
+            // Хвост сдвигается одним memmove поверх разрушенных элементов
+            DestroyRange(Allocator(), it_first, it_last);
+            RelocateOverlapping(it_last, end(), it_first);
+            size_ -= count;
+        } else {
+            OnMoves(static_cast<size_t>(end() - it_last));
+            std::move(it_last, end(), it_first);
+            Truncate(size_ - count);
+        }
+        const size_t index = static_cast<size_t>(it_first - begin());
+        ShrinkIfSparse();
+        return begin() + index;
+    }
 
-        for (auto it = it_pos; it != end(); ++it) { *(it) = std::move(*(it + 1)); }
+    // Удаляет все элементы, для которых pred возвращает true, за один проход.
+    // Порядок оставшихся элементов сохраняется. Возвращает количество удалённых элементов
+    template <typename Predicate>
+    SIMPLE_VECTOR_CONSTEXPR size_t EraseIf(Predicate pred) {
+        Iterator new_end = std::remove_if(begin(), end(), pred);
+        const size_t count = static_cast<size_t>(end() - new_end);
+        Truncate(size_ - count);
+        ShrinkIfSparse();
+        return count;
+    }
 
-        --size_;
-        return Iterator{it_pos};
+    // Удаляет элемент в позиции pos за O(1), перенося на его место последний элемент.
+    // Порядок элементов не сохраняется. Возвращает итератор на элемент, занявший место удалённого
+    // (или end(), если удалён последний элемент)
+    SIMPLE_VECTOR_CONSTEXPR Iterator SwapErase(ConstIterator pos) {
+        assert( (pos >= begin() && pos < end()) && "Error: Out of range!" );
+        Iterator it_pos = const_cast<Iterator>(pos);
+        Iterator last = end() - 1;
+        if constexpr (kIsTriviallyRelocatable<Type>) {
+            DestroyAt(Allocator(), it_pos);
+            if (it_pos != last) {
+                RelocateBytes(last, end(), it_pos);
+            }
+            --size_;
+        } else {
+            if (it_pos != last) {
+                OnMoves(1);
+                *it_pos = std::move(*last);
+            }
+            DestroyAt(Allocator(), last);
+            --size_;
+        }
+        const size_t index = static_cast<size_t>(it_pos - begin());
+        ShrinkIfSparse();
+        return begin() + index;
     }
 
     // Обменивает значение с другим вектором
-    void swap(SimpleVector& other) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector& other) noexcept {
         //assert((*this != other) && "Error: Himself's swap");
         vector_.swap(other.vector_);
         std::swap(size_, other.size_);
@@ -370,7 +534,7 @@ public:
 
     // ПЕРЕМЕЩЕНИЕ
     // Обменивает значение с другим вектором
-    void swap(SimpleVector&& other) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector&& other) noexcept {
         //assert((*this != other) && "Error: Himself's swap");
         vector_.swap(other.vector_);
         std::swap(size_, other.size_);
@@ -378,55 +542,413 @@ public:
     }
 
     // Метод резервирования ёмкости вектора
-    void Reserve(size_t new_capacity) {
+    // Новая память остаётся сырой: за пределами size элементы не создаются
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
         if (new_capacity > capacity_) {
+            Reallocate(new_capacity, GrowthCause::kReserve);
+        }
+    }
+
+    // Уменьшает вместимость до размера вектора, возвращая лишнюю память аллокатору.
+    // Пустой вектор освобождает буфер целиком. Итераторы и ссылки на элементы становятся недействительными
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() {
+        if (capacity_ > size_) {
+            ShrinkTo(size_);
+        }
+    }
+
+private:
+    // Копирует other в память аллокатора alloc, учитывая события под тегом probe
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other, const Alloc& alloc, const VectorProbe& probe)
+        : VectorProbe(probe)
+        , size_(other.size_)
+        , capacity_(other.size_)
+        , vector_{size_, alloc}
+    {
+        //assert((*this != other) && "Error: Himself's copy");
+        UninitializedCopy(Allocator(), other.begin(), other.end(), vector_.Get());
+        OnAllocate(capacity_, sizeof(Type));
+        OnCopies(size_);
+    }
+
+    // Перемещает other в память аллокатора alloc, учитывая события под тегом probe
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other, const Alloc& alloc, const VectorProbe& probe)
+        : VectorProbe(probe)
+        , size_(0)
+        , capacity_(0)
+        , vector_{alloc}
+    {
+        if (Allocator() == other.Allocator()) {
+            vector_.swap(other.vector_);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        } else {
+            Buffer tmp{other.size_, alloc};
+            UninitializedCopy(Allocator(), std::make_move_iterator(other.begin()),
+                              std::make_move_iterator(other.end()), tmp.Get());
+            vector_.swap(tmp);
+            size_ = other.size_;
+            capacity_ = other.size_;
+            OnAllocate(capacity_, sizeof(Type));
+            OnMoves(size_);
+            other.Clear();
+        }
+    }
+
+    // Возвращает аллокатор, которым выделена память вектора
+    SIMPLE_VECTOR_CONSTEXPR Alloc& Allocator() noexcept {
+        return vector_.GetAllocator();
+    }
+
+    // Возвращает аллокатор, которым выделена память вектора
+    SIMPLE_VECTOR_CONSTEXPR const Alloc& Allocator() const noexcept {
+        return vector_.GetAllocator();
+    }
+
+    // Перевыделяет память под new_capacity элементов и переносит в неё текущие элементы.
+    // Тривиально перемещаемые элементы переносятся memcpy или расширением блока через realloc
+    // (realloc недоступен при компиляции, там элементы переносятся в новый буфер).
+    // cause - причина перевыделения для инструментирования
+    SIMPLE_VECTOR_CONSTEXPR void Reallocate(size_t new_capacity, GrowthCause cause) {
+        try {
+            if constexpr (Buffer::kCanReallocate) {
+                if (!IsConstantEvaluated()) {
+                    vector_.Reallocate(new_capacity);
+                } else {
+                    RelocateToBuffer(new_capacity);
+                }
+            } else {
+                RelocateToBuffer(new_capacity);
+            }
+        }
+        catch (std::bad_alloc&) {
+            std::cerr << "Error: Bad allocation!" << std::endl;
+            throw;
+        }
+        ClaimSlack(vector_);
+        OnGrowth(cause, capacity_, vector_.GetSize(), sizeof(Type));
+        OnTransfer(size_);
+        capacity_ = vector_.GetSize();
+    }
+
+    // Переносит элементы в новый буфер на new_capacity элементов
+    SIMPLE_VECTOR_CONSTEXPR void RelocateToBuffer(size_t new_capacity) {
+        Buffer tmp{new_capacity, Allocator()};
+        UninitializedRelocate(Allocator(), begin(), end(), tmp.Get());
+        vector_.swap(tmp);
+    }
+
+    // Переносит элементы в меньший буфер на new_capacity (не меньше size) элементов
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkTo(size_t new_capacity) {
+        if (new_capacity == 0) {
+            OnGrowth(GrowthCause::kShrink, capacity_, 0, sizeof(Type));
+            vector_.Delete();
+            capacity_ = 0;
+            return;
+        }
+        Reallocate(new_capacity, GrowthCause::kShrink);
+    }
+
+    // Сжимает буфер после удаления элементов, если этого требует политика роста (см. HysteresisShrink).
+    // Сжатие лишь возвращает память: если перенести элементы не удалось, остаётся прежний буфер
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkIfSparse() noexcept {
+        if constexpr (GrowthShrinks<Growth>::value) {
+            const size_t new_capacity = Growth::ShrinkCapacity(capacity_, size_, sizeof(Type));
+            if (new_capacity < capacity_) {
+                try {
+                    ShrinkTo(std::max(new_capacity, size_));
+                }
+                catch (...) {
+                }
+            }
+        }
+    }
+
+    // Учитывает перенос count элементов в новый буфер: побайтовый перенос не создаёт
+    // объектов, иначе элементы перемещаются или копируются (см. UninitializedTransfer)
+    SIMPLE_VECTOR_CONSTEXPR void OnTransfer(size_t count) const noexcept {
+        if constexpr (!kIsTriviallyRelocatable<Type>) {
+            if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+                OnMoves(count);
+            } else {
+                OnCopies(count);
+            }
+        }
+    }
+
+    // Учитывает создание элемента из args: копию или перемещение готового объекта Type
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR void OnConstructFrom() const noexcept {
+        if constexpr (sizeof...(Args) == 1) {
+            using Arg = std::tuple_element_t<0, std::tuple<Args...>>;
+            if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<Arg>>, Type>) {
+                if constexpr (std::is_lvalue_reference_v<Arg>) {
+                    OnCopies(1);
+                } else {
+                    OnMoves(1);
+                }
+            }
+        }
+    }
+
+    // Возвращает ёмкость, достаточную для required элементов, по политике роста Growth
+    SIMPLE_VECTOR_CONSTEXPR size_t NextCapacity(size_t required) const noexcept {
+        return Growth::NextCapacity(capacity_, required, sizeof(Type));
+    }
+
+    // Забирает запас, фактически выделенный аллокатором, если этого требует политика роста
+    static SIMPLE_VECTOR_CONSTEXPR void ClaimSlack(Buffer& buffer) noexcept {
+        if constexpr (GrowthClaimsSlack<Growth>::value) {
+            buffer.ClaimUsableSize();
+        }
+    }
+
+    // Сообщает, указывает ли ptr на элемент самого вектора.
+    // При компиляции указатели на разные объекты нельзя упорядочить, поэтому они сравниваются на равенство
+    SIMPLE_VECTOR_CONSTEXPR bool Contains(const Type* ptr) const noexcept {
+        if (IsConstantEvaluated()) {
+            for (const Type* item = cbegin(); item != cend(); ++item) {
+                if (item == ptr) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return !std::less<const Type*>()(ptr, cbegin()) && std::less<const Type*>()(ptr, cend());
+    }
+
+    // Вставляет count элементов в позицию index. construct(dest) создаёт все count элементов
+    // в сырой памяти dest и при исключении сам разрушает уже созданные.
+    // Источник элементов не должен ссылаться на элементы вектора
+    template <typename Construct>
+    SIMPLE_VECTOR_CONSTEXPR Iterator InsertN(size_t index, size_t count, Construct construct) {
+        if (count > capacity_ - size_) {
+            if (count > std::numeric_limits<size_t>::max() - size_) {
+                throw std::length_error("Error: Vector is too long!");
+            }
+            if constexpr (kIsTriviallyRelocatable<Type> && Buffer::kCanReallocate) {
+                // Буфер расширяется через realloc, а хвост сдвигается ниже одним memmove
+                Reallocate(NextCapacity(size_ + count), GrowthCause::kInsert);
+            } else {
+                return InsertNReallocating(index, count, construct);
+            }
+        }
+
+        Iterator it_pos = begin() + index;
+        if constexpr (kIsTriviallyRelocatable<Type>) {
+            RelocateOverlapping(it_pos, end(), it_pos + count);
             try {
-                ArrayPtr<Type> tmp{new_capacity};
-                std::copy(begin(), end(), tmp.Get());
-                std::fill(tmp.Get() + size_, tmp.Get() + new_capacity, Type());
-                vector_.swap(tmp);
-                tmp.Delete();
+                construct(it_pos);
             }
-            catch (std::bad_alloc&) {
-                std::cerr << "Error: Bad allocation!" << std::endl;
-                throw std::bad_alloc();
+            catch (...) {
+                RelocateOverlapping(it_pos + count, end() + count, it_pos);
+                throw;
             }
-            capacity_ = new_capacity;
+            size_ += count;
+        } else {
+            // Новые элементы создаются за концом и поворотом встают на место
+            OnMoves(count + (size_ - index));
+            Iterator old_end = end();
+            construct(old_end);
+            size_ += count;
+            std::rotate(it_pos, old_end, end());
         }
+        return it_pos;
+    }
+
+    // Вставка count элементов с переносом всех элементов в новый буфер.
+    // Новые элементы создаются первыми, пока старый буфер цел
+    template <typename Construct>
+    SIMPLE_VECTOR_CONSTEXPR Iterator InsertNReallocating(size_t index, size_t count, Construct& construct) {
+        Buffer tmp{NextCapacity(size_ + count), Allocator()};
+        ClaimSlack(tmp);
+        OnGrowth(GrowthCause::kInsert, capacity_, tmp.GetSize(), sizeof(Type));
+        OnTransfer(size_);
+        Type* new_items = tmp.Get() + index;
+        construct(new_items);
+        if constexpr (kIsTriviallyRelocatable<Type>) {
+            RelocateBytes(begin(), begin() + index, tmp.Get());
+            RelocateBytes(begin() + index, end(), new_items + count);
+        } else {
+            try {
+                UninitializedTransfer(Allocator(), begin(), begin() + index, tmp.Get());
+                try {
+                    UninitializedTransfer(Allocator(), begin() + index, end(), new_items + count);
+                }
+                catch (...) {
+                    DestroyRange(Allocator(), tmp.Get(), new_items);
+                    throw;
+                }
+            }
+            catch (...) {
+                DestroyRange(Allocator(), new_items, new_items + count);
+                throw;
+            }
+            DestroyRange(Allocator(), begin(), end());
+        }
+        vector_.swap(tmp);
+        size_ += count;
+        capacity_ = vector_.GetSize();
+        return begin() + index;
+    }
+
+    // Обеспечивает ёмкость под new_size элементов при увеличении размера через Resize
+    SIMPLE_VECTOR_CONSTEXPR void ReserveForResize(size_t new_size) {
+        if (new_size > capacity_) {
+            Reallocate(NextCapacity(new_size), GrowthCause::kResize);
+        }
+    }
+
+    // Разрушает элементы, начиная с индекса new_size
+    SIMPLE_VECTOR_CONSTEXPR void Truncate(size_t new_size) noexcept {
+        DestroyRange(Allocator(), begin() + new_size, end());
+        size_ = new_size;
+    }
+
+    // Создаёт элемент в конце вектора. Пока есть место, хвост сдвигать не нужно
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBackImpl(Args&&... args) {
+        if (size_ < capacity_) {
+            OnConstructFrom<Args...>();
+            ConstructAt(Allocator(), end(), std::forward<Args>(args)...);
+            return *(begin() + size_++);
+        }
+        return *EmplaceImpl(cend(), std::forward<Args>(args)...);
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos прямо в сырой памяти
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator EmplaceImpl(ConstIterator pos, Args&&... args) {
+        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        OnConstructFrom<Args...>();
+
+        if constexpr (kIsTriviallyRelocatable<Type>) {
+            // Побайтовый перенос через временную сырую память при компиляции недоступен
+            if (!IsConstantEvaluated()) {
+                return EmplaceRelocatable(index, std::forward<Args>(args)...);
+            }
+        }
+
+        if (size_ < capacity_) {
+            Iterator it_pos = begin() + index;
+            if (it_pos == end()) {
+                ConstructAt(Allocator(), end(), std::forward<Args>(args)...);
+            } else {
+                // args могут ссылаться на элементы самого вектора, поэтому элемент создаётся до сдвига
+                OnMoves(size_ - index + 1);
+                Type tmp(std::forward<Args>(args)...);
+                ConstructAt(Allocator(), end(), std::move(*(end() - 1)));
+                std::move_backward(it_pos, end() - 1, end());
+                *it_pos = std::move(tmp);
+            }
+            ++size_;
+            return it_pos;
+        }
+
+        Buffer tmp{NextCapacity(size_ + 1), Allocator()};
+        ClaimSlack(tmp);
+        OnGrowth(index == size_ ? GrowthCause::kPushBack : GrowthCause::kInsert, capacity_, tmp.GetSize(), sizeof(Type));
+        OnTransfer(size_);
+        Type* new_item = tmp.Get() + index;
+        ConstructAt(Allocator(), new_item, std::forward<Args>(args)...);
+        try {
+            UninitializedTransfer(Allocator(), begin(), begin() + index, tmp.Get());
+            try {
+                UninitializedTransfer(Allocator(), begin() + index, end(), tmp.Get() + index + 1);
+            }
+            catch (...) {
+                DestroyRange(Allocator(), tmp.Get(), tmp.Get() + index);
+                throw;
+            }
+        }
+        catch (...) {
+            DestroyAt(Allocator(), new_item);
+            throw;
+        }
+        DestroyRange(Allocator(), begin(), end());
+        vector_.swap(tmp);
+        ++size_;
+        capacity_ = vector_.GetSize();
+        return Iterator{begin() + index};
+    }
+
+    // Вставка для тривиально перемещаемых типов: хвост сдвигается одним memmove,
+    // а при нехватке места буфер расширяется через Reallocate
+    template <typename... Args>
+    Iterator EmplaceRelocatable(size_t index, Args&&... args) {
+        if (index == size_ && size_ < capacity_) {
+            ConstructAt(Allocator(), end(), std::forward<Args>(args)...);
+            ++size_;
+            return end() - 1;
+        }
+
+        // args могут ссылаться на элементы самого вектора, поэтому создаём элемент
+        // во временной сырой памяти до сдвига и перевыделения, а затем переносим побайтово
+        alignas(Type) unsigned char item[sizeof(Type)];
+        Type* new_item = reinterpret_cast<Type*>(item);
+        ConstructAt(Allocator(), new_item, std::forward<Args>(args)...);
+        if (size_ == capacity_) {
+            try {
+                Reallocate(NextCapacity(size_ + 1), index == size_ ? GrowthCause::kPushBack : GrowthCause::kInsert);
+            }
+            catch (...) {
+                DestroyAt(Allocator(), new_item);
+                throw;
+            }
+        }
+        Iterator it_pos = begin() + index;
+        RelocateOverlapping(it_pos, end(), it_pos + 1);
+        RelocateBytes(new_item, new_item + 1, it_pos);
+        ++size_;
+        return it_pos;
     }
 
-private:
     size_t size_;
     size_t capacity_;
-    ArrayPtr<Type> vector_;
+    Buffer vector_;
 };
 
+// SimpleVector, память которого выделяется из std::pmr::memory_resource
 template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+using PmrSimpleVector = SimpleVector<Type, std::pmr::polymorphic_allocator<Type>>;
+
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR bool operator==(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
+    if constexpr (kHasSimdKernels<Type>) {
+        if (!IsConstantEvaluated()) {
+            return SimdEqual(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+        }
+    }
     return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR bool operator!=(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR bool operator<(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
+    if constexpr (kHasSimdKernels<Type>) {
+        if (!IsConstantEvaluated()) {
+            return SimdLexicographicalLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+        }
+    }
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR bool operator<=(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return (lhs < rhs) || (lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR bool operator>(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return !(lhs <= rhs);
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR bool operator>=(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return !(lhs < rhs);
 }
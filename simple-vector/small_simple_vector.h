@@ -0,0 +1,546 @@
+#pragma once
+
+#include <cassert>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "relocation.h"
+#include "simple_vector.h"
+
+// Вектор с внутренним буфером на N элементов (small buffer optimization).
+// Пока элементов не больше N, они хранятся прямо в объекте и куча не используется;
+// при переполнении элементы переезжают в память аллокатора Alloc, и дальше вектор растёт как SimpleVector.
+// Интерфейс совпадает с SimpleVector
+template <typename Type, size_t N, typename Alloc = DefaultAllocator<Type>>
+class SmallSimpleVector : private Alloc {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    // Присваивание перемещением не выделяет память, если аллокатор распространяется или все его копии равны
+    static constexpr bool kNothrowMoveAssign =
+        std::is_nothrow_move_constructible_v<Type>
+        && (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value);
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using value_type = Type;
+    using allocator_type = Alloc;
+
+    // Ёмкость внутреннего буфера
+    static constexpr size_t kInlineCapacity = N;
+
+    // Создаёт пустой вектор
+    SmallSimpleVector() noexcept(std::is_nothrow_default_constructible_v<Alloc>)
+        : data_(InlineData())
+        , size_(0)
+        , capacity_(N)
+    {}
+
+    // Создаёт пустой вектор, память которого при переполнении будет выделять alloc
+    explicit SmallSimpleVector(const Alloc& alloc) noexcept
+        : Alloc(alloc)
+        , data_(InlineData())
+        , size_(0)
+        , capacity_(N)
+    {}
+
+    // Создаёт пустой вектор c заданной ёмкостью
+    SmallSimpleVector(ReserveProxyObj obj, const Alloc& alloc = Alloc())
+        : SmallSimpleVector(alloc)
+    {
+        Reserve(obj.GetValue());
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value (или по умолчанию)
+    SmallSimpleVector(size_t size, const Type& value = Type(), const Alloc& alloc = Alloc())
+        : SmallSimpleVector(alloc)
+    {
+        Reserve(size);
+        UninitializedFillN(Allocator(), data_, size, value);
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init, const Alloc& alloc = Alloc())
+        : SmallSimpleVector(alloc)
+    {
+        Reserve(init.size());
+        UninitializedCopy(Allocator(), init.begin(), init.end(), data_);
+        size_ = init.size();
+    }
+
+    // Создаёт копию другого вектора (конструктор копирования)
+    SmallSimpleVector(const SmallSimpleVector& other)
+        : SmallSimpleVector(AllocTraits::select_on_container_copy_construction(other.Allocator()))
+    {
+        Reserve(other.size_);
+        UninitializedCopy(Allocator(), other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Буфер в куче забирается за O(1), элементы внутреннего буфера перемещаются поштучно.
+    // Аллокатор копируется из other и равен ему, поэтому память не выделяется
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+        : SmallSimpleVector(static_cast<const Alloc&>(other))
+    {
+        TakeFrom(other);
+    }
+
+    // Оператор присваивания копированием
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (this != &rhs) {
+            SmallSimpleVector tmp(rhs);
+            *this = std::move(tmp);   // copy&move
+        }
+        return *this;
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Опереатор присваивания перемещением
+    // Если аллокаторы не равны и аллокатор не распространяется, буфер rhs в куче нельзя забрать:
+    // элементы переносятся в память, выделенную своим аллокатором
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(kNothrowMoveAssign) {
+        if (this != &rhs) {
+            Clear();
+            FreeHeap();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                Allocator() = std::move(rhs.Allocator());
+            }
+            TakeFrom(rhs);
+        }
+        return *this;
+    }
+
+    // Деструктор
+    ~SmallSimpleVector() {
+        Clear();
+        FreeHeap();
+    }
+
+    // Возвращает количество элементов в массиве
+    std::size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива
+    std::size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Сообщает, хранятся ли элементы во внутреннем буфере
+    bool IsInline() const noexcept {
+        return data_ == InlineData();
+    }
+
+    // Возвращает копию аллокатора вектора
+    Alloc GetAllocator() const noexcept {
+        return Allocator();
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](std::size_t index) noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](std::size_t index) const noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(std::size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(std::size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return data_[index];
+    }
+
+    // Разрушает все элементы и обнуляет размер массива, не изменяя его вместимость
+    void Clear() noexcept {
+        DestroyRange(Allocator(), begin(), end());
+        size_ = 0;
+    }
+
+    // Возвращает итератор на начало массива
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    // Возвращает константный итератор на начало массива
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    // Возвращает константный итератор на начало массива
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            Truncate(new_size);
+            return;
+        }
+        if (new_size > capacity_) {
+            Reallocate(std::max(new_size, 2 * capacity_));
+        }
+        UninitializedValueConstructN(Allocator(), end(), new_size - size_);
+        size_ = new_size;
+    }
+
+    // Изменяет размер массива, не инициализируя новые элементы значением
+    void ResizeForOverwrite(size_t new_size) {
+        if (new_size <= size_) {
+            Truncate(new_size);
+            return;
+        }
+        if (new_size > capacity_) {
+            Reallocate(std::max(new_size, 2 * capacity_));
+        }
+        UninitializedDefaultConstructN(Allocator(), end(), new_size - size_);
+        size_ = new_size;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item) {
+        EmplaceImpl(cend(), item);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Добавляет элемент в конец вектора
+    void PushBack(Type&& item) {
+        EmplaceImpl(cend(), std::move(item));
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return EmplaceImpl(pos, value);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return EmplaceImpl(pos, std::move(value));
+    }
+
+    // Создаёт элемент в конце вектора из аргументов args, не создавая временных объектов.
+    // Аргументы могут ссылаться на элементы самого вектора.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceImpl(cend(), std::forward<Args>(args)...);
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        return EmplaceImpl(pos, std::forward<Args>(args)...);
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        --size_;
+        DestroyAt(Allocator(), end());
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    // Возвращает итератор на, следующий после удалённого, элемент
+    Iterator Erase(ConstIterator pos) {
+        assert( (pos >= begin() && pos < end()) && "Error: Out of range!" );
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост вектора один раз
+    // Возвращает итератор на элемент, следующий за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert( (first >= begin() && first <= last && last <= end()) && "Error: Out of range!" );
+        Iterator it_first = const_cast<Iterator>(first);
+        Iterator it_last = const_cast<Iterator>(last);
+        const size_t count = static_cast<size_t>(it_last - it_first);
+        if constexpr (kIsTriviallyRelocatable<Type>) {
+            DestroyRange(Allocator(), it_first, it_last);
+            RelocateOverlapping(it_last, end(), it_first);
+            size_ -= count;
+        } else {
+            std::move(it_last, end(), it_first);
+            Truncate(size_ - count);
+        }
+        return it_first;
+    }
+
+    // Удаляет все элементы, для которых pred возвращает true, за один проход.
+    // Возвращает количество удалённых элементов
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        Iterator new_end = std::remove_if(begin(), end(), pred);
+        const size_t count = static_cast<size_t>(end() - new_end);
+        Truncate(size_ - count);
+        return count;
+    }
+
+    // Удаляет элемент в позиции pos за O(1), перенося на его место последний элемент.
+    // Порядок элементов не сохраняется
+    Iterator SwapErase(ConstIterator pos) {
+        assert( (pos >= begin() && pos < end()) && "Error: Out of range!" );
+        Iterator it_pos = const_cast<Iterator>(pos);
+        if (it_pos != end() - 1) {
+            *it_pos = std::move(*(end() - 1));
+        }
+        PopBack();
+        return it_pos;
+    }
+
+    // Обменивает значение с другим вектором
+    // Буферы в куче обмениваются вместе с аллокаторами, если аллокатор распространяется при обмене,
+    // иначе аллокаторы должны быть равны. Если хотя бы один вектор во внутреннем буфере, элементы
+    // перемещаются, и каждый вектор сохраняет свой аллокатор
+    void swap(SmallSimpleVector& other) noexcept(kNothrowMoveAssign) {
+        if (!IsInline() && !other.IsInline()) {
+            if constexpr (AllocTraits::propagate_on_container_swap::value) {
+                std::swap(Allocator(), other.Allocator());
+            } else {
+                assert(Allocator() == other.Allocator());
+            }
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+            return;
+        }
+        SmallSimpleVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    // Метод резервирования ёмкости вектора
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Уменьшает вместимость до размера вектора. Если элементы помещаются во внутренний буфер,
+    // они возвращаются в него, а память в куче освобождается.
+    // Итераторы и ссылки на элементы становятся недействительными
+    void ShrinkToFit() {
+        if (IsInline() || size_ == capacity_) {
+            return;
+        }
+        if (size_ > N) {
+            Reallocate(size_);
+            return;
+        }
+        UninitializedRelocate(Allocator(), begin(), end(), InlineData());
+        AllocTraits::deallocate(Allocator(), data_, capacity_);
+        data_ = InlineData();
+        capacity_ = N;
+    }
+
+private:
+    Alloc& Allocator() noexcept {
+        return *this;
+    }
+
+    const Alloc& Allocator() const noexcept {
+        return *this;
+    }
+
+    Type* InlineData() noexcept {
+        return reinterpret_cast<Type*>(inline_);
+    }
+
+    const Type* InlineData() const noexcept {
+        return reinterpret_cast<const Type*>(inline_);
+    }
+
+    // Освобождает память в куче, если элементы хранились в ней. Элементы должны быть разрушены
+    void FreeHeap() noexcept {
+        if (!IsInline()) {
+            AllocTraits::deallocate(Allocator(), data_, capacity_);
+            data_ = InlineData();
+            capacity_ = N;
+        }
+    }
+
+    // Забирает содержимое other, оставляя его пустым. *this должен быть пуст и во внутреннем буфере.
+    // Выделяет память, только если буфер other в куче, а аллокаторы не равны
+    void TakeFrom(SmallSimpleVector& other) {
+        if (!other.IsInline() && (AllocTraits::is_always_equal::value || Allocator() == other.Allocator())) {
+            data_ = std::exchange(other.data_, other.InlineData());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+            return;
+        }
+        Reserve(other.size_);
+        UninitializedRelocate(Allocator(), other.begin(), other.end(), data_);
+        size_ = std::exchange(other.size_, 0);
+        other.FreeHeap();
+    }
+
+    // Переносит элементы в новый буфер в куче на new_capacity элементов
+    void Reallocate(size_t new_capacity) {
+        Type* new_data = AllocTraits::allocate(Allocator(), new_capacity);
+        try {
+            UninitializedRelocate(Allocator(), begin(), end(), new_data);
+        }
+        catch (...) {
+            AllocTraits::deallocate(Allocator(), new_data, new_capacity);
+            throw;
+        }
+        FreeHeap();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    // Разрушает элементы, начиная с индекса new_size
+    void Truncate(size_t new_size) noexcept {
+        DestroyRange(Allocator(), begin() + new_size, end());
+        size_ = new_size;
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos прямо в сырой памяти
+    template <typename... Args>
+    Iterator EmplaceImpl(ConstIterator pos, Args&&... args) {
+        assert( (pos >= begin() && pos <= end()) && "Error: Out of range!" );
+        const size_t index = static_cast<size_t>(pos - cbegin());
+
+        if (size_ == capacity_) {
+            // Новый элемент создаётся раньше переноса: args могут ссылаться на элементы самого вектора
+            const size_t new_capacity = 2 * capacity_;
+            Type* new_data = AllocTraits::allocate(Allocator(), new_capacity);
+            try {
+                ConstructAt(Allocator(), new_data + index, std::forward<Args>(args)...);
+                try {
+                    UninitializedTransfer(Allocator(), begin(), begin() + index, new_data);
+                    try {
+                        UninitializedTransfer(Allocator(), begin() + index, end(), new_data + index + 1);
+                    }
+                    catch (...) {
+                        DestroyRange(Allocator(), new_data, new_data + index);
+                        throw;
+                    }
+                }
+                catch (...) {
+                    DestroyAt(Allocator(), new_data + index);
+                    throw;
+                }
+            }
+            catch (...) {
+                AllocTraits::deallocate(Allocator(), new_data, new_capacity);
+                throw;
+            }
+            DestroyRange(Allocator(), begin(), end());
+            FreeHeap();
+            data_ = new_data;
+            capacity_ = new_capacity;
+            ++size_;
+            return data_ + index;
+        }
+
+        Iterator it_pos = begin() + index;
+        if (it_pos == end()) {
+            ConstructAt(Allocator(), end(), std::forward<Args>(args)...);
+        } else if constexpr (kIsTriviallyRelocatable<Type>) {
+            alignas(Type) unsigned char item[sizeof(Type)];
+            Type* new_item = reinterpret_cast<Type*>(item);
+            ConstructAt(Allocator(), new_item, std::forward<Args>(args)...);
+            RelocateOverlapping(it_pos, end(), it_pos + 1);
+            RelocateBytes(new_item, new_item + 1, it_pos);
+        } else {
+            Type tmp(std::forward<Args>(args)...);
+            ConstructAt(Allocator(), end(), std::move(*(end() - 1)));
+            std::move_backward(it_pos, end() - 1, end());
+            *it_pos = std::move(tmp);
+        }
+        ++size_;
+        return it_pos;
+    }
+
+    Type* data_;
+    size_t size_;
+    size_t capacity_;
+    alignas(Type) unsigned char inline_[N * sizeof(Type)];
+};
+
+template <typename Type, size_t N, typename Alloc>
+inline bool operator==(const SmallSimpleVector<Type, N, Alloc>& lhs, const SmallSimpleVector<Type, N, Alloc>& rhs) {
+    if constexpr (kHasSimdKernels<Type>) {
+        return SimdEqual(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t N, typename Alloc>
+inline bool operator!=(const SmallSimpleVector<Type, N, Alloc>& lhs, const SmallSimpleVector<Type, N, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename Alloc>
+inline bool operator<(const SmallSimpleVector<Type, N, Alloc>& lhs, const SmallSimpleVector<Type, N, Alloc>& rhs) {
+    if constexpr (kHasSimdKernels<Type>) {
+        return SimdLexicographicalLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+    }
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t N, typename Alloc>
+inline bool operator<=(const SmallSimpleVector<Type, N, Alloc>& lhs, const SmallSimpleVector<Type, N, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N, typename Alloc>
+inline bool operator>(const SmallSimpleVector<Type, N, Alloc>& lhs, const SmallSimpleVector<Type, N, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename Alloc>
+inline bool operator>=(const SmallSimpleVector<Type, N, Alloc>& lhs, const SmallSimpleVector<Type, N, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
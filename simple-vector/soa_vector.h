@@ -0,0 +1,489 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Непрерывный отрезок одного столбца SoAVector: элементы лежат в памяти подряд,
+// поэтому к столбцу применимы алгоритмы из vector_algorithms.h с векторными ядрами.
+// Размер столбца через отрезок изменить нельзя
+template <typename Type>
+class ColumnRange {
+public:
+    using value_type = std::remove_const_t<Type>;
+    using Iterator = Type*;
+
+    ColumnRange(Type* first, size_t size) noexcept
+        : first_(first)
+        , size_(size)
+    {}
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Type* Data() const noexcept {
+        return first_;
+    }
+
+    Type& operator[](size_t index) const noexcept {
+        assert((index < size_) && "Error: Out of range!");
+        return first_[index];
+    }
+
+    Type* begin() const noexcept {
+        return first_;
+    }
+
+    Type* end() const noexcept {
+        return first_ + size_;
+    }
+
+private:
+    Type* first_;
+    size_t size_;
+};
+
+namespace soa_vector_detail {
+
+// Строка SoAVector: кортеж ссылок на поля строки в разных столбцах.
+// Копия ссылки указывает на ту же строку, а присваивание и swap меняют значения полей,
+// как у ссылки на элемент обычного массива; swap обменивает поля без копирования.
+// Поэтому к итераторам SoAVector применимы std::sort, std::reverse и другие алгоритмы,
+// переставляющие элементы.
+// Поля доступны через std::get и структурные привязки
+template <typename... Refs>
+class RowReference : public std::tuple<Refs&...> {
+    using Base = std::tuple<Refs&...>;
+    using Indexes = std::index_sequence_for<Refs...>;
+
+public:
+    explicit RowReference(Refs&... fields) noexcept
+        : Base(fields...)
+    {}
+
+    RowReference(const RowReference&) = default;
+
+    // Присваивание кортежей значений: копирует или перемещает поля в строку
+    using Base::operator=;
+
+    // Копирует значения полей строки other. Временная ссылка (*it = std::move(*other)) тоже копируется:
+    // ссылка не владеет полями, и забирать их из строки вектора нельзя
+    RowReference& operator=(const RowReference& other) {
+        CopyFields(other, Indexes{});
+        return *this;
+    }
+
+    // Обменивает значения полей двух строк
+    friend void swap(RowReference lhs, RowReference rhs) {
+        lhs.SwapFields(rhs, Indexes{});
+    }
+
+private:
+    template <size_t... I>
+    void CopyFields(const RowReference& other, std::index_sequence<I...>) {
+        ((std::get<I>(*this) = std::get<I>(other)), ...);
+    }
+
+    template <size_t... I>
+    void SwapFields(RowReference& other, std::index_sequence<I...>) {
+        using std::swap;
+        (swap(std::get<I>(*this), std::get<I>(other)), ...);
+    }
+};
+
+}  // namespace soa_vector_detail
+
+// Протокол кортежа для структурных привязок: auto [id, price] = soa[0]
+namespace std {
+
+template <typename... Refs>
+struct tuple_size<soa_vector_detail::RowReference<Refs...>> : integral_constant<size_t, sizeof...(Refs)> {};
+
+template <size_t I, typename... Refs>
+struct tuple_element<I, soa_vector_detail::RowReference<Refs...>> {
+    using type = tuple_element_t<I, tuple<Refs&...>>;
+};
+
+}  // namespace std
+
+// Вектор записей, хранящий каждое поле в отдельном столбце (structure of arrays).
+// Проход по одному-двум полям читает только их столбцы, а не записи целиком.
+// Строки доступны как кортежи ссылок (operator[], итераторы, структурные привязки, алгоритмы std),
+// столбцы - как непрерывные отрезки (Column<I>). Все столбцы всегда одной длины:
+// если добавление строки бросает исключение, уже добавленные в неё поля удаляются
+template <typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    using Columns = std::tuple<SimpleVector<Fields>...>;
+    using Indexes = std::index_sequence_for<Fields...>;
+
+    template <typename Owner, typename Reference>
+    class BasicIterator;
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using Reference = soa_vector_detail::RowReference<Fields...>;
+    using ConstReference = soa_vector_detail::RowReference<const Fields...>;
+    using Iterator = BasicIterator<SoAVector, Reference>;
+    using ConstIterator = BasicIterator<const SoAVector, ConstReference>;
+
+    // Тип поля с номером I
+    template <size_t I>
+    using Field = std::tuple_element_t<I, value_type>;
+
+    // Создаёт пустой вектор
+    SoAVector() noexcept = default;
+
+    // Создаёт вектор из size строк со значениями полей по умолчанию
+    explicit SoAVector(size_t size) {
+        Resize(size);
+    }
+
+    // Возвращает количество строк
+    size_t GetSize() const noexcept {
+        return std::get<0>(columns_).GetSize();
+    }
+
+    // Возвращает количество строк, которое поместится без перевыделения
+    size_t GetCapacity() const noexcept {
+        return std::apply([](const auto&... column) { return std::min({column.GetCapacity()...}); }, columns_);
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Возвращает строку с индексом index как кортеж ссылок на её поля
+    Reference operator[](size_t index) noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return Row(index, Indexes{});
+    }
+
+    // Возвращает строку с индексом index как кортеж константных ссылок на её поля
+    ConstReference operator[](size_t index) const noexcept {
+        assert((index < GetSize()) && "Error: Out of range!");
+        return Row(index, Indexes{});
+    }
+
+    // Возвращает строку с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return Row(index, Indexes{});
+    }
+
+    // Возвращает строку с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    ConstReference At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Error: Out of range!");
+        }
+        return Row(index, Indexes{});
+    }
+
+    // Возвращает столбец поля I для чтения и изменения значений
+    template <size_t I>
+    ColumnRange<Field<I>> Column() noexcept {
+        SimpleVector<Field<I>>& column = std::get<I>(columns_);
+        return ColumnRange<Field<I>>(column.begin(), column.GetSize());
+    }
+
+    // Возвращает столбец поля I для чтения
+    template <size_t I>
+    ColumnRange<const Field<I>> Column() const noexcept {
+        const SimpleVector<Field<I>>& column = std::get<I>(columns_);
+        return ColumnRange<const Field<I>>(column.begin(), column.GetSize());
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Добавляет строку со значениями полей fields.
+    // Поля могут ссылаться на строки самого вектора (auto [id, price] = soa[0]; soa.PushBack(price, id)).
+    // Столбцы растут по очереди, и поле, лежащее в уже перевыделенном столбце, стало бы висячим,
+    // поэтому без свободного места строка сначала собирается в локальный кортеж
+    template <typename... Args,
+              typename = std::enable_if_t<sizeof...(Args) == sizeof...(Fields)
+                                          && !std::disjunction_v<std::is_same<std::decay_t<Args>, value_type>...>>>
+    void PushBack(Args&&... fields) {
+        if (GetSize() == GetCapacity()) {
+            PushBack(value_type(std::forward<Args>(fields)...));
+            return;
+        }
+        AppendRow(std::forward<Args>(fields)...);
+    }
+
+    // Добавляет строку из кортежа значений полей
+    void PushBack(const value_type& row) {
+        std::apply([this](const Fields&... fields) { AppendRow(fields...); }, row);
+    }
+
+    // ПЕРЕМЕЩЕНИЕ
+    // Добавляет строку из кортежа значений полей
+    void PushBack(value_type&& row) {
+        std::apply([this](Fields&... fields) { AppendRow(std::move(fields)...); }, row);
+    }
+
+    // Удаляет последнюю строку. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        ForEachColumn([](auto& column) { column.PopBack(); });
+    }
+
+    // Удаляет строку в позиции pos
+    // Возвращает итератор на строку, следующую за удалённой
+    Iterator Erase(ConstIterator pos) {
+        assert(!IsEmpty() && "Error: Vector is empty!");
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет строки [first, last), сдвигая хвост каждого столбца один раз
+    // Возвращает итератор на строку, следующую за удалёнными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t index = first.GetIndex();
+        const size_t count = static_cast<size_t>(last - first);
+        assert((index + count <= GetSize()) && "Error: Out of range!");
+        ForEachColumn([index, count](auto& column) {
+            column.Erase(column.cbegin() + index, column.cbegin() + index + count);
+        });
+        return Iterator(this, index);
+    }
+
+    // Изменяет количество строк. Новые строки получают значения полей по умолчанию
+    void Resize(size_t new_size) {
+        const size_t old_size = GetSize();
+        try {
+            ForEachColumn([new_size](auto& column) { column.Resize(new_size); });
+        }
+        catch (...) {
+            ForEachColumn([old_size](auto& column) { column.Resize(std::min(old_size, column.GetSize())); });
+            throw;
+        }
+    }
+
+    // Резервирует место под new_capacity строк во всех столбцах
+    void Reserve(size_t new_capacity) {
+        ForEachColumn([new_capacity](auto& column) { column.Reserve(new_capacity); });
+    }
+
+    // Удаляет все строки, не изменяя вместимость
+    void Clear() noexcept {
+        ForEachColumn([](auto& column) { column.Clear(); });
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SoAVector& other) noexcept {
+        std::apply([&other](auto&... column) {
+            std::apply([&column...](auto&... other_column) { (column.swap(other_column), ...); }, other.columns_);
+        }, columns_);
+    }
+
+private:
+    // Итератор произвольного доступа по строкам. Разыменование возвращает RowReference,
+    // поэтому строку удобно разбирать структурной привязкой: for (auto [id, price] : soa)
+    template <typename Owner, typename RowReference>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename SoAVector::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = RowReference;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index)
+        {}
+
+        // Неконстантный итератор приводится к константному
+        template <typename OtherOwner, typename OtherReference,
+                  typename = std::enable_if_t<std::is_const_v<Owner> && !std::is_const_v<OtherOwner>>>
+        BasicIterator(const BasicIterator<OtherOwner, OtherReference>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_)
+        {}
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ = static_cast<size_t>(static_cast<difference_type>(index_) + offset);
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            return *this += -offset;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+        // Возвращает индекс строки, на которую указывает итератор
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+    private:
+        template <typename, typename>
+        friend class BasicIterator;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    template <size_t... I>
+    Reference Row(size_t index, std::index_sequence<I...>) noexcept {
+        return Reference(std::get<I>(columns_)[index]...);
+    }
+
+    template <size_t... I>
+    ConstReference Row(size_t index, std::index_sequence<I...>) const noexcept {
+        return ConstReference(std::get<I>(columns_)[index]...);
+    }
+
+    template <typename Func>
+    void ForEachColumn(Func func) {
+        std::apply([&func](auto&... column) { (func(column), ...); }, columns_);
+    }
+
+    // Добавляет строку, поле за полем. Если поле бросает исключение, уже добавленные поля удаляются.
+    // Поля не должны ссылаться на столбцы, которые перевыделятся при добавлении
+    template <typename... Args>
+    void AppendRow(Args&&... fields) {
+        size_t pushed = 0;
+        try {
+            PushFields(pushed, Indexes{}, std::forward<Args>(fields)...);
+        }
+        catch (...) {
+            PopFields(pushed, Indexes{});
+            throw;
+        }
+    }
+
+    // Добавляет поля по столбцам по порядку; pushed - сколько столбцов уже получили значение
+    template <size_t... I, typename... Args>
+    void PushFields(size_t& pushed, std::index_sequence<I...>, Args&&... fields) {
+        ((std::get<I>(columns_).EmplaceBack(std::forward<Args>(fields)), ++pushed), ...);
+    }
+
+    // Удаляет последний элемент из первых count столбцов
+    template <size_t... I>
+    void PopFields(size_t count, std::index_sequence<I...>) noexcept {
+        ((I < count ? std::get<I>(columns_).PopBack() : void()), ...);
+    }
+
+    Columns columns_;
+};
+
+template <typename... Fields>
+inline bool operator==(const SoAVector<Fields...>& lhs, const SoAVector<Fields...>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename... Fields>
+inline bool operator!=(const SoAVector<Fields...>& lhs, const SoAVector<Fields...>& rhs) {
+    return !(lhs == rhs);
+}
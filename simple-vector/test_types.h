@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+// Типы элементов, общие для тестов (tests.h) и бенчмарков (bench.cpp)
+
+// Некопируемый тип: поддерживает только перемещение
+class X {
+public:
+
+    X()
+        : X(5)
+    {}
+
+    X(size_t num)
+        : x_(num)
+    {}
+
+    // Запрет копирования
+    X(const X& other) = delete;
+    // и присваивания копированием
+    X& operator=(const X& other) = delete;
+
+    X(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+    }
+    X& operator=(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+        return *this;
+    }
+
+    size_t GetX() const {
+        return x_;
+    }
+
+private:
+    size_t x_;
+};
@@ -1,43 +1,47 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 
-#include "simple_vector.h"
-
-
-class X {
-public:
-
-    X()
-        : X(5)
-    {}
-
-    X(size_t num)
-        : x_(num)
-    {}
+#include <fcntl.h>
+#include <unistd.h>
 
-    // Запрет копирования
-    X(const X& other) = delete;
-    // и присваивания копированием
-    X& operator=(const X& other) = delete;
-
-    X(X&& other) {
-        x_ = std::exchange(other.x_, 0);
-    }
-    X& operator=(X&& other) {
-        x_ = std::exchange(other.x_, 0);
-        return *this;
-    }
-
-    size_t GetX() const {
-        return x_;
-    }
+#include "aligned_allocator.h"
+#include "arena_allocator.h"
+#include "bit_vector.h"
+#include "compressed_int_vector.h"
+#include "concurrent_simple_vector.h"
+#include "constexpr_support.h"
+#include "fixed_vector.h"
+#include "flat_containers.h"
+#include "instrumentation.h"
+#include "mapped_simple_vector.h"
+#include "parallel_algorithms.h"
+#include "pool_allocator.h"
+#include "segmented_simple_vector.h"
+#include "serialization.h"
+#include "shared_simple_vector.h"
+#include "simple_vector.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "test_types.h"
+#include "vector_algorithms.h"
 
-private:
-    size_t x_;
-};
 
 SimpleVector<int> GenerateVector(size_t size) {
     SimpleVector<int> v(size);
@@ -430,3 +434,2340 @@ inline void SetTest2() {
         }
         std::cout << "Done!" << std::endl;
     }
+
+// -----------Тесты сырой (неинициализированной) ёмкости
+
+// Тип без конструктора по умолчанию, считающий живые экземпляры
+class Counted {
+public:
+    explicit Counted(int value)
+        : value_(value)
+    {
+        ++alive;
+    }
+
+    Counted(const Counted& other)
+        : value_(other.value_)
+    {
+        ++alive;
+        ++copies;
+    }
+
+    Counted(Counted&& other) noexcept
+        : value_(std::exchange(other.value_, 0))
+    {
+        ++alive;
+        ++moves;
+    }
+
+    Counted& operator=(const Counted& other) {
+        value_ = other.value_;
+        ++copies;
+        return *this;
+    }
+
+    Counted& operator=(Counted&& other) noexcept {
+        value_ = std::exchange(other.value_, 0);
+        ++moves;
+        return *this;
+    }
+
+    ~Counted() {
+        --alive;
+    }
+
+    int GetValue() const {
+        return value_;
+    }
+
+    static inline int alive = 0;
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+private:
+    int value_;
+};
+
+void TestRawCapacity() {
+    std::cout << "Test raw capacity" << std::endl;
+    Counted::alive = 0;
+    {
+        // Резервирование не создаёт элементы
+        SimpleVector<Counted> v(Reserve(100));
+        assert(v.GetCapacity() == 100);
+        assert(Counted::alive == 0);
+
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(Counted(i));
+        }
+        assert(Counted::alive == 10);
+
+        v.Reserve(1000);
+        assert(Counted::alive == 10);
+        assert(v[9].GetValue() == 9);
+
+        v.Insert(v.begin() + 5, Counted(42));
+        assert(Counted::alive == 11);
+        assert(v[5].GetValue() == 42);
+
+        // Удалённые элементы действительно разрушаются
+        v.PopBack();
+        assert(Counted::alive == 10);
+        v.Erase(v.begin());
+        assert(Counted::alive == 9);
+        assert(v[0].GetValue() == 1);
+        while (v.GetSize() > 3) {
+            v.PopBack();
+        }
+        assert(Counted::alive == 3);
+        v.Clear();
+        assert(Counted::alive == 0);
+        assert(v.GetCapacity() == 1000);
+
+        for (int i = 0; i < 20; ++i) {
+            v.PushBack(Counted(i));
+        }
+    }
+    assert(Counted::alive == 0);
+
+    // Вставка с перевыделением памяти элемента самого вектора
+    {
+        SimpleVector<Counted> v;
+        v.PushBack(Counted(1));
+        v.PushBack(Counted(2));
+        assert(v.GetSize() == v.GetCapacity());
+        v.PushBack(v[0]);
+        v.Insert(v.begin(), v[2]);
+        assert(v[0].GetValue() == 1);
+        assert(v[3].GetValue() == 1);
+    }
+    assert(Counted::alive == 0);
+    std::cout << "Done!" << std::endl;
+}
+
+void TestResizeForOverwrite() {
+    std::cout << "Test resize for overwrite" << std::endl;
+    SimpleVector<int> v{1, 2, 3};
+    v.ResizeForOverwrite(1000);
+    assert(v.GetSize() == 1000);
+    assert(v.GetCapacity() >= v.GetSize());
+    assert(v[0] == 1 && v[2] == 3);
+    std::iota(v.begin() + 3, v.end(), 4);
+    assert(v[999] == 1000);
+
+    v.ResizeForOverwrite(2);
+    assert(v.GetSize() == 2);
+    assert(v[1] == 2);
+
+    // Resize по-прежнему инициализирует новые элементы значением
+    v.Resize(5);
+    assert(v[2] == 0 && v[4] == 0);
+    std::cout << "Done!" << std::endl;
+}
+
+void TestMoveStealsBuffer() {
+    std::cout << "Test move steals buffer" << std::endl;
+    static_assert(std::is_nothrow_move_constructible_v<SimpleVector<Counted>>);
+    static_assert(std::is_nothrow_move_assignable_v<SimpleVector<Counted>>);
+    static_assert(std::is_nothrow_move_constructible_v<ArrayPtr<Counted>>);
+    static_assert(std::is_nothrow_move_assignable_v<ArrayPtr<Counted>>);
+
+    Counted::alive = 0;
+    {
+        SimpleVector<Counted> v(Reserve(8));
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(Counted(i));
+        }
+        const Counted* const data = &v[0];
+        const size_t capacity = v.GetCapacity();
+        Counted::copies = 0;
+        Counted::moves = 0;
+
+        // Конструктор перемещения
+        SimpleVector<Counted> moved(std::move(v));
+        assert(&moved[0] == data);
+        assert(moved.GetSize() == 5);
+        assert(moved.GetCapacity() == capacity);
+        assert(v.GetSize() == 0 && v.GetCapacity() == 0);
+        assert(v.begin() == nullptr);
+
+        // Присваивание перемещением освобождает прежние элементы получателя
+        SimpleVector<Counted> target;
+        target.PushBack(Counted(100));
+        Counted::moves = 0;
+        target = std::move(moved);
+        assert(&target[0] == data);
+        assert(target.GetSize() == 5);
+        assert(moved.GetSize() == 0 && moved.GetCapacity() == 0);
+        assert(Counted::alive == 5);
+
+        // Ни один элемент не был ни скопирован, ни перемещён
+        assert(Counted::copies == 0);
+        assert(Counted::moves == 0);
+        assert(target[4].GetValue() == 4);
+
+        // Перемещённый вектор остаётся пригодным к использованию
+        v.PushBack(Counted(7));
+        assert(v.GetSize() == 1 && v[0].GetValue() == 7);
+    }
+    assert(Counted::alive == 0);
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты тривиально перемещаемых типов
+
+// Владеющий тип, явно помеченный как тривиально перемещаемый
+class Handle {
+public:
+    explicit Handle(int value)
+        : value_(std::make_unique<int>(value))
+    {}
+
+    Handle(Handle&& other) noexcept
+        : value_(std::move(other.value_))
+    {
+        ++moves;
+    }
+
+    Handle& operator=(Handle&& other) noexcept {
+        value_ = std::move(other.value_);
+        ++moves;
+        return *this;
+    }
+
+    int GetValue() const {
+        return *value_;
+    }
+
+    static inline int moves = 0;
+
+private:
+    std::unique_ptr<int> value_;
+};
+
+template <>
+struct IsTriviallyRelocatable<Handle> : std::true_type {};
+
+void TestTriviallyRelocatable() {
+    std::cout << "Test trivially relocatable" << std::endl;
+    static_assert(kIsTriviallyRelocatable<int>);
+    static_assert(kIsTriviallyRelocatable<std::unique_ptr<int>>);
+    static_assert(!kIsTriviallyRelocatable<X>);
+
+    // Рост, вставка и удаление переносят элементы побайтово, без вызова перемещения
+    {
+        Handle::moves = 0;
+        SimpleVector<Handle> v;
+        const int size = 100;
+        for (int i = 0; i < size; ++i) {
+            v.PushBack(Handle(i));
+        }
+        // ровно одно перемещение на каждый PushBack, сколько бы раз ни рос буфер
+        assert(Handle::moves == size);
+
+        v.Insert(v.begin(), Handle(-1));
+        v.Insert(v.begin() + 50, Handle(-2));
+        assert(Handle::moves == size + 2);
+        assert(v[0].GetValue() == -1);
+        assert(v[50].GetValue() == -2);
+        assert(v[51].GetValue() == 49);
+
+        v.Erase(v.begin() + 50);
+        v.Erase(v.begin());
+        assert(Handle::moves == size + 2);
+        assert(v.GetSize() == static_cast<size_t>(size));
+        for (int i = 0; i < size; ++i) {
+            assert(v[i].GetValue() == i);
+        }
+
+        // Вставка элемента самого вектора при полном буфере
+        SimpleVector<Handle> w;
+        w.PushBack(Handle(1));
+        w.PushBack(Handle(2));
+        assert(w.GetSize() == w.GetCapacity());
+        w.Insert(w.begin(), std::move(w[1]));
+        assert(w[0].GetValue() == 2);
+        assert(w[1].GetValue() == 1);
+    }
+
+    // Сдвиги memmove для тривиально копируемых типов
+    {
+        SimpleVector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.Insert(v.begin() + v.GetSize() / 2, i);
+        }
+        assert((v == SimpleVector<int>{1, 3, 5, 7, 9, 8, 6, 4, 2, 0}));
+        v.Erase(v.begin() + 4);
+        v.Erase(v.end() - 1);
+        v.Erase(v.begin());
+        assert((v == SimpleVector<int>{3, 5, 7, 8, 6, 4, 2}));
+        v.Insert(v.begin() + 3, v[0]);
+        assert((v == SimpleVector<int>{3, 5, 7, 3, 8, 6, 4, 2}));
+        v.Reserve(1000);
+        v.Resize(2000);
+        assert(v[7] == 2 && v[1999] == 0);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты аллокаторов
+
+void TestArenaAllocator() {
+    std::cout << "Test arena allocator" << std::endl;
+    // Пустой аллокатор не увеличивает размер буфера
+    static_assert(sizeof(ArrayPtr<int>) == 2 * sizeof(void*));
+
+    MonotonicArena arena(4096);
+    for (int request = 0; request < 3; ++request) {
+        {
+            SimpleVector<int, ArenaAllocator<int>> v(arena);
+            v.Reserve(16);
+            const int* const data = v.begin();
+            // Последнее выделение в арене расширяется на месте
+            v.Reserve(256);
+            assert(v.begin() == data);
+            for (int i = 0; i < 256; ++i) {
+                v.PushBack(i);
+            }
+            assert(v.begin() == data);
+
+            SimpleVector<std::string, ArenaAllocator<std::string>> names(Reserve(4), arena);
+            names.PushBack("alpha");
+            names.PushBack(std::string(100, 'b'));
+            names.Insert(names.begin(), "gamma");
+            assert(names[0] == "gamma" && names[2].size() == 100);
+
+            auto copy = v;
+            assert(copy == v);
+            assert(copy.GetAllocator() == v.GetAllocator());
+            assert(arena.GetBytesAllocated() > 0);
+        }
+        // Вся память запроса освобождается одним Reset, блоки переиспользуются
+        arena.Reset();
+        assert(arena.GetBytesAllocated() == 0);
+        assert(arena.GetBlockCount() == 1);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestPoolAllocator() {
+    std::cout << "Test pool allocator" << std::endl;
+    SizeClassPool pool;
+    {
+        SimpleVector<int, PoolAllocator<int>> v(pool);
+        v.Reserve(5);
+        const int* const data = v.begin();
+        // 5 и 8 элементов int попадают в один класс размеров (32 байта)
+        v.Reserve(8);
+        assert(v.begin() == data);
+        for (int i = 0; i < 100000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v[99999] == 99999);
+
+        // Освобождённые блоки переиспользуются без новых плит
+        size_t slabs = 0;
+        for (int i = 0; i < 1000; ++i) {
+            SimpleVector<std::string, PoolAllocator<std::string>> words(pool);
+            words.PushBack("hello");
+            words.PushBack("world");
+            words.PushBack(std::string(64, 'x'));
+            if (i == 0) {
+                slabs = pool.GetSlabCount();
+            }
+        }
+        assert(pool.GetSlabCount() == slabs);
+    }
+    pool.Reset();
+    assert(pool.GetSlabCount() == 0);
+    std::cout << "Done!" << std::endl;
+}
+
+void TestPmrSimpleVector() {
+    std::cout << "Test pmr simple vector" << std::endl;
+    MonotonicArena arena;
+    SizeClassPool pool;
+    {
+        PmrSimpleVector<std::pmr::string> v(&arena);
+        v.PushBack(std::pmr::string("a long string that does not fit in the small buffer"));
+        v.Resize(3);
+        // Аллокатор передаётся вложенным pmr-контейнерам
+        for (const auto& item : v) {
+            assert(item.get_allocator().resource() == &arena);
+        }
+
+        // Присваивание перемещением между разными ресурсами переносит элементы поштучно
+        PmrSimpleVector<std::pmr::string> other(&pool);
+        other = std::move(v);
+        assert(other.GetSize() == 3);
+        assert(other.GetAllocator().resource() == &pool);
+        assert(other[0].get_allocator().resource() == &pool);
+        assert(other[0] == "a long string that does not fit in the small buffer");
+
+        // Копирование берёт ресурс по умолчанию
+        PmrSimpleVector<std::pmr::string> copy(other);
+        assert(copy.GetAllocator().resource() == std::pmr::get_default_resource());
+        assert(copy == other);
+
+        // Перемещение в пределах одного ресурса забирает буфер
+        const std::pmr::string* const data = other.begin();
+        PmrSimpleVector<std::pmr::string> moved(std::move(other));
+        assert(moved.begin() == data);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestAlignedAllocators() {
+    std::cout << "Test aligned allocators" << std::endl;
+    auto is_aligned = [](const void* ptr, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+    };
+    {
+        AlignedSimpleVector<char> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(static_cast<char>(i));
+            assert(is_aligned(v.begin(), 64));
+        }
+        AlignedSimpleVector<std::string, 4096> names{"alpha", "beta"};
+        names.Insert(names.begin(), std::string(100, 'x'));
+        assert(is_aligned(names.begin(), 4096));
+        assert(names[0].size() == 100 && names[2] == "beta");
+        static_assert(sizeof(AlignedSimpleVector<int>) == sizeof(SimpleVector<int>));
+    }
+    {
+        using Allocator = HugePageAllocator<int>;
+        const size_t huge_size = 2 * 1024 * 1024 / sizeof(int);
+        static_assert(!Allocator::IsHuge(huge_size - 1) && Allocator::IsHuge(huge_size));
+
+        HugePageSimpleVector<int> v;
+        for (int i = 0; i < 1000000; ++i) {
+            v.PushBack(i);
+            if (i % 1000 == 0) {
+                assert(is_aligned(v.begin(), 64));
+            }
+        }
+        // Большой буфер начинается с большой страницы и занимает их целое число
+        assert(is_aligned(v.begin(), 2 * 1024 * 1024));
+        assert(v.GetCapacity() * sizeof(int) % (2 * 1024 * 1024) == 0);
+        assert(v[999999] == 999999);
+
+        // Копия большого вектора тоже на больших страницах, а после сжатия - в обычной куче
+        HugePageSimpleVector<int> copy = v;
+        assert(copy == v && is_aligned(copy.begin(), 2 * 1024 * 1024));
+        copy.Resize(10);
+        HugePageSimpleVector<int> small = copy;
+        assert(small.GetCapacity() == 10 && small[9] == 9);
+
+        // Без пула hugetlbfs MAP_HUGETLB откатывается на прозрачные большие страницы
+        HugePageSimpleVector<int, HugePageMode::kHugeTlb> explicit_pages(huge_size * 3, 7);
+        assert(is_aligned(explicit_pages.begin(), 2 * 1024 * 1024));
+        assert(explicit_pages[huge_size * 3 - 1] == 7);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты SmallSimpleVector
+
+void TestSmallSimpleVector() {
+    std::cout << "Test small simple vector" << std::endl;
+    {
+        SmallSimpleVector<int, 8> v;
+        assert(v.GetCapacity() == 8);
+        assert(v.IsInline());
+        for (int i = 0; i < 8; ++i) {
+            v.PushBack(i);
+        }
+        // До N элементов куча не используется
+        assert(v.IsInline());
+        v.Insert(v.begin(), -1);
+        assert(!v.IsInline());
+        assert(v.GetCapacity() == 16);
+        assert(v[0] == -1 && v[8] == 7);
+        v.Erase(v.begin());
+        assert((v == SmallSimpleVector<int, 8>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+        // Перемещение вектора из кучи забирает буфер
+        const int* const data = v.begin();
+        SmallSimpleVector<int, 8> moved(std::move(v));
+        assert(moved.begin() == data);
+        assert(v.IsEmpty() && v.IsInline());
+    }
+    {
+        Counted::alive = 0;
+        SmallSimpleVector<Counted, 4> a;
+        SmallSimpleVector<Counted, 4> b;
+        for (int i = 0; i < 3; ++i) {
+            a.PushBack(Counted(i));
+        }
+        for (int i = 0; i < 6; ++i) {
+            b.PushBack(Counted(10 + i));
+        }
+        assert(a.IsInline() && !b.IsInline());
+        a.swap(b);
+        assert(a.GetSize() == 6 && b.GetSize() == 3);
+        assert(a[5].GetValue() == 15 && b[2].GetValue() == 2);
+        assert(b.IsInline());
+
+        // Вставка элемента самого вектора во внутреннем буфере
+        b.Insert(b.begin(), b[2]);
+        assert(b[0].GetValue() == 2 && b[3].GetValue() == 2);
+        auto copy = a;
+        assert(copy.GetSize() == a.GetSize() && copy[0].GetValue() == 10);
+        a.Clear();
+        b.PopBack();
+        assert(Counted::alive == 9);
+    }
+    assert(Counted::alive == 0);
+    {
+        SmallSimpleVector<X, 2> v;
+        for (size_t i = 0; i < 5; ++i) {
+            v.Insert(v.begin(), X(i));
+        }
+        assert(v[0].GetX() == 4 && v[4].GetX() == 0);
+        auto it = v.Erase(v.begin() + 1);
+        assert(it->GetX() == 2);
+        v.Resize(10);
+        assert(v[9].GetX() == 5);
+    }
+    // С неравными нераспространяемыми аллокаторами присваивание перемещением выделяет память,
+    // поэтому оно (и swap) не объявлены noexcept; конструктор перемещения копирует аллокатор и не выделяет
+    {
+        using PoolVector = SmallSimpleVector<int, 2, PoolAllocator<int>>;
+        static_assert(std::is_nothrow_move_constructible_v<PoolVector>);
+        static_assert(!std::is_nothrow_move_assignable_v<PoolVector>);
+        static_assert(!std::is_nothrow_swappable_v<PoolVector>);
+        static_assert(std::is_nothrow_move_assignable_v<SmallSimpleVector<int, 2>>);
+
+        SizeClassPool first_pool;
+        SizeClassPool second_pool;
+        PoolVector a(first_pool);
+        PoolVector b(second_pool);
+        for (int i = 0; i < 10; ++i) {
+            a.PushBack(i);
+        }
+        b = std::move(a);
+        assert(a.IsEmpty() && b.GetSize() == 10 && b[9] == 9);
+        assert(b.GetAllocator().GetPool() == &second_pool);
+        PoolVector c(std::move(b));
+        assert(b.IsEmpty() && c.GetSize() == 10 && c.GetAllocator().GetPool() == &second_pool);
+    }
+    // Аллокатор, распространяемый при обмене, переезжает вместе с буфером в куче
+    {
+        struct SwappingPoolAllocator : PoolAllocator<int> {
+            using propagate_on_container_swap = std::true_type;
+            using PoolAllocator<int>::PoolAllocator;
+        };
+        SizeClassPool first_pool;
+        SizeClassPool second_pool;
+        SmallSimpleVector<int, 2, SwappingPoolAllocator> a(SwappingPoolAllocator{first_pool});
+        SmallSimpleVector<int, 2, SwappingPoolAllocator> b(SwappingPoolAllocator{second_pool});
+        for (int i = 0; i < 10; ++i) {
+            a.PushBack(i);
+            b.PushBack(-i);
+        }
+        a.swap(b);
+        assert(a[9] == -9 && b[9] == 9);
+        assert(a.GetAllocator().GetPool() == &second_pool && b.GetAllocator().GetPool() == &first_pool);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты FixedVector и вычислений при компиляции
+
+// Таблица квадратов, построенная при компиляции: FixedVector тривиального типа constexpr уже в C++17
+constexpr FixedVector<int, 16> MakeSquares() {
+    FixedVector<int, 16> squares;
+    for (int i = 0; i < 10; ++i) {
+        squares.PushBack(i * i);
+    }
+    squares.Insert(squares.begin(), -1);
+    squares.Erase(squares.begin() + 1, squares.begin() + 3);
+    squares.EraseIf([](int x) { return x % 2 == 0; });
+    squares.Emplace(squares.begin() + 1, 7);
+    return squares;
+}
+
+inline constexpr FixedVector<int, 16> kSquares = MakeSquares();
+static_assert(kSquares.GetSize() == 6);
+static_assert(kSquares == FixedVector<int, 16>{-1, 7, 9, 25, 49, 81});
+static_assert(FixedVector<int, 4>{1, 2} < FixedVector<int, 4>{1, 3});
+
+#if SIMPLE_VECTOR_HAS_CONSTEXPR && !SIMPLE_VECTOR_INSTRUMENTATION
+// В C++20 таблица строится в SimpleVector (память выделяется при компиляции и освобождается
+// до её конца), а результат копируется в FixedVector, который можно сохранить в константе
+constexpr FixedVector<int, 32> MakePrimes() {
+    SimpleVector<int> primes;
+    for (int n = 2; primes.GetSize() < 20; ++n) {
+        bool prime = true;
+        for (int p : primes) {
+            prime = prime && n % p != 0;
+        }
+        if (prime) {
+            primes.PushBack(n);
+        }
+    }
+    primes.Insert(primes.begin(), 3, 0);
+    primes.Erase(primes.begin(), primes.begin() + 3);
+    SimpleVector<int> copy = primes;
+    copy.Append({100, 200});
+    if (!(primes < copy) || primes == copy) {
+        throw std::logic_error("Error: Wrong comparison!");
+    }
+    return FixedVector<int, 32>(primes.begin(), primes.end());
+}
+
+inline constexpr FixedVector<int, 32> kPrimes = MakePrimes();
+static_assert(kPrimes.GetSize() == 20 && kPrimes[0] == 2 && kPrimes[19] == 71);
+
+constexpr size_t ConstexprStrings() {
+    SimpleVector<std::string> words{"alpha", "beta"};
+    words.Insert(words.begin(), std::string("gamma"));
+    words.Insert(words.begin() + 1, words[0]);
+    words.Emplace(words.end(), 3, 'x');
+    words.SwapErase(words.begin());
+    words.Resize(6);
+    words.ShrinkToFit();
+    size_t total = 0;
+    for (const std::string& word : words) {
+        total += word.size();
+    }
+    return total + words.GetCapacity();
+}
+
+static_assert(ConstexprStrings() == 3 + 5 + 5 + 4 + 6);
+#endif
+
+void TestFixedVector() {
+    std::cout << "Test fixed vector" << std::endl;
+    {
+        FixedVector<int, 8> v{1, 2, 3};
+        assert(v.GetCapacity() == 8 && v.GetSize() == 3);
+        const int* const data = v.begin();
+        v.Insert(v.begin() + 1, 3, 9);
+        assert((v == FixedVector<int, 8>{1, 9, 9, 9, 2, 3}));
+        // Буфер не переезжает: вставка элемента самого вектора и итераторы остаются корректны
+        v.Insert(v.begin(), v[5]);
+        assert(v.begin() == data && v[0] == 3 && v.GetSize() == 7);
+        v.PushBack(4);
+        assert(v.IsFull());
+        try {
+            v.PushBack(5);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+        try {
+            v.Insert(v.begin(), {1, 2});
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+        assert(v.GetSize() == 8 && v[7] == 4);
+        assert(v.SwapErase(v.begin()) == v.begin() && v[0] == 4);
+        assert(v.EraseIf([](int x) { return x == 9; }) == 3);
+        assert((v == FixedVector<int, 8>{4, 1, 2, 3}));
+        v.Resize(6);
+        assert(v[5] == 0);
+        v.ResizeForOverwrite(2);
+        assert((v == FixedVector<int, 8>{4, 1}));
+        try {
+            v.Reserve(9);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+
+        // Диапазон input-итераторов собирается во временный вектор
+        std::istringstream input("5 6 7");
+        v.Insert(v.begin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert((v == FixedVector<int, 8>{4, 5, 6, 7, 1}));
+        FixedVector<int, 8> other(3, 1);
+        v.swap(other);
+        assert(v.GetSize() == 3 && other.GetSize() == 5 && other[4] == 1);
+        assert(v < other && other > v && v != other);
+        static_assert(std::is_trivially_copyable_v<FixedVector<int, 8>>);
+    }
+    {
+        Counted::alive = 0;
+        {
+            FixedVector<Counted, 6> a;
+            a.EmplaceBack(1);
+            a.PushBack(Counted(2));
+            a.Emplace(a.begin(), 0);
+            a.Insert(a.begin() + 1, a[2]);
+            assert(a.GetSize() == 4 && a[0].GetValue() == 0 && a[1].GetValue() == 2 && a[3].GetValue() == 2);
+            FixedVector<Counted, 6> b = a;
+            b.Erase(b.begin(), b.begin() + 2);
+            assert(b.GetSize() == 2 && b[0].GetValue() == 1);
+            a.swap(b);
+            assert(a.GetSize() == 2 && b.GetSize() == 4 && b[3].GetValue() == 2);
+            b = a;
+            assert(b.GetSize() == 2 && b[1].GetValue() == 2);
+            FixedVector<Counted, 6> moved(std::move(a));
+            assert(moved.GetSize() == 2 && moved[0].GetValue() == 1);
+            moved.PopBack();
+            assert(Counted::alive == 2 + 2 + 1);
+        }
+        assert(Counted::alive == 0);
+    }
+    {
+        FixedVector<X, 4> v;
+        for (size_t i = 0; i < 4; ++i) {
+            v.Insert(v.begin(), X(i));
+        }
+        assert(v[0].GetX() == 3 && v[3].GetX() == 0);
+        v.Erase(v.begin() + 1);
+        v.Resize(4);
+        assert(v[3].GetX() == 5);
+        FixedVector<std::string, 4> words{"a", "b"};
+        words.Append(FixedVector<std::string, 4>{"c", "d"});
+        assert(words.IsFull() && words[3] == "d");
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты SharedSimpleVector
+
+void TestSharedSimpleVector() {
+    std::cout << "Test shared simple vector" << std::endl;
+    {
+        SharedSimpleVector<std::string> config{"alpha", "beta", "gamma"};
+        assert(config.UseCount() == 1 && !config.IsShared());
+
+        // Копия разделяет буфер и не копирует элементы
+        SharedSimpleVector<std::string> copy = config;
+        assert(copy.IsShared() && config.UseCount() == 2);
+        assert(copy.Get().begin() == config.Get().begin());
+        const SharedSimpleVector<std::string>& reader = copy;
+        assert(reader[1] == "beta" && reader.At(2) == "gamma" && reader == config);
+        assert(copy.IsShared());
+
+        // Первое изменение клонирует буфер, исходный вектор не меняется
+        copy[0] = "changed";
+        assert(!copy.IsShared() && !config.IsShared());
+        assert(std::as_const(config)[0] == "alpha" && copy[0] == "changed");
+        copy.PushBack("delta");
+        const std::string* const data = copy.Get().begin();
+        copy.Insert(copy.cbegin() + 1, "inserted");
+        copy.Erase(copy.cbegin() + 2);
+        assert(copy.GetSize() == 4 && copy[1] == "inserted" && copy[3] == "delta");
+        // Собственный буфер больше не клонируется
+        assert(copy.Get().begin() == data);
+        // Вставка в разделённый буфер клонирует его сразу с запасом под новый элемент
+        SharedSimpleVector<std::string> grown = config;
+        grown.PushBack("delta");
+        assert(grown.GetCapacity() == 4 && config.GetCapacity() == 3);
+
+        // Каждая мутация разделённого буфера оставляет копии нетронутыми
+        SharedSimpleVector<std::string> a = config;
+        SharedSimpleVector<std::string> b = config;
+        a.PushBack("a");
+        b.Erase(b.cbegin());
+        SharedSimpleVector<std::string> c = config;
+        c.PopBack();
+        assert(config.GetSize() == 3 && a.GetSize() == 4 && b.GetSize() == 2 && c.GetSize() == 2);
+        assert(b[0] == "beta" && config.UseCount() == 1);
+
+        // Неконстантные итераторы тоже клонируют
+        SharedSimpleVector<std::string> d = config;
+        for (std::string& item : d) {
+            item += "!";
+        }
+        assert(d[2] == "gamma!" && std::as_const(config)[2] == "gamma");
+
+        // Clear разделённого вектора просто отпускает буфер
+        SharedSimpleVector<std::string> e = config;
+        e.Clear();
+        assert(e.IsEmpty() && e.UseCount() == 0 && config.UseCount() == 1);
+
+        SharedSimpleVector<std::string> f = config;
+        f.Unshare();
+        assert(!f.IsShared() && f.Get().begin() != config.Get().begin() && f == config);
+        f.Resize(5);
+        assert(f[4].empty() && config.GetSize() == 3);
+
+        // Изменяемая ссылка, полученная до копирования, не меняет копию: буфер клонируется при копировании
+        SharedSimpleVector<int> g{1, 2, 3};
+        int& first = g[0];
+        SharedSimpleVector<int> h = g;
+        first = 42;
+        assert(h[0] == 1 && g[0] == 42 && !g.IsShared());
+        auto it = g.begin();
+        SharedSimpleVector<int> k = g;
+        *it = 7;
+        assert(std::as_const(k)[0] == 42);
+        // Clear выданных ссылок не оставляет: копии снова разделяют буфер
+        g.Clear();
+        g.PushBack(5);
+        SharedSimpleVector<int> m = g;
+        assert(g.IsShared() && m.UseCount() == 2);
+    }
+    {
+        SharedSimpleVector<int> empty;
+        assert(empty.UseCount() == 0 && empty.begin() == empty.end());
+        SharedSimpleVector<int> copy = empty;
+        copy.PushBack(1);
+        assert(empty.IsEmpty() && copy.GetSize() == 1);
+
+        SharedSimpleVector<int> adopted(GenerateVector(100));
+        assert(adopted.GetSize() == 100 && adopted[99] == 100);
+        assert((SharedSimpleVector<int>{1, 2} < SharedSimpleVector<int>{1, 3}));
+        try {
+            adopted.At(100);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+    }
+    // Копии из разных потоков: чтение общего буфера и независимые изменения
+    {
+        const SharedSimpleVector<int> snapshot(GenerateVector(1000));
+        SimpleVector<std::thread> workers;
+        SimpleVector<long> sums(4, 0);
+        for (size_t t = 0; t < 4; ++t) {
+            workers.PushBack(std::thread([&snapshot, &sums, t] {
+                for (int round = 0; round < 100; ++round) {
+                    SharedSimpleVector<int> local = snapshot;
+                    long sum = 0;
+                    for (int item : std::as_const(local)) {
+                        sum += item;
+                    }
+                    if (round % 10 == 0) {
+                        local.PushBack(static_cast<int>(t));
+                        sum += local[1000] - static_cast<long>(t);
+                    }
+                    sums[t] += sum;
+                }
+            }));
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        for (long sum : sums) {
+            assert(sum == 100L * 500500);
+        }
+        assert(snapshot.UseCount() == 1 && snapshot.GetSize() == 1000);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты FlatSet и FlatMap
+
+void TestFlatContainers() {
+    std::cout << "Test flat containers" << std::endl;
+    // Поиск без ветвлений совпадает с std::lower_bound, в том числе для отсутствующих ключей
+    {
+        std::mt19937 generator(42);
+        for (size_t size : {0, 1, 2, 3, 7, 8, 100, 1000}) {
+            SimpleVector<int> sorted(size);
+            for (size_t i = 0; i < size; ++i) {
+                sorted[i] = static_cast<int>(i * 2);
+            }
+            EytzingerIndex<int, std::less<int>> index;
+            index.Build(sorted.begin(), size);
+            assert(index.IsBuilt());
+            for (int key = -1; key <= static_cast<int>(size * 2) + 1; ++key) {
+                const size_t expected = static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+                assert(BranchlessLowerBound(sorted.begin(), size, key, std::less<int>()) == expected);
+                assert(index.LowerBound(key, std::less<int>()) == expected);
+            }
+        }
+    }
+    {
+        FlatSet<int> set{5, 1, 3, 1};
+        assert(set.GetSize() == 3 && set.Contains(3) && !set.Contains(2) && set.Count(5) == 1);
+        auto [it, inserted] = set.Insert(2);
+        assert(inserted && *it == 2 && set.Keys() == (SimpleVector<int>{1, 2, 3, 5}));
+        assert(!set.Insert(2).second && set.GetSize() == 4);
+
+        // Пакетная вставка: дубликаты внутри пакета и с имеющимися ключами отбрасываются
+        const SimpleVector<int> batch{9, 4, 3, 9, 0, 7};
+        set.Insert(batch.begin(), batch.end());
+        assert(set.Keys() == (SimpleVector<int>{0, 1, 2, 3, 4, 5, 7, 9}));
+        assert(*set.LowerBound(6) == 7 && *set.UpperBound(7) == 9 && set.LowerBound(10) == set.end());
+        assert(set.Erase(4) == 1 && set.Erase(4) == 0 && set.Find(4) == set.end());
+        assert(set.EraseIf([](int key) { return key % 2 == 0; }) == 2);
+        assert(set == (FlatSet<int>{1, 3, 5, 7, 9}));
+
+        // Индекс Эйтцингера действует до первого изменения
+        set.BuildSearchIndex();
+        assert(set.HasSearchIndex() && *set.Find(7) == 7 && set.Find(8) == set.end());
+        set.Insert(8);
+        assert(!set.HasSearchIndex() && set.Contains(8));
+
+        FlatSet<std::string, std::greater<std::string>> words{"b", "c", "a"};
+        assert(*words.begin() == "c" && words.Contains("a"));
+    }
+    {
+        FlatMap<std::string, int> map{{"one", 1}, {"three", 3}};
+        assert(map.GetSize() == 2 && map.At("three") == 3 && !map.Contains("two"));
+        map["two"] = 2;
+        ++map["one"];
+        assert(map.At("one") == 2 && map.Keys() == (SimpleVector<std::string>{"one", "three", "two"}));
+        assert(!map.Insert("two", 20).second && map.At("two") == 2);
+        assert(!map.InsertOrAssign("two", 22).second && map.At("two") == 22);
+        try {
+            map.At("four");
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+
+        // Из пар пакета с равными ключами остаётся первая, имевшиеся значения не меняются
+        const SimpleVector<std::pair<std::string, int>> batch{{"four", 4}, {"five", 5}, {"four", 40}, {"one", 100}};
+        map.Insert(batch.begin(), batch.end());
+        assert(map.GetSize() == 5 && map.At("four") == 4 && map.At("one") == 2);
+        std::string keys;
+        for (auto [key, value] : std::as_const(map)) {
+            keys += key + "=" + std::to_string(value) + " ";
+        }
+        assert(keys == "five=5 four=4 one=2 three=3 two=22 ");
+        for (auto [key, value] : map) {
+            value *= 2;
+        }
+        assert(map.At("five") == 10);
+
+        // Итератор пар поддерживает полный набор операций произвольного доступа
+        const auto first = map.cbegin();
+        const auto last = 2 + first;
+        assert(last == first + 2 && last - first == 2 && (*last).first == "one");
+        assert(first < last && first <= last && last > first && last >= first && first <= first && !(first > first));
+
+        map.BuildSearchIndex();
+        assert(map.Find("three").GetKey() == "three" && map.Find("zero") == map.end());
+        assert(map.Erase("three") == 1 && !map.HasSearchIndex() && map.GetSize() == 4);
+        assert(map.Values() == (SimpleVector<int>{10, 8, 4, 44}));
+        FlatMap<std::string, int> copy = map;
+        assert(copy == map);
+        copy.Clear();
+        assert(copy.IsEmpty() && copy != map);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты SoAVector
+
+void TestSoAVector() {
+    std::cout << "Test SoA vector" << std::endl;
+    {
+        SoAVector<int, double, std::string> v;
+        assert(v.IsEmpty() && v.begin() == v.end());
+        v.PushBack(1, 1.5, "one");
+        const std::string two = "two";
+        v.PushBack(2, 2.5, two);
+        v.PushBack(std::make_tuple(3, 3.5, std::string("three")));
+        assert(v.GetSize() == 3 && v.GetCapacity() >= 3);
+
+        auto [id, price, name] = v[1];
+        assert(id == 2 && price == 2.5 && name == "two");
+        price = 20.0;
+        assert(std::get<1>(v.At(1)) == 20.0);
+        try {
+            v.At(3);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+
+        // Столбцы лежат в памяти подряд и подходят для алгоритмов над векторами
+        assert(v.Column<0>().GetSize() == 3 && v.Column<0>()[2] == 3);
+        assert(&v.Column<1>()[1] == v.Column<1>().Data() + 1);
+        assert(Sum(std::as_const(v).Column<0>()) == 6);
+        ColumnRange<double> prices = v.Column<1>();
+        Fill(prices, 0.5);
+        assert(MaxValue(prices) == 0.5);
+
+        int ids = 0;
+        for (auto [row_id, row_price, row_name] : std::as_const(v)) {
+            ids += row_id;
+            assert(row_price == 0.5 && !row_name.empty());
+        }
+        assert(ids == 6);
+        for (auto row : v) {
+            std::get<2>(row) += "!";
+        }
+        assert(std::get<2>(v[0]) == "one!");
+        assert(std::find_if(v.cbegin(), v.cend(), [](const auto& row) { return std::get<0>(row) == 3; }) - v.cbegin() == 2);
+
+        auto it = v.Erase(v.begin() + 1);
+        assert(std::get<0>(*it) == 3 && v.GetSize() == 2 && v.Column<2>()[1] == "three!");
+        v.PopBack();
+        assert(v.GetSize() == 1);
+        v.Resize(4);
+        assert(v.GetSize() == 4 && std::get<2>(v[3]).empty() && v.Column<1>().GetSize() == 4);
+        v.Erase(v.begin(), v.end());
+        assert(v.IsEmpty());
+
+        SoAVector<int, double, std::string> a(2);
+        SoAVector<int, double, std::string> b = a;
+        assert(a == b);
+        std::get<0>(b[0]) = 1;
+        assert(a != b);
+        a.swap(b);
+        assert(std::get<0>(a[0]) == 1 && std::get<0>(b[0]) == 0);
+        a.Clear();
+        assert(a.IsEmpty());
+    }
+    // Исключение при добавлении поля не оставляет столбцы разной длины
+    {
+        struct Throwing {
+            Throwing() = default;
+            Throwing(Throwing&&) = default;
+            Throwing& operator=(Throwing&&) = default;
+            Throwing(const Throwing&) {
+                throw std::runtime_error("copy");
+            }
+            Throwing& operator=(const Throwing&) = default;
+        };
+        SoAVector<std::string, Throwing> v;
+        v.PushBack(std::string("ok"), Throwing());
+        const Throwing item;
+        try {
+            v.PushBack(std::string("fail"), item);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.GetSize() == 1 && v.Column<0>().GetSize() == 1 && v.Column<1>().GetSize() == 1);
+    }
+    // Поля новой строки могут ссылаться на строку самого вектора, даже если столбцы перевыделяются
+    {
+        SoAVector<std::string, int> v;
+        v.PushBack(std::string("a long name that does not fit into the small string buffer"), 1);
+        assert(v.GetSize() == v.GetCapacity());
+        for (int i = 0; i < 6; ++i) {
+            auto [name, id] = v[0];
+            v.PushBack(name, id);
+        }
+        assert(v.GetSize() == 7);
+        for (auto [name, id] : std::as_const(v)) {
+            assert(name == std::get<0>(v[0]) && id == 1);
+        }
+    }
+    // Поле может ссылаться и на другой столбец: столбцы перевыделяются по очереди
+    {
+        SoAVector<long, long> v;
+        v.PushBack(7L, 8L);
+        for (int i = 0; i < 6; ++i) {
+            auto [first, second] = v[i];
+            v.PushBack(second, first);
+        }
+        assert(v.GetSize() == 7);
+        for (size_t i = 0; i < v.GetSize(); ++i) {
+            assert(v[i] == (i % 2 == 0 ? std::make_tuple(7L, 8L) : std::make_tuple(8L, 7L)));
+        }
+    }
+    // Строки переставляются алгоритмами std: присваивание и swap работают со значениями полей во всех столбцах
+    {
+        SoAVector<int, std::string> v;
+        const int ids[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8, 9, 7, 9, 3, 2, 3, 8, 4};
+        for (int id : ids) {
+            v.PushBack(id, "row " + std::to_string(id) + " with a name longer than the small buffer");
+        }
+        std::sort(v.begin(), v.end(), [](const auto& lhs, const auto& rhs) {
+            return std::get<0>(lhs) < std::get<0>(rhs);
+        });
+        assert(std::is_sorted(v.Column<0>().begin(), v.Column<0>().end()));
+        for (auto [id, name] : std::as_const(v)) {
+            assert(name == "row " + std::to_string(id) + " with a name longer than the small buffer");
+        }
+        std::reverse(v.begin(), v.end());
+        assert(std::get<0>(v[0]) == 9 && std::get<0>(v[v.GetSize() - 1]) == 1);
+        assert(std::is_sorted(v.begin(), v.end(), [](const auto& lhs, const auto& rhs) { return lhs > rhs; }));
+
+        std::sort(v.begin(), v.end());
+        assert(std::is_sorted(v.cbegin(), v.cend()) && std::get<0>(v[0]) == 1);
+        swap(v[0], v[1]);
+        assert(std::get<0>(v[0]) == 1 && std::get<0>(v[1]) == 1);
+        std::iter_swap(v.begin(), v.begin() + 19);
+        assert(std::get<0>(v[0]) == 9 && std::get<0>(v[19]) == 1);
+        v[2] = std::make_tuple(0, std::string("zero"));
+        assert(v[2] == std::make_tuple(0, std::string("zero")));
+        v[3] = v[2];
+        assert(std::get<1>(v[3]) == "zero" && std::get<1>(v[2]) == "zero");
+    }
+    // Вектор из одного поля принимает и значение, и кортеж
+    {
+        SoAVector<int> v;
+        v.PushBack(1);
+        std::tuple<int> row(2);
+        v.PushBack(row);
+        assert(v.GetSize() == 2 && v.Column<0>()[1] == 2);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты SegmentedSimpleVector
+
+void TestSegmentedSimpleVector() {
+    std::cout << "Test segmented simple vector" << std::endl;
+    {
+        SegmentedSimpleVector<std::string> v;
+        assert(v.IsEmpty() && v.GetCapacity() == 0 && v.begin() == v.end());
+        v.PushBack("first");
+        const std::string* first = &v[0];
+        auto first_it = v.begin();
+        // Рост не переносит элементы: указатели и итераторы остаются действительными
+        for (int i = 1; i < 100000; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        assert(&v[0] == first && *first_it == "first" && v.GetSize() == 100000);
+        assert(v[99999] == "99999" && v.At(16) == "16" && v.GetCapacity() >= 100000);
+        // Аргумент может ссылаться на элемент самого вектора
+        v.EmplaceBack(v[1]);
+        assert(v[100000] == "1");
+        try {
+            v.At(100001);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+
+        // Итераторы произвольного доступа со стандартными алгоритмами
+        SegmentedSimpleVector<int> numbers;
+        for (int i = 0; i < 1000; ++i) {
+            numbers.PushBack(999 - i);
+        }
+        std::sort(numbers.begin(), numbers.end());
+        assert(std::is_sorted(numbers.cbegin(), numbers.cend()) && numbers[0] == 0 && numbers[999] == 999);
+        assert(*std::lower_bound(numbers.begin(), numbers.end(), 500) == 500);
+        assert(numbers.end() - numbers.begin() == 1000 && numbers.begin()[17] == 17);
+        assert(std::accumulate(numbers.begin(), numbers.end(), 0) == 499500);
+        std::reverse(numbers.begin(), numbers.end());
+        assert(numbers[0] == 999 && *(numbers.end() - 1) == 0);
+    }
+    {
+        SegmentedSimpleVector<int> v{1, 2, 3, 4, 5};
+        auto it = v.Insert(v.begin() + 2, 42);
+        assert(*it == 42 && v.GetSize() == 6 && v[2] == 42 && v[5] == 5);
+        it = v.Erase(v.begin() + 2);
+        assert(*it == 3 && v == (SegmentedSimpleVector<int>{1, 2, 3, 4, 5}));
+        v.Erase(v.begin(), v.begin() + 2);
+        assert(v == (SegmentedSimpleVector<int>{3, 4, 5}));
+        assert(v.EraseIf([](int item) { return item % 2 == 1; }) == 2 && v.GetSize() == 1 && v[0] == 4);
+        v.PopBack();
+        assert(v.IsEmpty());
+
+        v.Resize(100);
+        assert(v.GetSize() == 100 && v[99] == 0);
+        v.Resize(10);
+        assert(v.GetSize() == 10 && v.GetCapacity() >= 100);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 16);
+
+        SegmentedSimpleVector<int> copy = v;
+        assert(copy == v && &copy[0] != &v[0]);
+        copy.PushBack(1);
+        assert(v < copy);
+        const int* data = &copy[0];
+        SegmentedSimpleVector<int> moved = std::move(copy);
+        assert(&moved[0] == data && copy.IsEmpty() && copy.GetCapacity() == 0);
+        v = moved;
+        assert(v == moved);
+        SegmentedSimpleVector<int> filled(40, 7);
+        filled.swap(v);
+        assert(v.GetSize() == 40 && v[39] == 7 && filled.GetSize() == 11);
+        v.Clear();
+        assert(v.IsEmpty() && v.GetCapacity() >= 40);
+    }
+    // Некопируемые элементы
+    {
+        SegmentedSimpleVector<X> v;
+        for (size_t i = 0; i < 50; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Insert(v.begin(), X(100));
+        v.Erase(v.begin() + 1);
+        assert(v[0].GetX() == 100 && v[1].GetX() == 1 && v[49].GetX() == 49);
+        SegmentedSimpleVector<X> moved(std::move(v));
+        assert(moved.GetSize() == 50 && v.IsEmpty());
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// -----------Тесты ConcurrentSimpleVector
+
+// Аллокатор, бросающий std::bad_alloc при выделении, если взведён флаг fail_next, и сбрасывающий его
+struct FailingOnceAllocator {
+    using value_type = int;
+    bool* fail_next;
+
+    int* allocate(size_t n) {
+        if (std::exchange(*fail_next, false)) {
+            throw std::bad_alloc();
+        }
+        return std::allocator<int>().allocate(n);
+    }
+
+    void deallocate(int* p, size_t n) noexcept {
+        std::allocator<int>().deallocate(p, n);
+    }
+};
+
+void TestConcurrentSimpleVector() {
+    std::cout << "Test concurrent simple vector" << std::endl;
+    {
+        ConcurrentSimpleVector<std::string> v;
+        assert(v.IsEmpty() && v.begin() == v.end());
+        assert(v.PushBack("alpha") == 0);
+        const std::string beta = "beta";
+        assert(v.PushBack(beta) == 1);
+        assert(v.EmplaceBack(3, 'c') == 2);
+        assert(v.GetSize() == 3 && v[2] == "ccc" && v.At(1) == "beta");
+        try {
+            v.At(3);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+
+        // Рост не переносит элементы: ссылки остаются действительными
+        const std::string* first = &v[0];
+        for (int i = 3; i < 1000; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        assert(&v[0] == first && v.GetSize() == 1000);
+        size_t count = 0;
+        for (const std::string& item : std::as_const(v)) {
+            assert(count < 3 || item == std::to_string(count));
+            ++count;
+        }
+        assert(count == 1000);
+        for (std::string& item : v) {
+            item += "!";
+        }
+        const SimpleVector<std::string> copy = v.ToSimpleVector();
+        assert(copy.GetSize() == 1000 && copy[999] == "999!");
+
+        v.Clear();
+        assert(v.IsEmpty());
+        assert(v.PushBack("again") == 0 && v[0] == "again");
+    }
+    // Несколько писателей и читатель, проверяющий опубликованный префикс во время записи
+    {
+        const size_t writers = 4;
+        const size_t per_writer = 50000;
+        ConcurrentSimpleVector<size_t> v;
+        std::atomic<bool> done{false};
+        std::thread reader([&v, &done] {
+            size_t seen = 0;
+            while (!done.load()) {
+                const size_t size = v.GetSize();
+                assert(size >= seen);
+                for (auto it = v.cbegin(), last = decltype(it)(&v, size); it != last; ++it) {
+                    assert(*it < writers * per_writer);
+                }
+                seen = size;
+            }
+        });
+        SimpleVector<std::thread> threads;
+        for (size_t t = 0; t < writers; ++t) {
+            threads.PushBack(std::thread([&v, t] {
+                for (size_t i = 0; i < per_writer; ++i) {
+                    const size_t index = v.PushBack(t * per_writer + i);
+                    assert(v.GetSize() <= writers * per_writer && index < writers * per_writer);
+                }
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        done.store(true);
+        reader.join();
+        assert(v.GetSize() == writers * per_writer);
+        SimpleVector<bool> found(writers * per_writer, false);
+        for (size_t item : std::as_const(v)) {
+            assert(!found[item]);
+            found[item] = true;
+        }
+    }
+    // Reserve можно вызывать одновременно с добавлением: потоки гоняются за выделение одних сегментов
+    {
+        ConcurrentSimpleVector<int> v;
+        SimpleVector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.PushBack(std::thread([&v] {
+                v.Reserve(10000);
+                for (int i = 0; i < 10000; ++i) {
+                    v.PushBack(i);
+                }
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        long sum = 0;
+        for (int item : std::as_const(v)) {
+            sum += item;
+        }
+        assert(v.GetSize() == 40000 && sum == 4L * 49995000);
+    }
+    // Неудачное выделение сегмента не занимает индекс: следующие добавления снова публикуются
+    {
+        bool fail_next = false;
+        ConcurrentSimpleVector<int, FailingOnceAllocator> v(FailingOnceAllocator{&fail_next});
+        for (int i = 0; i < 32; ++i) {
+            v.PushBack(i);
+        }
+        fail_next = true;
+        try {
+            v.PushBack(32);
+            assert(false);
+        }
+        catch (const std::bad_alloc&) {
+        }
+        assert(v.GetSize() == 32);
+        assert(v.PushBack(32) == 32 && v.GetSize() == 33 && v[32] == 32);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestGrowthPolicies() {
+    std::cout << "Test growth policies" << std::endl;
+    // По умолчанию ёмкость удваивается
+    {
+        SimpleVector<int> v;
+        size_t expected = 0;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+            if (v.GetSize() > expected) {
+                expected = expected == 0 ? 1 : expected * 2;
+            }
+            assert(v.GetCapacity() == expected);
+        }
+    }
+    // Рост в 1.5 раза
+    {
+        SimpleVector<int, DefaultAllocator<int>, OneAndHalfGrowth> v;
+        size_t expected = 0;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+            if (v.GetSize() > expected) {
+                expected = std::max(expected + 1, expected + expected / 2);
+            }
+            assert(v.GetCapacity() == expected);
+        }
+        v.Resize(1000);
+        assert(v.GetCapacity() == 1000);
+        v.Resize(1001);
+        assert(v.GetCapacity() == 1500);
+    }
+    // Округление до страниц: большие буферы занимают целое число страниц
+    {
+        SimpleVector<X, DefaultAllocator<X>, PageGrowth> v;
+        for (size_t i = 0; i < 10000; ++i) {
+            v.PushBack(X(i));
+            assert(v.GetCapacity() * sizeof(X) < 4096 || v.GetCapacity() * sizeof(X) % 4096 == 0);
+        }
+        assert(v[9999].GetX() == 9999);
+        assert(PageGrowth::NextCapacity(1000, 1001, 8) == 2048);
+        assert(HugePageGrowth::NextCapacity(0, 1000000, 3) == 1398101);
+    }
+    // Забирая запас аллокатора, вектор получает не меньше запрошенного
+    {
+        SimpleVector<int, DefaultAllocator<int>, UsableSizeGrowth<>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+            assert(v.GetCapacity() >= v.GetSize());
+        }
+        v.Insert(v.begin(), -1);
+        assert(v[0] == -1 && v[1000] == 999);
+        SimpleVector<int, DefaultAllocator<int>, UsableSizeGrowth<>> copy = v;
+        assert(copy == v);
+
+        SimpleVector<std::string, DefaultAllocator<std::string>, UsableSizeGrowth<>> strings;
+        for (int i = 0; i < 100; ++i) {
+            strings.Insert(strings.begin(), std::to_string(i));
+        }
+        assert(strings[0] == "99" && strings[99] == "0");
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestShrinkToFit() {
+    std::cout << "Test shrink to fit" << std::endl;
+    // Удалённые элементы разрушаются сразу, а не вместе с вектором
+    {
+        auto resource = std::make_shared<int>(42);
+        SimpleVector<std::shared_ptr<int>> v(10, resource);
+        assert(resource.use_count() == 11);
+        v.PopBack();
+        v.Erase(v.begin(), v.begin() + 3);
+        v.SwapErase(v.begin());
+        assert(resource.use_count() == 6);
+        v.Clear();
+        assert(resource.use_count() == 1);
+    }
+    {
+        SimpleVector<std::string> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(std::string(50, static_cast<char>('a' + i % 26)));
+        }
+        v.Resize(10);
+        assert(v.GetCapacity() == 1024);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 10 && v.GetSize() == 10);
+        assert(v[9] == std::string(50, 'j'));
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 0 && v.begin() == nullptr);
+        v.PushBack("again");
+        assert(v[0] == "again");
+
+        SimpleVector<int> ints = GenerateVector(100);
+        ints.Reserve(100000);
+        ints.ShrinkToFit();
+        assert(ints.GetCapacity() == 100 && ints == GenerateVector(100));
+    }
+    {
+        SmallSimpleVector<std::string, 4> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        v.Resize(50);
+        v.ShrinkToFit();
+        assert(!v.IsInline() && v.GetCapacity() == 50 && v[49] == "49");
+        v.Resize(3);
+        v.ShrinkToFit();
+        assert(v.IsInline() && v.GetCapacity() == 4 && v[2] == "2");
+    }
+    // Автоматическое сжатие с гистерезисом
+    {
+        using Policy = HysteresisShrink<>;
+        assert(Policy::ShrinkCapacity(4096, 1025, 4) == 4096);
+        assert(Policy::ShrinkCapacity(4096, 1000, 4) == 2000);
+        assert(Policy::ShrinkCapacity(4096, 0, 4) == 1024);
+        assert(Policy::ShrinkCapacity(1024, 0, 4) == 1024);
+
+        SimpleVector<int, DefaultAllocator<int>, Policy> v;
+        for (int i = 0; i < 100000; ++i) {
+            v.PushBack(i);
+        }
+        const size_t peak = v.GetCapacity();
+        while (v.GetSize() > 1000) {
+            v.PopBack();
+        }
+        assert(v.GetCapacity() < peak / 4 && v.GetCapacity() >= 2 * v.GetSize());
+        assert(v[999] == 999);
+
+        // Чередование вставок и удалений у границы не перевыделяет буфер
+        const size_t capacity = v.GetCapacity();
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+            v.PopBack();
+            v.Erase(v.end() - 1);
+            v.Insert(v.begin(), i);
+        }
+        assert(v.GetCapacity() == capacity && v[0] == 999);
+
+        SimpleVector<std::string, DefaultAllocator<std::string>, Policy> strings(10000, "text");
+        auto it = strings.Erase(strings.begin() + 5, strings.end() - 5);
+        assert(strings.GetCapacity() < 10000 && it == strings.begin() + 5 && *it == "text");
+        strings.EraseIf([](const std::string& item) { return item == "text"; });
+        assert(strings.IsEmpty() && strings.GetCapacity() * sizeof(std::string) <= 4096);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestRangeInsert() {
+    std::cout << "Test range insert" << std::endl;
+    // Вставка нескольких элементов перевыделяет память один раз
+    {
+        SimpleVector<int> v{1, 2, 3, 4};
+        auto it = v.Insert(v.begin() + 2, {10, 11, 12});
+        assert(it == v.begin() + 2);
+        assert((v == SimpleVector<int>{1, 2, 10, 11, 12, 3, 4}));
+        assert(v.GetCapacity() == 8);
+
+        it = v.Insert(v.begin(), 100, 7);
+        assert(*it == 7 && v.GetSize() == 107 && v.GetCapacity() == 107);
+        assert(v[99] == 7 && v[100] == 1 && v[106] == 4);
+
+        it = v.Insert(v.end(), 0, 5);
+        assert(it == v.end() && v.GetSize() == 107);
+    }
+    // Вставка элементов самого вектора
+    {
+        SimpleVector<int> v{1, 2, 3};
+        v.Insert(v.begin() + 1, 2, v[2]);
+        assert((v == SimpleVector<int>{1, 3, 3, 2, 3}));
+        v.Insert(v.begin() + 1, v.begin(), v.begin() + 2);
+        assert((v == SimpleVector<int>{1, 1, 3, 3, 3, 2, 3}));
+        v.Append(v);
+        assert(v.GetSize() == 14 && v[7] == 1 && v[13] == 3);
+    }
+    // Диапазон input-итераторов заранее неизвестной длины
+    {
+        std::istringstream input("4 5 6");
+        SimpleVector<int> v{1, 2, 3};
+        v.Insert(v.begin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert((v == SimpleVector<int>{1, 4, 5, 6, 2, 3}));
+    }
+    // Нетривиально перемещаемые элементы: вставка на месте и с перевыделением
+    Counted::alive = 0;
+    {
+        SimpleVector<Counted> source;
+        for (int i = 0; i < 5; ++i) {
+            source.PushBack(Counted(i + 10));
+        }
+        SimpleVector<Counted> v(Reserve(20));
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(Counted(i));
+        }
+        v.Insert(v.begin() + 1, source.begin(), source.end());
+        assert(v.GetSize() == 9 && v.GetCapacity() == 20);
+        assert(v[0].GetValue() == 0 && v[1].GetValue() == 10 && v[5].GetValue() == 14 && v[8].GetValue() == 3);
+
+        v.Insert(v.begin() + 2, 15, Counted(7));
+        assert(v.GetSize() == 24 && v.GetCapacity() == 40);
+        assert(v[1].GetValue() == 10 && v[2].GetValue() == 7 && v[16].GetValue() == 7 && v[17].GetValue() == 11);
+        assert(Counted::alive == 29);
+
+        // Временный контейнер дописывается перемещением
+        Counted::copies = 0;
+        v.Append(std::move(source));
+        assert(Counted::copies == 0);
+        assert(v.GetSize() == 29 && v[28].GetValue() == 14);
+        v.Append({Counted(1), Counted(2)});
+        assert(v[30].GetValue() == 2);
+    }
+    assert(Counted::alive == 0);
+    std::cout << "Done!" << std::endl;
+}
+
+void TestEmplace() {
+    std::cout << "Test emplace" << std::endl;
+    Counted::alive = 0;
+    {
+        // Элемент создаётся прямо в памяти вектора, без временного объекта
+        SimpleVector<Counted> v(Reserve(4));
+        Counted::copies = 0;
+        Counted::moves = 0;
+        Counted& first = v.EmplaceBack(1);
+        assert(&first == &v[0] && first.GetValue() == 1);
+        v.EmplaceBack(3);
+        auto it = v.Emplace(v.begin() + 1, 2);
+        assert(it->GetValue() == 2);
+        assert(Counted::copies == 0);
+        v.EmplaceBack(4);
+        assert(Counted::moves <= 3);
+
+        // При росте новый элемент создаётся в новом буфере, старые перемещаются
+        Counted::moves = 0;
+        v.EmplaceBack(5);
+        assert(Counted::copies == 0 && Counted::moves == 4);
+        assert(v.GetSize() == 5 && v[4].GetValue() == 5);
+
+        // Аргумент - элемент самого вектора, который переносится при росте
+        while (v.GetSize() < v.GetCapacity()) {
+            v.EmplaceBack(0);
+        }
+        v.EmplaceBack(v[0]);
+        assert(v[v.GetSize() - 1].GetValue() == 1);
+    }
+    assert(Counted::alive == 0);
+    {
+        SimpleVector<std::pair<int, std::string>> v;
+        v.EmplaceBack(1, "one");
+        v.EmplaceBack(3, std::string(5, 'x'));
+        v.Emplace(v.begin() + 1, 2, "two");
+        assert(v[1].second == "two" && v[2].second == "xxxxx");
+        for (int i = 0; i < 10; ++i) {
+            v.Emplace(v.begin(), v[v.GetSize() - 1]);
+        }
+        assert(v[0].second == "xxxxx" && v[9].second == "xxxxx" && v.GetSize() == 13);
+    }
+    {
+        SimpleVector<int> v{1, 2};
+        v.EmplaceBack(v[0]);
+        v.Emplace(v.begin(), v[2]);
+        v.EmplaceBack();
+        assert((v == SimpleVector<int>{1, 1, 2, 1, 0}));
+        SmallSimpleVector<std::string, 2> small;
+        small.EmplaceBack(3, 'a');
+        small.EmplaceBack(small[0]);
+        small.Emplace(small.begin(), small[1]);
+        assert(small.GetSize() == 3 && small[0] == "aaa" && small[2] == "aaa");
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestBulkErase() {
+    std::cout << "Test bulk erase" << std::endl;
+    {
+        SimpleVector<int> v(10);
+        std::iota(v.begin(), v.end(), 0);
+        auto it = v.Erase(v.begin() + 2, v.begin() + 5);
+        assert(*it == 5);
+        assert((v == SimpleVector<int>{0, 1, 5, 6, 7, 8, 9}));
+        it = v.Erase(v.begin() + 5, v.end());
+        assert(it == v.end() && v.GetSize() == 5);
+        it = v.Erase(v.begin() + 1, v.begin() + 1);
+        assert(*it == 1 && v.GetSize() == 5);
+
+        assert(v.EraseIf([](int value) { return value % 2 == 1; }) == 3);
+        assert((v == SimpleVector<int>{0, 6}));
+
+        it = v.SwapErase(v.begin());
+        assert(*it == 6 && v.GetSize() == 1);
+        it = v.SwapErase(v.begin());
+        assert(it == v.end() && v.IsEmpty());
+    }
+    // Удалённые элементы разрушаются, оставшиеся сохраняют порядок
+    Counted::alive = 0;
+    {
+        SimpleVector<Counted> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Erase(v.begin() + 10, v.begin() + 20);
+        assert(Counted::alive == 90 && v[10].GetValue() == 20);
+        assert(v.EraseIf([](const Counted& item) { return item.GetValue() % 3 != 0; }) == 59);
+        assert(Counted::alive == 31 && v.GetSize() == 31);
+        for (size_t i = 1; i < v.GetSize(); ++i) {
+            assert(v[i - 1].GetValue() < v[i].GetValue() && v[i].GetValue() % 3 == 0);
+        }
+        v.SwapErase(v.begin());
+        assert(Counted::alive == 30 && v[0].GetValue() == 99);
+    }
+    assert(Counted::alive == 0);
+    {
+        SimpleVector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        v.Erase(v.begin(), v.begin() + 3);
+        v.SwapErase(v.begin());
+        assert(*v[0] == 9 && v.GetSize() == 6);
+        v.EraseIf([](const std::unique_ptr<int>& ptr) { return *ptr > 5; });
+        assert(v.GetSize() == 2 && *v[0] == 4 && *v[1] == 5);
+
+        SmallSimpleVector<std::string, 4> small;
+        for (int i = 0; i < 8; ++i) {
+            small.PushBack(std::to_string(i));
+        }
+        small.Erase(small.begin() + 1, small.begin() + 3);
+        assert(small.EraseIf([](const std::string& value) { return value == "5"; }) == 1);
+        small.SwapErase(small.begin());
+        assert(small.GetSize() == 4 && small[0] == "7" && small[3] == "6");
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+// Сверяет векторные ядра для типа Type с стандартными алгоритмами на массивах разной длины
+template <typename Type>
+void CheckSimdKernels(std::mt19937& generator) {
+    std::uniform_int_distribution<int> distribution(0, 100);
+    for (size_t size : {0, 1, 3, 15, 16, 17, 63, 64, 65, 100, 257, 1000}) {
+        SimpleVector<Type> v(size);
+        for (Type& item : v) {
+            item = static_cast<Type>(distribution(generator));
+        }
+        const Type needle = static_cast<Type>(42);
+        assert(Find(v, needle) == std::find(v.begin(), v.end(), needle));
+        assert(Count(v, needle) == static_cast<size_t>(std::count(v.begin(), v.end(), needle)));
+        assert(Sum(v) == std::accumulate(v.begin(), v.end(), SimdSumType<Type>{}));
+        if (!v.IsEmpty()) {
+            assert(MinValue(v) == *std::min_element(v.begin(), v.end()));
+            assert(MaxValue(v) == *std::max_element(v.begin(), v.end()));
+        }
+
+        SimpleVector<Type> copy = v;
+        assert(copy == v && !(copy < v) && !(v < copy));
+        for (size_t i = 0; i < size; i += 7) {
+            copy[i] = static_cast<Type>(copy[i] + 1);
+            assert(copy != v && v < copy && !(copy < v));
+            copy[i] = v[i];
+        }
+        if (size > 0) {
+            SimpleVector<Type> prefix(size - 1);
+            std::copy(v.begin(), v.end() - 1, prefix.begin());
+            assert(prefix < v && prefix != v);
+        }
+
+        Fill(copy, needle);
+        assert(Count(copy, needle) == size);
+        SimpleVector<Type> filled(size, needle);
+        assert(filled == copy);
+    }
+}
+
+void TestSimdKernels() {
+    std::cout << "Test SIMD kernels" << std::endl;
+    const SimdLevel detected = DetectSimdLevel();
+    std::mt19937 generator(2024);
+    for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse42, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+        SetSimdLevel(level);
+        assert(GetSimdLevel() <= detected);
+        CheckSimdKernels<int32_t>(generator);
+        CheckSimdKernels<uint8_t>(generator);
+        CheckSimdKernels<float>(generator);
+        CheckSimdKernels<double>(generator);
+
+        // Сумма байтов не переполняется, NaN пропускается при лексикографическом сравнении
+        SimpleVector<uint8_t> bytes(1000, 255);
+        assert(Sum(bytes) == 255000u);
+        SimpleVector<double> lhs{1.0, std::numeric_limits<double>::quiet_NaN(), 2.0};
+        SimpleVector<double> rhs{1.0, std::numeric_limits<double>::quiet_NaN(), 3.0};
+        assert(lhs < rhs && lhs != lhs);
+    }
+    SetSimdLevel(detected);
+    // Типы без векторных ядер работают через стандартные алгоритмы
+    SimpleVector<std::string> words{"b", "a", "c", "a"};
+    assert(Count(words, "a") == 2 && *Find(words, "c") == "c");
+    assert(MinValue(words) == "a" && Sum(words) == "bac" "a");
+    SmallSimpleVector<int, 4> small{5, 3, 9};
+    assert(MaxValue(small) == 9 && Sum(small) == 17);
+    std::cout << "Done!" << std::endl;
+}
+
+void TestBitVector() {
+    std::cout << "Test bit vector" << std::endl;
+    // Доступ к битам, заместитель ссылки и границы слов
+    {
+        BitVector bits{true, false, true};
+        assert(bits.GetSize() == 3 && bits.Count() == 2 && bits[0] && !bits[1]);
+        bits[1] = bits[0];
+        bits[0].Flip();
+        assert(!bits[0] && bits[1] && ~bits[0]);
+        try {
+            bits.At(3);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+
+        BitVector pushed(Reserve(100));
+        assert(pushed.IsEmpty() && pushed.GetCapacity() >= 100);
+        for (size_t i = 0; i < 130; ++i) {
+            pushed.PushBack(i % 3 == 0);
+        }
+        assert(pushed.GetWordCount() == 3 && pushed.Count() == 44);
+        assert(std::count(pushed.begin(), pushed.end(), true) == 44);
+        while (pushed.GetSize() > 64) {
+            pushed.PopBack();
+        }
+        assert(pushed.GetWordCount() == 1 && pushed.Count() == 22);
+
+        BitVector ones(70, true);
+        assert(ones.All() && ones.Count() == 70 && ones.Data()[1] == 0x3F);
+        ones.Resize(65);
+        assert(ones.Count() == 65 && ones.Data()[1] == 1);
+        ones.Resize(200, true);
+        assert(ones.All() && ones.Count() == 200);
+        ones.FlipAll();
+        assert(ones.None() && ones.GetWordCount() == 4);
+    }
+    // Добавление целых слов и их частей на выровненной и невыровненной границе сверяется с PushBack
+    {
+        std::mt19937_64 generator(11);
+        for (size_t start : {0, 5, 63, 64}) {
+            BitVector bits(start, true);
+            BitVector model(start, true);
+            for (size_t count : {64, 10, 0, 54, 64, 1, 63, 64, 37}) {
+                const uint64_t word = generator();
+                bits.AppendWord(word, count);
+                for (size_t i = 0; i < count; ++i) {
+                    model.PushBack((word >> i) & 1);
+                }
+                assert(bits == model && bits.Count() == model.Count());
+            }
+            assert(bits.GetSize() == start + 357 && bits.GetWordCount() == (start + 357 + 63) / 64);
+        }
+        BitVector aligned;
+        aligned.AppendWord(~uint64_t{0});
+        aligned.AppendWord(0x5, 3);
+        assert(aligned.GetSize() == 67 && aligned.Count() == 66 && aligned.Data()[1] == 0x5);
+    }
+    // Диапазонные операции, поиск, rank и select сверяются с побитовой моделью
+    {
+        std::mt19937 generator(7);
+        for (size_t size : {0, 1, 63, 64, 65, 200, 1000}) {
+            BitVector bits(size);
+            SimpleVector<bool> model(size);
+            std::uniform_int_distribution<size_t> position(0, size);
+            for (int step = 0; step < 50; ++step) {
+                size_t first = position(generator);
+                size_t last = position(generator);
+                if (first > last) {
+                    std::swap(first, last);
+                }
+                switch (step % 3) {
+                    case 0:
+                        bits.SetRange(first, last);
+                        std::fill(model.begin() + first, model.begin() + last, true);
+                        break;
+                    case 1:
+                        bits.ResetRange(first, last);
+                        std::fill(model.begin() + first, model.begin() + last, false);
+                        break;
+                    default:
+                        bits.FlipRange(first, last);
+                        for (size_t i = first; i < last; ++i) {
+                            model[i] = !model[i];
+                        }
+                }
+            }
+            assert(std::equal(bits.begin(), bits.end(), model.begin(), model.end()));
+            const size_t count = static_cast<size_t>(std::count(model.begin(), model.end(), true));
+            assert(bits.Count() == count && bits.Any() == (count > 0) && bits.All() == (count == size));
+
+            SimpleVector<size_t> positions;
+            bits.ForEachSetBit([&](size_t index) { positions.PushBack(index); });
+            assert(positions.GetSize() == count);
+            size_t next = bits.FindFirst();
+            for (size_t k = 0; k < count; ++k) {
+                assert(next == positions[k] && model[next]);
+                assert(bits.Select(k) == next && bits.Rank(next) == k);
+                next = bits.FindNext(next + 1);
+            }
+            assert(next == size && bits.Select(count) == size && bits.Rank(size) == count);
+
+            // Индекс суперблоков даёт те же ответы и сбрасывается при изменении битов
+            bits.BuildRankIndex();
+            assert(bits.HasRankIndex());
+            for (size_t k = 0; k < count; ++k) {
+                assert(bits.Select(k) == positions[k] && bits.Rank(positions[k]) == k);
+            }
+            for (size_t index = 0; index <= size; index += 7) {
+                assert(bits.Rank(index) == static_cast<size_t>(std::count(model.begin(), model.begin() + index, true)));
+            }
+            assert(bits.Select(count) == size && bits.Rank(size) == count);
+            if (size > 0) {
+                bits.Flip(size - 1);
+                assert(!bits.HasRankIndex());
+                assert(bits.Rank(size) == (model[size - 1] ? count - 1 : count + 1));
+            }
+            bits.BuildRankIndex();
+            bits.PushBack(false);
+            assert(!bits.HasRankIndex() && bits.Rank(size + 1) == bits.Count());
+        }
+    }
+    // Побитовые операции между векторами на каждом наборе инструкций
+    const SimdLevel detected = DetectSimdLevel();
+    for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse42, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+        SetSimdLevel(level);
+        for (size_t size : {0, 5, 64, 129, 517, 4099}) {
+            BitVector lhs(size);
+            BitVector rhs(size);
+            for (size_t i = 0; i < size; ++i) {
+                lhs[i] = i % 3 == 0;
+                rhs[i] = i % 5 == 0;
+            }
+            const BitVector both = lhs & rhs;
+            const BitVector either = lhs | rhs;
+            const BitVector differ = lhs ^ rhs;
+            for (size_t i = 0; i < size; ++i) {
+                assert(both[i] == (i % 15 == 0));
+                assert(either[i] == (i % 3 == 0 || i % 5 == 0));
+                assert(differ[i] == (lhs[i] != rhs[i]));
+            }
+            assert(both.Count() + either.Count() == lhs.Count() + rhs.Count());
+            BitVector copy = lhs;
+            copy ^= lhs;
+            assert(copy.None() && copy == BitVector(size) && (size == 0 || copy != lhs));
+        }
+    }
+    SetSimdLevel(detected);
+    std::cout << "Done!" << std::endl;
+}
+
+// Сверяет доступ по индексу и распаковку сжатого вектора с исходными значениями
+void CheckCompressedIntVector(const SimpleVector<uint64_t>& values) {
+    const CompressedIntVector compressed(values.begin(), values.end());
+    assert(compressed.GetSize() == values.GetSize());
+    assert(compressed.GetBlockCount() == values.GetSize() / CompressedIntVector::kBlockSize);
+    for (size_t i = 0; i < values.GetSize(); ++i) {
+        assert(compressed[i] == values[i]);
+    }
+    assert(compressed.Decode() == values);
+}
+
+void TestCompressedIntVector() {
+    std::cout << "Test compressed int vector" << std::endl;
+    using Encoding = CompressedIntVector::Encoding;
+    const SimdLevel detected = DetectSimdLevel();
+    std::mt19937_64 generator(99);
+    for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse42, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+        SetSimdLevel(level);
+        for (size_t size : {0, 1, 127, 128, 129, 1000}) {
+            SimpleVector<uint64_t> sorted(size);
+            SimpleVector<uint64_t> counters(size);
+            SimpleVector<uint64_t> random(size);
+            SimpleVector<uint64_t> descending(size);
+            uint64_t id = 1000000;
+            for (size_t i = 0; i < size; ++i) {
+                id += 1 + generator() % 20;
+                sorted[i] = id;
+                counters[i] = generator() % 1000;
+                random[i] = generator();
+                descending[i] = ~uint64_t{0} - i * 3;
+            }
+            CheckCompressedIntVector(sorted);
+            CheckCompressedIntVector(counters);
+            CheckCompressedIntVector(random);
+            CheckCompressedIntVector(descending);
+            CheckCompressedIntVector(SimpleVector<uint64_t>(size, 42));
+        }
+    }
+    SetSimdLevel(detected);
+    // Способ сжатия и ширина выбираются по блоку, сжатые данные меньше исходных
+    {
+        SimpleVector<uint64_t> values;
+        for (uint64_t i = 0; i < 128; ++i) {
+            values.PushBack(5000000000 + i * 7);
+        }
+        for (uint64_t i = 0; i < 128; ++i) {
+            values.PushBack(i % 16);
+        }
+        for (uint64_t i = 0; i < 128; ++i) {
+            values.PushBack(77);
+        }
+        CompressedIntVector compressed(values.begin(), values.end());
+        assert(compressed.GetBlockCount() == 3);
+        assert(compressed.GetBlockEncoding(0) == Encoding::kDelta && compressed.GetBlockBits(0) == 0);
+        assert(compressed.GetBlockEncoding(1) == Encoding::kFrameOfReference && compressed.GetBlockBits(1) == 4);
+        assert(compressed.GetBlockBits(2) == 0);
+        assert(compressed.GetCompressedBytes() * 10 < values.GetSize() * sizeof(uint64_t));
+        assert(compressed[5] == 5000000035 && compressed[128 + 17] == 1 && compressed.At(300) == 77);
+        try {
+            compressed.At(384);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+
+        compressed.PushBack(1);
+        assert(compressed.GetSize() == 385 && compressed[384] == 1 && compressed.GetBlockCount() == 3);
+        compressed.Clear();
+        assert(compressed.IsEmpty() && compressed.Decode().IsEmpty());
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestParallelAlgorithms() {
+    std::cout << "Test parallel algorithms" << std::endl;
+    WorkStealingPool pool(4);
+    assert(pool.GetConcurrency() == 4);
+    const ParallelOptions options{1000, &pool};
+    const size_t size = 100000;
+
+    SimpleVector<int64_t> v(size);
+    std::iota(v.begin(), v.end(), 0);
+    ParallelForEach(v, [](int64_t& item) { item *= 2; }, options);
+    assert(v[0] == 0 && v[size - 1] == static_cast<int64_t>(2 * (size - 1)));
+
+    SimpleVector<double> halves(size);
+    ParallelTransform(v, halves.begin(), [](int64_t item) { return item / 2.0; }, options);
+    assert(halves[12345] == 12345.0);
+
+    const int64_t total = ParallelReduce(v, int64_t{0}, std::plus<>(), options);
+    assert(total == std::accumulate(v.begin(), v.end(), int64_t{0}));
+    assert(ParallelReduce(v.begin(), v.begin(), int64_t{7}) == 7);
+    // Операция ассоциативна, но не коммутативна: порядок блоков сохраняется
+    SimpleVector<std::string> letters(2500, "a");
+    letters[0] = "x";
+    letters[2499] = "z";
+    const std::string joined = ParallelReduce(letters, std::string(), std::plus<>(), ParallelOptions{7, &pool});
+    assert(joined.size() == 2500 && joined.front() == 'x' && joined.back() == 'z');
+
+    SimpleVector<int64_t> scanned(size);
+    ParallelInclusiveScan(v.begin(), v.end(), scanned.begin(), std::plus<>(), options);
+    SimpleVector<int64_t> expected(size);
+    std::partial_sum(v.begin(), v.end(), expected.begin());
+    assert(scanned == expected);
+    for (size_t grain : {1, 3, 999, 1000, 1001, 100000}) {
+        SimpleVector<int64_t> copy = v;
+        ParallelInclusiveScan(copy, std::plus<>(), ParallelOptions{grain, &pool});
+        assert(copy == expected);
+    }
+
+    SimpleVector<int> random(size);
+    std::mt19937 generator(7);
+    for (int& item : random) {
+        item = static_cast<int>(generator() % 1000);
+    }
+    SimpleVector<int> sorted = random;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t grain : {0, 1, 777, 4096, 200000}) {
+        SimpleVector<int> copy = random;
+        ParallelSort(copy, std::less<>(), ParallelOptions{grain, &pool});
+        assert(copy == sorted);
+    }
+    ParallelSort(random, std::greater<>());
+    assert(random[0] == 999 && std::is_sorted(random.begin(), random.end(), std::greater<>()));
+
+    // Исключение из блока пробрасывается вызывающему
+    bool thrown = false;
+    try {
+        ParallelForEach(v, [](int64_t item) {
+            if (item == 5000) {
+                throw std::runtime_error("bad item");
+            }
+        }, options);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Вложенный параллелизм: задачи группы сами запускают параллельную сортировку
+    TaskGroup group(pool);
+    SimpleVector<SimpleVector<int>> parts(4, sorted);
+    for (auto& part : parts) {
+        group.Run([&part, &pool] {
+            std::reverse(part.begin(), part.end());
+            ParallelSort(part, std::less<>(), ParallelOptions{500, &pool});
+        });
+    }
+    group.Wait();
+    for (const auto& part : parts) {
+        assert(part == sorted);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestMappedSimpleVector() {
+    std::cout << "Test mapped simple vector" << std::endl;
+    const std::string path = (std::filesystem::temp_directory_path()
+                              / ("mapped_simple_vector_" + std::to_string(::getpid()) + ".bin")).string();
+    const size_t size = 100000;
+    {
+        MappedSimpleVector<uint64_t> v(path, MapMode::kCreate);
+        assert(v.IsOpen() && v.IsWritable() && v.IsEmpty() && v.GetCapacity() == 0);
+        for (size_t i = 0; i < size; ++i) {
+            v.PushBack(i * i);
+        }
+        assert(v.GetSize() == size && v.GetCapacity() >= size);
+        // Элемент самого вектора при переносе отображения
+        while (v.GetSize() != v.GetCapacity()) {
+            v.PushBack(0);
+        }
+        v.PushBack(v[1]);
+        assert(v[v.GetSize() - 1] == 1);
+        v.Resize(size);
+        v.Flush();
+    }
+    // Файл усечён до размера вектора и открывается без копирования
+    assert(std::filesystem::file_size(path) == size * sizeof(uint64_t));
+    {
+        const MappedSimpleVector<uint64_t> v(path, MapMode::kReadOnly);
+        assert(v.GetSize() == size && v.GetCapacity() == size);
+        assert(v[0] == 0 && v.At(999) == 999u * 999u && *(v.end() - 1) == (size - 1) * (size - 1));
+        bool thrown = false;
+        try {
+            v.At(size);
+        }
+        catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    {
+        MappedSimpleVector<uint64_t> v(path, MapMode::kReadOnly);
+        assert(!v.IsWritable() && v.Advise(MapAdvice::kSequential) && v.Advise(MapAdvice::kWillNeed));
+        bool thrown = false;
+        try {
+            v.PushBack(1);
+        }
+        catch (const std::logic_error&) {
+            thrown = true;
+        }
+        assert(thrown && v.GetSize() == size);
+        // Изменяемый At тоже требует записи, константный читает
+        thrown = false;
+        try {
+            v.At(0) = 1;
+        }
+        catch (const std::logic_error&) {
+            thrown = true;
+        }
+        assert(thrown && std::as_const(v).At(1) == 1);
+    }
+    {
+        MappedSimpleVector<uint64_t> v(path);
+        v.Resize(10);
+        v.Resize(20);
+        assert(v[9] == 81 && v[10] == 0 && v[19] == 0);
+        v.Advise(MapAdvice::kHugePage);
+        assert(Sum(v) == 285u && Count(v, 0) == 11u);
+
+        // Перемещение передаёт файл, moved-from вектор закрыт
+        MappedSimpleVector<uint64_t> moved(std::move(v));
+        assert(!v.IsOpen() && moved.GetSize() == 20);
+        v = std::move(moved);
+        assert(v.GetSize() == 20 && !moved.IsOpen());
+    }
+    assert(std::filesystem::file_size(path) == 20 * sizeof(uint64_t));
+    {
+        // Размер файла не кратен размеру элемента
+        bool thrown = false;
+        try {
+            MappedSimpleVector<std::array<char, 3>> v(path);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        thrown = false;
+        try {
+            MappedSimpleVector<int> v(path + ".missing", MapMode::kReadOnly);
+        }
+        catch (const std::system_error& error) {
+            thrown = error.code() == std::errc::no_such_file_or_directory;
+        }
+        assert(thrown);
+    }
+    std::filesystem::remove(path);
+    std::cout << "Done!" << std::endl;
+}
+
+struct Point {
+    int x = 0;
+    int y = 0;
+};
+
+// Точка расширения для типа, который нельзя записать побайтно
+struct Label {
+    std::string text;
+    std::unique_ptr<int> weight;
+};
+
+template <>
+struct Serializer<Label> {
+    static void Write(std::ostream& out, const Label& item) {
+        Serializer<std::string>::Write(out, item.text);
+        Serializer<int>::Write(out, item.weight ? *item.weight : -1);
+    }
+
+    static void Read(std::istream& in, Label& item) {
+        Serializer<std::string>::Read(in, item.text);
+        int weight = 0;
+        Serializer<int>::Read(in, weight);
+        item.weight = weight < 0 ? nullptr : std::make_unique<int>(weight);
+    }
+};
+
+void TestSerialization() {
+    std::cout << "Test serialization" << std::endl;
+    {
+        // Тривиально копируемые элементы: заголовок и один блок байтов
+        SimpleVector<Point> points;
+        for (int i = 0; i < 1000; ++i) {
+            points.PushBack({i, -i});
+        }
+        std::stringstream stream;
+        Serialize(stream, points);
+        assert(stream.str().size() == sizeof(SerializedHeader) + 1000 * sizeof(Point));
+        SimpleVector<Point> restored{{7, 7}};
+        Deserialize(stream, restored);
+        assert(restored.GetSize() == 1000 && restored[999].x == 999 && restored[999].y == -999);
+
+        // Чужой тип элемента и обрезанный поток
+        bool thrown = false;
+        try {
+            std::stringstream copy(stream.str());
+            SimpleVector<int32_t> wrong;
+            Deserialize(copy, wrong);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        thrown = false;
+        try {
+            std::stringstream truncated(stream.str().substr(0, 500));
+            Deserialize(truncated, restored);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        // При ошибке вектор не меняется
+        assert(thrown && restored.GetSize() == 1000 && restored[999].x == 999);
+
+        // Поддельное число элементов: память выделяется только под реально пришедшие данные
+        for (uint64_t forged_count : {uint64_t{1000000}, uint64_t{1} << 40}) {
+            std::string forged = stream.str();
+            std::memcpy(forged.data() + offsetof(SerializedHeader, count), &forged_count, sizeof(forged_count));
+            std::stringstream forged_stream(forged);
+            thrown = false;
+            try {
+                Deserialize(forged_stream, restored);
+            }
+            catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            assert(thrown && restored.GetSize() == 1000);
+        }
+
+        // Поддельная длина строки
+        std::stringstream string_stream;
+        Serialize(string_stream, SimpleVector<std::string>{"abc"});
+        std::string forged = string_stream.str();
+        const uint64_t forged_length = uint64_t{1} << 40;
+        std::memcpy(forged.data() + sizeof(SerializedHeader), &forged_length, sizeof(forged_length));
+        std::stringstream forged_strings(forged);
+        SimpleVector<std::string> strings{"kept"};
+        thrown = false;
+        try {
+            Deserialize(forged_strings, strings);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && strings == SimpleVector<std::string>{"kept"});
+    }
+    {
+        // Остальные типы - через Serializer, включая вложенные векторы
+        SimpleVector<SimpleVector<std::string>> words{{"a", "bb"}, {}, {std::string(1000, 'z')}};
+        std::stringstream stream;
+        Serialize(stream, words);
+        SimpleVector<SimpleVector<std::string>> restored;
+        Deserialize(stream, restored);
+        assert(restored == words);
+
+        SimpleVector<Label> labels;
+        labels.PushBack({"one", std::make_unique<int>(1)});
+        labels.PushBack({"none", nullptr});
+        std::stringstream label_stream;
+        Serialize(label_stream, labels);
+        SimpleVector<Label> restored_labels;
+        Deserialize(label_stream, restored_labels);
+        assert(restored_labels.GetSize() == 2 && restored_labels[0].text == "one" && *restored_labels[0].weight == 1);
+        assert(restored_labels[1].text == "none" && !restored_labels[1].weight);
+    }
+    {
+        // Файловый дескриптор: writev/readv
+        const std::string path = (std::filesystem::temp_directory_path()
+                                  / ("serialized_vector_" + std::to_string(::getpid()) + ".bin")).string();
+        SimpleVector<double> values(100000);
+        std::iota(values.begin(), values.end(), 0.5);
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        assert(fd >= 0);
+        WriteToFd(fd, values);
+        ::close(fd);
+        SimpleVector<double> restored;
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        ReadFromFd(fd, restored);
+        ::close(fd);
+        assert(restored == values);
+
+        // Обрезанный файл: исключение, а вектор не меняется
+        std::filesystem::resize_file(path, sizeof(SerializedHeader) + 1000 * sizeof(double));
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        bool thrown = false;
+        try {
+            ReadFromFd(fd, restored);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ::close(fd);
+        assert(thrown && restored == values);
+        fd = ::open(path.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+        WriteToFd(fd, values);
+        ::close(fd);
+
+        // Потоковое чтение частями: вместимость части не растёт
+        std::ifstream file(path, std::ios::binary);
+        ChunkedVectorReader<double> reader(file);
+        assert(reader.GetCount() == 100000);
+        SimpleVector<double> chunk;
+        size_t chunks = 0;
+        double sum = 0;
+        while (reader.ReadChunk(chunk, 4096)) {
+            ++chunks;
+            assert(chunk.GetCapacity() <= 4096);
+            sum += std::accumulate(chunk.begin(), chunk.end(), 0.0);
+        }
+        assert(chunks == 25 && chunk.IsEmpty() && reader.GetRemaining() == 0);
+        assert(sum == std::accumulate(values.begin(), values.end(), 0.0));
+        std::filesystem::remove(path);
+    }
+    {
+        SimpleVector<std::string> words{"x", "yy", "zzz"};
+        std::stringstream stream;
+        Serialize(stream, words);
+        ChunkedVectorReader<std::string> reader(stream);
+        SimpleVector<std::string> chunk;
+        assert(reader.ReadChunk(chunk, 2) && chunk == (SimpleVector<std::string>{"x", "yy"}));
+        assert(reader.ReadChunk(chunk, 2) && chunk == (SimpleVector<std::string>{"zzz"}));
+        assert(!reader.ReadChunk(chunk, 2));
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestInstrumentation() {
+    std::cout << "Test instrumentation" << std::endl;
+#if SIMPLE_VECTOR_INSTRUMENTATION
+    VectorStatsRegistry& registry = VectorStatsRegistry::Instance();
+    {
+        SimpleVector<int> v;
+        v.SetTag("test.ints");
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        v.Reserve(1000);
+        v.Resize(2000);
+        v.Insert(v.begin(), 3, 7);
+        const VectorStatsSnapshot stats = registry.Snapshot("test.ints");
+        assert(stats.Reallocations(GrowthCause::kPushBack) == 8);
+        assert(stats.Reallocations(GrowthCause::kReserve) == 1);
+        assert(stats.Reallocations(GrowthCause::kResize) == 1);
+        assert(stats.Reallocations(GrowthCause::kInsert) == 1);
+        assert(stats.allocations == 11 && stats.deallocations == 10);
+        assert(stats.peak_capacity == 4000 && stats.copies == 103 && stats.moves == 0);
+    }
+    VectorStatsSnapshot stats = registry.Snapshot("test.ints");
+    assert(stats.deallocations == 11 && stats.bytes_allocated == stats.bytes_freed);
+
+    {
+        SimpleVector<std::string> words;
+        words.SetTag("test.strings");
+        words.Reserve(4);
+        const std::string word = "x";
+        words.PushBack(word);
+        words.PushBack(std::string("y"));
+        words.EmplaceBack(3, 'z');
+        words.PushBack("w");
+        // Перевыделение переносит 4 строки перемещением
+        words.PushBack(word);
+        // Копия наследует тег
+        SimpleVector<std::string> copy = words;
+        copy.Erase(copy.begin());
+    }
+    stats = registry.Snapshot("test.strings");
+    assert(stats.Reallocations(GrowthCause::kReserve) == 1 && stats.Reallocations(GrowthCause::kPushBack) == 1);
+    assert(stats.allocations == 3 && stats.deallocations == 3 && stats.bytes_allocated == stats.bytes_freed);
+    assert(stats.copies == 7 && stats.moves == 10);
+
+    {
+        SimpleVector<int> v;
+        v.SetTag("test.shrink");
+        v.Resize(1000);
+        v.Resize(10);
+        v.ShrinkToFit();
+        v.Clear();
+        v.ShrinkToFit();
+    }
+    stats = registry.Snapshot("test.shrink");
+    assert(stats.Reallocations(GrowthCause::kShrink) == 2 && stats.Reallocations(GrowthCause::kResize) == 1);
+    assert(stats.allocations == 2 && stats.deallocations == 2 && stats.bytes_allocated == stats.bytes_freed);
+
+    std::ostringstream text;
+    DumpVectorStats(text, StatsFormat::kText);
+    assert(text.str().find("test.strings") != std::string::npos);
+    std::ostringstream json;
+    DumpVectorStats(json, StatsFormat::kJson);
+    assert(json.str().find("{\"tag\": \"test.ints\", \"allocations\": 11") != std::string::npos);
+    registry.Reset();
+    assert(registry.Snapshot("test.ints").allocations == 0);
+#else
+    // Выключенное инструментирование не добавляет данных в вектор
+    static_assert(std::is_empty_v<VectorProbe>);
+    static_assert(sizeof(SimpleVector<int>) == 2 * sizeof(size_t) + sizeof(ArrayPtr<int>));
+    SimpleVector<int> v;
+    v.SetTag("test.disabled");
+    v.PushBack(1);
+    assert(v.GetSize() == 1 && v[0] == 1);
+#endif
+    std::cout << "Done!" << std::endl;
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Пул потоков с перехватом задач (work stealing).
+// У каждого рабочего потока своя очередь: он берёт задачи с её конца (последние - самые «горячие»
+// в кеше), а простаивающие потоки забирают задачи с начала чужих очередей.
+// Поток, ожидающий группу задач (TaskGroup::Wait), тоже выполняет задачи пула, поэтому
+// вложенный параллелизм не блокируется, а пул с concurrency = 1 выполняет всё в вызывающем потоке
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // concurrency - общее число потоков, выполняющих задачи, включая ожидающий поток.
+    // Запускается concurrency - 1 рабочих потоков
+    explicit WorkStealingPool(size_t concurrency = DefaultConcurrency())
+        : queues_(std::max<size_t>(concurrency, 1))
+    {
+        const size_t workers = queues_.size() - 1;
+        threads_.reserve(workers);
+        for (size_t index = 0; index < workers; ++index) {
+            threads_.emplace_back([this, index] { WorkerLoop(index); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_up_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    // Возвращает число потоков, выполняющих задачи (с учётом ожидающего)
+    size_t GetConcurrency() const noexcept {
+        return queues_.size();
+    }
+
+    // Ставит задачу в очередь. Рабочий поток кладёт её в свою очередь,
+    // внешний поток - по кругу в очереди всех потоков.
+    // Задача не должна бросать исключений (см. TaskGroup)
+    void Push(Task task) {
+        size_t index = 0;
+        if (current_pool_ == this) {
+            index = current_index_;
+        } else {
+            index = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        }
+        // Счётчик увеличивается до публикации задачи, чтобы забравший её поток не увёл его ниже нуля
+        queued_.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> guard(queues_[index].mutex);
+            queues_[index].tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleep_mutex_);
+        }
+        wake_up_.notify_one();
+    }
+
+    // Выполняет одну задачу из очередей пула, если она есть.
+    // Возвращает false, если очереди пусты
+    bool RunPendingTask() {
+        const size_t own = current_pool_ == this ? current_index_ : queues_.size() - 1;
+        Task task;
+        if (!TryPop(own, task) && !TrySteal(own, task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    // Число потоков по умолчанию - число аппаратных потоков процессора
+    static size_t DefaultConcurrency() noexcept {
+        return std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+        while (true) {
+            if (RunPendingTask()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_up_.wait(lock, [this] {
+                return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    // Берёт последнюю задачу своей очереди
+    bool TryPop(size_t index, Task& task) {
+        std::lock_guard<std::mutex> guard(queues_[index].mutex);
+        if (queues_[index].tasks.empty()) {
+            return false;
+        }
+        task = std::move(queues_[index].tasks.back());
+        queues_[index].tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Забирает первую задачу из чужой очереди, обходя очереди начиная с соседней
+    bool TrySteal(size_t own, Task& task) {
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            Queue& victim = queues_[(own + offset) % queues_.size()];
+            std::lock_guard<std::mutex> guard(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Последняя очередь принадлежит внешним потокам, остальные - рабочим
+    std::vector<Queue> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_up_;
+    bool stopping_ = false;
+
+    static inline thread_local WorkStealingPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_index_ = 0;
+};
+
+// Возвращает общий пул потоков процесса
+inline WorkStealingPool& DefaultThreadPool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+// Группа задач пула: Run запускает задачу, Wait дожидается завершения всех задач группы,
+// выполняя тем временем задачи пула. Первое исключение из задач пробрасывается из Wait
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingPool& pool = DefaultThreadPool()) noexcept
+        : pool_(pool)
+    {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() {
+        WaitAll();
+    }
+
+    // Запускает fn в пуле
+    template <typename Fn>
+    void Run(Fn fn) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.Push([this, fn = std::move(fn)]() mutable {
+            try {
+                fn();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard(error_mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+            pending_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // Дожидается завершения всех запущенных задач
+    void Wait() {
+        WaitAll();
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+private:
+    void WaitAll() noexcept {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (!pool_.RunPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    WorkStealingPool& pool_;
+    std::atomic<size_t> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
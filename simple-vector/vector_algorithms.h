@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+
+#include "simd_kernels.h"
+
+// Алгоритмы над SimpleVector и SmallSimpleVector (элементы которых лежат в памяти подряд).
+// Для int32_t, uint8_t, float и double работают векторные ядра из simd_kernels.h,
+// для остальных типов - стандартные алгоритмы
+
+// Записывает value во все элементы вектора
+template <typename Vector>
+void Fill(Vector& vector, const typename Vector::value_type& value) {
+    using Type = typename Vector::value_type;
+    if constexpr (kHasSimdKernels<Type>) {
+        SimdFill(vector.begin(), vector.GetSize(), value);
+    } else {
+        std::fill(vector.begin(), vector.end(), value);
+    }
+}
+
+// Возвращает итератор на первый элемент, равный value, или end()
+template <typename Vector>
+auto Find(const Vector& vector, const typename Vector::value_type& value) {
+    using Type = typename Vector::value_type;
+    if constexpr (kHasSimdKernels<Type>) {
+        return vector.begin() + SimdFind(vector.begin(), vector.GetSize(), value);
+    } else {
+        return std::find(vector.begin(), vector.end(), value);
+    }
+}
+
+// Возвращает количество элементов, равных value
+template <typename Vector>
+size_t Count(const Vector& vector, const typename Vector::value_type& value) {
+    using Type = typename Vector::value_type;
+    if constexpr (kHasSimdKernels<Type>) {
+        return SimdCount(vector.begin(), vector.GetSize(), value);
+    } else {
+        return static_cast<size_t>(std::count(vector.begin(), vector.end(), value));
+    }
+}
+
+// Возвращает наименьший элемент. Вектор не должен быть пустым
+template <typename Vector>
+typename Vector::value_type MinValue(const Vector& vector) {
+    using Type = typename Vector::value_type;
+    assert(!vector.IsEmpty() && "Error: Vector is empty!");
+    if constexpr (kHasSimdKernels<Type>) {
+        return SimdMin(vector.begin(), vector.GetSize());
+    } else {
+        return *std::min_element(vector.begin(), vector.end());
+    }
+}
+
+// Возвращает наибольший элемент. Вектор не должен быть пустым
+template <typename Vector>
+typename Vector::value_type MaxValue(const Vector& vector) {
+    using Type = typename Vector::value_type;
+    assert(!vector.IsEmpty() && "Error: Vector is empty!");
+    if constexpr (kHasSimdKernels<Type>) {
+        return SimdMax(vector.begin(), vector.GetSize());
+    } else {
+        return *std::max_element(vector.begin(), vector.end());
+    }
+}
+
+// Возвращает сумму элементов. Целые из simd_kernels.h суммируются в 64 бита (см. SimdSumType)
+template <typename Vector>
+auto Sum(const Vector& vector) {
+    using Type = typename Vector::value_type;
+    if constexpr (kHasSimdKernels<Type>) {
+        return SimdSum(vector.begin(), vector.GetSize());
+    } else {
+        return std::accumulate(vector.begin(), vector.end(), Type{});
+    }
+}